@@ -178,6 +178,21 @@ if(NOT MSVC)
     CXXFLAGS ${AVX2_CXXFLAGS}
   )
 
+  # Check for AVX-512F intrinsics.
+  set(AVX512_CXXFLAGS -mavx512f)
+  check_cxx_source_compiles_with_flags("
+    #include <immintrin.h>
+
+    int main()
+    {
+      __m512i l = _mm512_set1_epi64(1);
+      __m512i r = _mm512_rorv_epi64(l, _mm512_ternarylogic_epi64(l, l, l, 0x96));
+      return _mm512_reduce_add_epi64(r) != 0;
+    }
+    " HAVE_AVX512
+    CXXFLAGS ${AVX512_CXXFLAGS}
+  )
+
   # Check for x86 SHA-NI intrinsics.
   set(X86_SHANI_CXXFLAGS -msse4 -msha)
   check_cxx_source_compiles_with_flags("
@@ -13,9 +13,100 @@
 #include <util/time.h>
 #include <util/translation.h>
 
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/** The network of addr and the address bytes that CSubNet::Match() compares, if subnets of its network can be banned. */
+std::optional<std::pair<Network, std::vector<unsigned char>>> GetMatchKey(const CNetAddr& addr)
+{
+    std::vector<unsigned char> bytes{addr.GetAddrBytes()};
+    // GetAddrBytes() returns IPv4 addresses in their IPv4-mapped IPv6 form.
+    if (addr.IsIPv4()) return std::pair{NET_IPV4, std::vector<unsigned char>(bytes.end() - ADDR_IPV4_SIZE, bytes.end())};
+    if (addr.IsIPv6()) return std::pair{NET_IPV6, std::move(bytes)};
+    if (addr.IsTor()) return std::pair{NET_ONION, std::move(bytes)};
+    if (addr.IsI2P()) return std::pair{NET_I2P, std::move(bytes)};
+    if (addr.IsCJDNS()) return std::pair{NET_CJDNS, std::move(bytes)};
+    return std::nullopt;
+}
+
+/** Truncate bytes to their first bits bits. */
+void TruncateToPrefix(std::vector<unsigned char>& bytes, size_t bits)
+{
+    bytes.resize((bits + 7) / 8);
+    if (bits % 8 != 0) bytes.back() &= uint8_t(0xFF << (8 - bits % 8));
+}
+
+} // namespace
+
+/**
+ * Banned subnets, grouped by network and prefix length. An address is looked
+ * up by truncating it to each prefix length in use on its network, so the cost
+ * of IsBanned(CNetAddr) depends on the number of distinct prefix lengths (at
+ * most the address length in bits) and not on the number of bans. Bans are
+ * added and removed one at a time, along with the changes to m_banned.
+ *
+ * Ban expiry is checked at lookup time; expired entries are dropped when
+ * SweepBanned() removes them from m_banned.
+ */
+struct BanMan::BanIndex {
+    //! Truncated base address of each banned subnet with a given prefix length, to its nBanUntil.
+    using BanUntilMap = std::unordered_map<std::vector<unsigned char>, int64_t, SaltedSipHasher>;
+    //! Per network, by prefix length, most specific first: single-host bans are the common case.
+    std::array<std::map<size_t, BanUntilMap, std::greater<>>, NET_MAX> networks;
+
+    //! The network of sub_net and its truncated base address, if sub_net can be indexed.
+    static std::optional<std::pair<Network, std::vector<unsigned char>>> GetKey(const CSubNet& sub_net)
+    {
+        if (!sub_net.IsValid()) return std::nullopt;
+        auto key{GetMatchKey(sub_net.GetBaseAddress())};
+        if (key) TruncateToPrefix(key->second, sub_net.GetPrefixLength());
+        return key;
+    }
+
+    void Add(const CSubNet& sub_net, int64_t ban_until)
+    {
+        auto key{GetKey(sub_net)};
+        if (!key) return;
+        networks[key->first][sub_net.GetPrefixLength()][std::move(key->second)] = ban_until;
+    }
+
+    void Remove(const CSubNet& sub_net)
+    {
+        auto key{GetKey(sub_net)};
+        if (!key) return;
+        auto& groups{networks[key->first]};
+        auto group{groups.find(sub_net.GetPrefixLength())};
+        if (group == groups.end()) return;
+        group->second.erase(key->second);
+        if (group->second.empty()) groups.erase(group);
+    }
+
+    bool Contains(const CNetAddr& net_addr, int64_t current_time) const
+    {
+        if (!net_addr.IsValid()) return false;
+        auto key{GetMatchKey(net_addr)};
+        if (!key) return false;
+        std::vector<unsigned char> prefix;
+        prefix.reserve(key->second.size());
+        for (const auto& [bits, ban_until] : networks[key->first]) {
+            prefix.assign(key->second.begin(), key->second.end());
+            TruncateToPrefix(prefix, bits);
+            auto it{ban_until.find(prefix)};
+            if (it != ban_until.end() && current_time < it->second) return true;
+        }
+        return false;
+    }
+};
 
 BanMan::BanMan(fs::path ban_file, CClientUIInterface* client_interface, int64_t default_ban_time)
-    : m_client_interface(client_interface), m_ban_db(std::move(ban_file)), m_default_ban_time(default_ban_time)
+    : m_index(std::make_unique<BanIndex>()), m_client_interface(client_interface), m_ban_db(std::move(ban_file)), m_default_ban_time(default_ban_time)
 {
     LoadBanlist();
     DumpBanlist();
@@ -43,6 +134,7 @@ void BanMan::LoadBanlist()
         m_banned = {};
         m_is_dirty = true;
     }
+    for (const auto& [sub_net, ban_entry] : m_banned) IndexBan(sub_net, ban_entry.nBanUntil);
 }
 
 void BanMan::DumpBanlist()
@@ -75,30 +167,30 @@ void BanMan::ClearBanned()
         LOCK(m_banned_mutex);
         m_banned.clear();
         m_is_dirty = true;
+        WITH_LOCK(m_index_mutex, *m_index = {});
     }
     DumpBanlist(); //store banlist to disk
     if (m_client_interface) m_client_interface->BannedListChanged();
 }
 
+BanMan::DiscouragedShard& BanMan::GetDiscouragedShard(std::span<const unsigned char> addr_bytes)
+{
+    return m_discouraged[m_discouraged_hasher(addr_bytes) % DISCOURAGED_SHARDS];
+}
+
 bool BanMan::IsDiscouraged(const CNetAddr& net_addr)
 {
-    LOCK(m_banned_mutex);
-    return m_discouraged.contains(net_addr.GetAddrBytes());
+    const std::vector<unsigned char> addr_bytes{net_addr.GetAddrBytes()};
+    DiscouragedShard& shard{GetDiscouragedShard(addr_bytes)};
+    LOCK(shard.mutex);
+    return shard.filter.contains(addr_bytes);
 }
 
 bool BanMan::IsBanned(const CNetAddr& net_addr)
 {
     auto current_time = GetTime();
-    LOCK(m_banned_mutex);
-    for (const auto& it : m_banned) {
-        CSubNet sub_net = it.first;
-        CBanEntry ban_entry = it.second;
-
-        if (current_time < ban_entry.nBanUntil && sub_net.Match(net_addr)) {
-            return true;
-        }
-    }
-    return false;
+    LOCK(m_index_mutex);
+    return m_index->Contains(net_addr, current_time);
 }
 
 bool BanMan::IsBanned(const CSubNet& sub_net)
@@ -123,8 +215,10 @@ void BanMan::Ban(const CNetAddr& net_addr, int64_t ban_time_offset, bool since_u
 
 void BanMan::Discourage(const CNetAddr& net_addr)
 {
-    LOCK(m_banned_mutex);
-    m_discouraged.insert(net_addr.GetAddrBytes());
+    const std::vector<unsigned char> addr_bytes{net_addr.GetAddrBytes()};
+    DiscouragedShard& shard{GetDiscouragedShard(addr_bytes)};
+    LOCK(shard.mutex);
+    shard.filter.insert(addr_bytes);
 }
 
 void BanMan::Ban(const CSubNet& sub_net, int64_t ban_time_offset, bool since_unix_epoch)
@@ -144,6 +238,7 @@ void BanMan::Ban(const CSubNet& sub_net, int64_t ban_time_offset, bool since_uni
         if (m_banned[sub_net].nBanUntil < ban_entry.nBanUntil) {
             m_banned[sub_net] = ban_entry;
             m_is_dirty = true;
+            IndexBan(sub_net, ban_entry.nBanUntil);
         } else
             return;
     }
@@ -165,6 +260,7 @@ bool BanMan::Unban(const CSubNet& sub_net)
         LOCK(m_banned_mutex);
         if (m_banned.erase(sub_net) == 0) return false;
         m_is_dirty = true;
+        UnindexBan(sub_net);
     }
     if (m_client_interface) m_client_interface->BannedListChanged();
     DumpBanlist(); //store banlist to disk immediately
@@ -191,6 +287,7 @@ void BanMan::SweepBanned()
         CBanEntry ban_entry = (*it).second;
         if (!sub_net.IsValid() || now > ban_entry.nBanUntil) {
             m_banned.erase(it++);
+            UnindexBan(sub_net);
             m_is_dirty = true;
             notify_ui = true;
             LogDebug(BCLog::NET, "Removed banned node address/subnet: %s\n", sub_net.ToString());
@@ -204,3 +301,17 @@ void BanMan::SweepBanned()
         m_client_interface->BannedListChanged();
     }
 }
+
+void BanMan::IndexBan(const CSubNet& sub_net, int64_t ban_until)
+{
+    AssertLockHeld(m_banned_mutex);
+    LOCK(m_index_mutex);
+    m_index->Add(sub_net, ban_until);
+}
+
+void BanMan::UnindexBan(const CSubNet& sub_net)
+{
+    AssertLockHeld(m_banned_mutex);
+    LOCK(m_index_mutex);
+    m_index->Remove(sub_net);
+}
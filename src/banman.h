@@ -10,10 +10,13 @@
 #include <net_types.h>
 #include <sync.h>
 #include <util/fs.h>
+#include <util/hasher.h>
 
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <memory>
+#include <span>
 
 // NOTE: When adjusting this, update rpcnet:setban's help ("24h")
 static constexpr unsigned int DEFAULT_MISBEHAVING_BANTIME = 60 * 60 * 24; // Default 24-hour ban
@@ -21,6 +24,9 @@ static constexpr unsigned int DEFAULT_MISBEHAVING_BANTIME = 60 * 60 * 24; // Def
 /// How often to dump banned addresses/subnets to disk.
 static constexpr std::chrono::minutes DUMP_BANS_INTERVAL{15};
 
+/// Number of independently locked bloom filters the discouraged addresses are spread over.
+static constexpr size_t DISCOURAGED_SHARDS{8};
+
 class CClientUIInterface;
 class CNetAddr;
 class CSubNet;
@@ -39,10 +45,11 @@ class CSubNet;
 // incoming connections from them, but they're preferred for eviction when
 // we receive new incoming connections. We never make outgoing connections to
 // them, and do not gossip their address to other peers. This is implemented as
-// a bloom filter. We can (probabilistically) test for membership, but can't
-// list all discouraged addresses or unmark them as discouraged. Discouragement
-// can prevent our limited connection slots being used up by incompatible
-// or broken peers.
+// a few bloom filters, each holding the addresses of one salted hash range so
+// that concurrent lookups rarely contend. We can (probabilistically) test for
+// membership, but can't list all discouraged addresses or unmark them as
+// discouraged. Discouragement can prevent our limited connection slots being
+// used up by incompatible or broken peers.
 //
 // Neither banning nor discouragement are protections against denial-of-service
 // attacks, since if an attacker has a way to waste our resources and we
@@ -65,37 +72,54 @@ class BanMan
 public:
     ~BanMan();
     BanMan(fs::path ban_file, CClientUIInterface* client_interface, int64_t default_ban_time);
-    void Ban(const CNetAddr& net_addr, int64_t ban_time_offset = 0, bool since_unix_epoch = false) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
-    void Ban(const CSubNet& sub_net, int64_t ban_time_offset = 0, bool since_unix_epoch = false) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
-    void Discourage(const CNetAddr& net_addr) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
-    void ClearBanned() EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
+    void Ban(const CNetAddr& net_addr, int64_t ban_time_offset = 0, bool since_unix_epoch = false) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex, !m_index_mutex);
+    void Ban(const CSubNet& sub_net, int64_t ban_time_offset = 0, bool since_unix_epoch = false) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex, !m_index_mutex);
+    void Discourage(const CNetAddr& net_addr);
+    void ClearBanned() EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex, !m_index_mutex);
 
-    //! Return whether net_addr is banned
-    bool IsBanned(const CNetAddr& net_addr) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
+    //! Return whether net_addr is banned. Does not take m_banned_mutex.
+    bool IsBanned(const CNetAddr& net_addr) EXCLUSIVE_LOCKS_REQUIRED(!m_index_mutex);
 
     //! Return whether sub_net is exactly banned
     bool IsBanned(const CSubNet& sub_net) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
 
     //! Return whether net_addr is discouraged.
-    bool IsDiscouraged(const CNetAddr& net_addr) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
+    bool IsDiscouraged(const CNetAddr& net_addr);
 
-    bool Unban(const CNetAddr& net_addr) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
-    bool Unban(const CSubNet& sub_net) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
-    void GetBanned(banmap_t& banmap) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
-    void DumpBanlist() EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
+    bool Unban(const CNetAddr& net_addr) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex, !m_index_mutex);
+    bool Unban(const CSubNet& sub_net) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex, !m_index_mutex);
+    void GetBanned(banmap_t& banmap) EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex, !m_index_mutex);
+    void DumpBanlist() EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex, !m_index_mutex);
 
 private:
-    void LoadBanlist() EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex);
+    void LoadBanlist() EXCLUSIVE_LOCKS_REQUIRED(!m_banned_mutex, !m_index_mutex);
     //!clean unused entries (if bantime has expired)
-    void SweepBanned() EXCLUSIVE_LOCKS_REQUIRED(m_banned_mutex);
+    void SweepBanned() EXCLUSIVE_LOCKS_REQUIRED(m_banned_mutex, !m_index_mutex);
+    //! Add or update sub_net in m_index. Must be called after every ban added to m_banned.
+    void IndexBan(const CSubNet& sub_net, int64_t ban_until) EXCLUSIVE_LOCKS_REQUIRED(m_banned_mutex, !m_index_mutex);
+    //! Remove sub_net from m_index. Must be called after every ban removed from m_banned.
+    void UnindexBan(const CSubNet& sub_net) EXCLUSIVE_LOCKS_REQUIRED(m_banned_mutex, !m_index_mutex);
+
+    /** Banned subnets by network and prefix length, defined in banman.cpp. */
+    struct BanIndex;
+
+    struct DiscouragedShard {
+        Mutex mutex;
+        CRollingBloomFilter filter GUARDED_BY(mutex){50000 / DISCOURAGED_SHARDS, 0.000001};
+    };
+    DiscouragedShard& GetDiscouragedShard(std::span<const unsigned char> addr_bytes);
 
     Mutex m_banned_mutex;
     banmap_t m_banned GUARDED_BY(m_banned_mutex);
     bool m_is_dirty GUARDED_BY(m_banned_mutex){false};
+    //! Kept in sync with m_banned under its own mutex, so that IsBanned(CNetAddr) does not take m_banned_mutex.
+    Mutex m_index_mutex;
+    const std::unique_ptr<BanIndex> m_index PT_GUARDED_BY(m_index_mutex);
     CClientUIInterface* m_client_interface = nullptr;
     CBanDB m_ban_db;
     const int64_t m_default_ban_time;
-    CRollingBloomFilter m_discouraged GUARDED_BY(m_banned_mutex) {50000, 0.000001};
+    const SaltedSipHasher m_discouraged_hasher;
+    std::array<DiscouragedShard, DISCOURAGED_SHARDS> m_discouraged;
 };
 
 #endif // BITCOIN_BANMAN_H
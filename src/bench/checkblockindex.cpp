@@ -18,5 +18,15 @@ static void CheckBlockIndex(benchmark::Bench& bench)
     });
 }
 
+static void CheckChangedBlockIndex(benchmark::Bench& bench)
+{
+    auto testing_setup{MakeNoLogFileContext<TestChain100Setup>()};
+    // Mine some more blocks
+    testing_setup->mineBlocks(1000);
+    bench.run([&] {
+        testing_setup->m_node.chainman->CheckChangedBlockIndex();
+    });
+}
 
 BENCHMARK(CheckBlockIndex, benchmark::PriorityLevel::HIGH);
+BENCHMARK(CheckChangedBlockIndex, benchmark::PriorityLevel::HIGH);
@@ -4,6 +4,7 @@
 
 
 #include <bench/bench.h>
+#include <crypto/hmac_sha512.h>
 #include <crypto/muhash.h>
 #include <crypto/ripemd160.h>
 #include <crypto/sha1.h>
@@ -190,6 +191,25 @@ static void SHA512(benchmark::Bench& bench)
     });
 }
 
+static void HMACSHA512_37b_1024(benchmark::Bench& bench, sha512_implementation::UseImplementation use_implementation)
+{
+    // 1024 BIP32 child derivation messages under one chain code.
+    bench.name(strprintf("HMACSHA512_37b_1024 using the '%s' SHA512 implementation", SHA512AutoDetect(use_implementation)));
+    const unsigned char key[32]{};
+    std::vector<uint8_t> in(37 * 1024, 0);
+    std::vector<std::span<const unsigned char>> inputs;
+    for (size_t i = 0; i < 1024; ++i) inputs.emplace_back(in.data() + i * 37, 37);
+    std::vector<uint8_t> out(CHMAC_SHA512::OUTPUT_SIZE * 1024);
+    bench.batch(inputs.size()).unit("hmac").run([&] {
+        CHMAC_SHA512{key, sizeof(key)}.FinalizeMulti(inputs, out.data());
+    });
+    SHA512AutoDetect();
+}
+
+static void HMACSHA512_37b_1024_STANDARD(benchmark::Bench& bench) { HMACSHA512_37b_1024(bench, sha512_implementation::STANDARD); }
+static void HMACSHA512_37b_1024_AVX2(benchmark::Bench& bench) { HMACSHA512_37b_1024(bench, sha512_implementation::USE_AVX2); }
+static void HMACSHA512_37b_1024_AVX512(benchmark::Bench& bench) { HMACSHA512_37b_1024(bench, sha512_implementation::USE_ALL); }
+
 static void SipHash_32b(benchmark::Bench& bench)
 {
     FastRandomContext rng{/*fDeterministic=*/true};
@@ -205,6 +225,21 @@ static void SipHash_32b(benchmark::Bench& bench)
     });
 }
 
+static void SipHash_32b_Multi(benchmark::Bench& bench)
+{
+    FastRandomContext rng{/*fDeterministic=*/true};
+    auto k0{rng.rand64()}, k1{rng.rand64()};
+    std::vector<uint256> vals(1024);
+    for (auto& val : vals) val = rng.rand256();
+    std::vector<const uint256*> ptrs;
+    for (const auto& val : vals) ptrs.push_back(&val);
+    std::vector<uint64_t> out(vals.size());
+    bench.batch(vals.size()).unit("hash").run([&] {
+        SipHashUint256Multi(k0, k1, ptrs, out.data());
+        ++k0;
+    });
+}
+
 static void MuHash(benchmark::Bench& bench)
 {
     MuHash3072 acc;
@@ -276,11 +311,16 @@ BENCHMARK(SHA256_32b_SSE4, benchmark::PriorityLevel::HIGH);
 BENCHMARK(SHA256_32b_AVX2, benchmark::PriorityLevel::HIGH);
 BENCHMARK(SHA256_32b_SHANI, benchmark::PriorityLevel::HIGH);
 BENCHMARK(SipHash_32b, benchmark::PriorityLevel::HIGH);
+BENCHMARK(SipHash_32b_Multi, benchmark::PriorityLevel::HIGH);
 BENCHMARK(SHA256D64_1024_STANDARD, benchmark::PriorityLevel::HIGH);
 BENCHMARK(SHA256D64_1024_SSE4, benchmark::PriorityLevel::HIGH);
 BENCHMARK(SHA256D64_1024_AVX2, benchmark::PriorityLevel::HIGH);
 BENCHMARK(SHA256D64_1024_SHANI, benchmark::PriorityLevel::HIGH);
 
+BENCHMARK(HMACSHA512_37b_1024_STANDARD, benchmark::PriorityLevel::HIGH);
+BENCHMARK(HMACSHA512_37b_1024_AVX2, benchmark::PriorityLevel::HIGH);
+BENCHMARK(HMACSHA512_37b_1024_AVX512, benchmark::PriorityLevel::HIGH);
+
 BENCHMARK(MuHash, benchmark::PriorityLevel::HIGH);
 BENCHMARK(MuHashMul, benchmark::PriorityLevel::HIGH);
 BENCHMARK(MuHashDiv, benchmark::PriorityLevel::HIGH);
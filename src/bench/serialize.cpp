@@ -0,0 +1,67 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <primitives/block.h>
+#include <primitives/transaction.h>
+#include <random.h>
+#include <serialize.h>
+#include <streams.h>
+
+#include <cassert>
+#include <vector>
+
+static std::vector<COutPoint> CreateOutPoints()
+{
+    FastRandomContext rng{/*fDeterministic=*/true};
+    std::vector<COutPoint> outpoints;
+    for (int i = 0; i < 1000; ++i) {
+        outpoints.emplace_back(Txid::FromUint256(rng.rand256()), rng.randbits(8));
+    }
+    return outpoints;
+}
+
+static void SerializeOutPoints(benchmark::Bench& bench)
+{
+    const auto outpoints{CreateOutPoints()};
+    DataStream stream{};
+    stream.reserve(GetSerializeSize(outpoints));
+    bench.batch(outpoints.size()).unit("outpoint").run([&] {
+        stream.clear();
+        stream << outpoints;
+    });
+}
+
+static void DeserializeOutPoints(benchmark::Bench& bench)
+{
+    DataStream data{};
+    data << CreateOutPoints();
+    std::vector<COutPoint> outpoints;
+    bench.batch(1000).unit("outpoint").run([&] {
+        DataStream stream{data};
+        stream >> outpoints;
+        assert(outpoints.size() == 1000);
+    });
+}
+
+static void DeserializeBlockHeaders(benchmark::Bench& bench)
+{
+    FastRandomContext rng{/*fDeterministic=*/true};
+    std::vector<CBlockHeader> headers(2000);
+    for (auto& header : headers) {
+        header.hashPrevBlock = rng.rand256();
+        header.hashMerkleRoot = rng.rand256();
+        header.nTime = rng.rand32();
+    }
+    DataStream data{};
+    data << headers;
+    bench.batch(headers.size()).unit("header").run([&] {
+        DataStream stream{data};
+        stream >> headers;
+    });
+}
+
+BENCHMARK(SerializeOutPoints, benchmark::PriorityLevel::HIGH);
+BENCHMARK(DeserializeOutPoints, benchmark::PriorityLevel::HIGH);
+BENCHMARK(DeserializeBlockHeaders, benchmark::PriorityLevel::HIGH);
@@ -17,28 +17,344 @@
 #include <kernel/context.h>
 #include <kernel/warning.h>
 
+#include <chain.h>
+#include <consensus/consensus.h>
 #include <consensus/validation.h>
 #include <core_io.h>
+#include <dbwrapper.h>
+#include <flatfile.h>
 #include <kernel/caches.h>
 #include <logging.h>
 #include <node/blockstorage.h>
 #include <node/chainstate.h>
 #include <random.h>
 #include <script/sigcache.h>
+#include <streams.h>
+#include <util/byte_units.h>
 #include <util/chaintype.h>
 #include <util/fs.h>
+#include <util/obfuscation.h>
+#include <util/perfcounters.h>
 #include <util/signalinterrupt.h>
+#include <util/strencodings.h>
+#include <util/string.h>
 #include <util/task_runner.h>
+#include <util/time.h>
 #include <util/translation.h>
 #include <validation.h>
 #include <validationinterface.h>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstdint>
+#include <cstdio>
+#include <exception>
 #include <functional>
 #include <iosfwd>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
+
+using util::ToString;
+
+namespace {
+
+struct ReplayOptions {
+    //! Datadir whose block index and blk*.dat files hold the chain to replay.
+    fs::path source_datadir;
+    int start_height{1};
+    int stop_height{std::numeric_limits<int>::max()};
+    //! Flush the chainstate every this many blocks; 0 flushes only when the cache is full.
+    int flush_interval{0};
+    bool flush_at_end{true};
+};
+
+struct ReplayStats {
+    int blocks{0};
+    int64_t transactions{0};
+    SteadyClock::duration read{};
+    SteadyClock::duration deserialize{};
+    SteadyClock::duration check_block{};
+    SteadyClock::duration process_block{};
+    SteadyClock::duration final_flush{};
+};
+
+std::optional<std::string> GetOption(std::vector<std::string>& args, std::string_view name)
+{
+    for (auto it{args.begin()}; it != args.end(); ++it) {
+        if (it->starts_with(name) && (it->size() == name.size() || (*it)[name.size()] == '=')) {
+            std::string value{it->size() > name.size() ? it->substr(name.size() + 1) : ""};
+            args.erase(it);
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+//! Total time recorded by the performance counters for one validation phase.
+int64_t PerfTotalMicros(const std::vector<perf::ThreadStats>& stats, std::string_view name)
+{
+    std::chrono::nanoseconds total{0};
+    for (const auto& thread : stats) {
+        for (const auto& timer : thread.timers) {
+            if (timer.group == "validation" && timer.name == name) total += timer.histogram.total;
+        }
+    }
+    return Ticks<std::chrono::microseconds>(total);
+}
+
+/**
+ * Read the block index of the source datadir and return the hash and position
+ * of each block on its most-work fully validated chain, by height. Returns an
+ * empty vector on failure.
+ */
+std::vector<std::pair<uint256, FlatFilePos>> ReadSourceChain(const fs::path& source_datadir, const Consensus::Params& consensus)
+{
+    const fs::path index_dir{source_datadir / "blocks" / "index"};
+    if (!fs::exists(index_dir)) {
+        std::cerr << "No block index found in " << fs::PathToString(index_dir) << std::endl;
+        return {};
+    }
+
+    LOCK(cs_main);
+    node::BlockMap block_index;
+    try {
+        kernel::BlockTreeDB block_tree_db{DBParams{.path = index_dir, .cache_bytes = 8_MiB}};
+        util::SignalInterrupt interrupt;
+        const bool loaded{block_tree_db.LoadBlockIndexGuts(
+            consensus,
+            [&](const uint256& hash) -> CBlockIndex* {
+                if (hash.IsNull()) return nullptr;
+                const auto [it, inserted]{block_index.try_emplace(hash)};
+                if (inserted) it->second.phashBlock = &it->first;
+                return &it->second;
+            },
+            interrupt)};
+        if (!loaded) {
+            std::cerr << "Failed to load the block index of " << fs::PathToString(source_datadir) << std::endl;
+            return {};
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to open the block index of " << fs::PathToString(source_datadir) << ": " << e.what() << std::endl;
+        return {};
+    }
+
+    std::vector<CBlockIndex*> by_height;
+    by_height.reserve(block_index.size());
+    for (auto& [_, entry] : block_index) by_height.push_back(&entry);
+    std::sort(by_height.begin(), by_height.end(), [](const CBlockIndex* a, const CBlockIndex* b) { return a->nHeight < b->nHeight; });
+    const CBlockIndex* best{nullptr};
+    for (CBlockIndex* pindex : by_height) {
+        pindex->nChainWork = (pindex->pprev ? pindex->pprev->nChainWork : arith_uint256{}) + GetBlockProof(*pindex);
+        if (pindex->IsValid(BLOCK_VALID_SCRIPTS) && (!best || pindex->nChainWork > best->nChainWork)) best = pindex;
+    }
+    if (!best) {
+        std::cerr << "No validated blocks in the block index of " << fs::PathToString(source_datadir) << std::endl;
+        return {};
+    }
+
+    std::vector<std::pair<uint256, FlatFilePos>> chain(best->nHeight + 1);
+    for (const CBlockIndex* pindex{best}; pindex; pindex = pindex->pprev) {
+        if (!(pindex->nStatus & BLOCK_HAVE_DATA)) {
+            std::cerr << "Block at height " << pindex->nHeight << " is missing from " << fs::PathToString(source_datadir) << " (pruned?)" << std::endl;
+            return {};
+        }
+        chain[pindex->nHeight] = {pindex->GetBlockHash(), pindex->GetBlockPos()};
+    }
+    return chain;
+}
+
+/**
+ * Feed the blocks of the source datadir's best chain to chainman in chain
+ * order, and print the time spent in each validation phase as a single JSON
+ * object.
+ */
+bool Replay(ChainstateManager& chainman, const ReplayOptions& opts, const std::string& settings_json)
+{
+    const fs::path blocks_dir{opts.source_datadir / "blocks"};
+    Obfuscation obfuscation;
+    if (const fs::path xor_path{blocks_dir / "xor.dat"}; fs::exists(xor_path)) {
+        std::array<std::byte, Obfuscation::KEY_SIZE> key{};
+        AutoFile xor_file{fsbridge::fopen(xor_path, "rb")};
+        xor_file >> key;
+        obfuscation = Obfuscation{key};
+    }
+
+    struct RawBlock {
+        std::vector<std::byte> data;
+        SteadyClock::duration read;
+    };
+    ReplayStats stats;
+    uint256 tip_hash;
+    int tip_height;
+    {
+        LOCK(cs_main);
+        tip_hash = chainman.ActiveTip()->GetBlockHash();
+        tip_height = chainman.ActiveHeight();
+    }
+    const auto& message_start{chainman.GetParams().MessageStart()};
+
+    // Blocks are not stored in chain order, so they are located through the
+    // source's block index rather than by scanning the block files.
+    const auto source_chain{ReadSourceChain(opts.source_datadir, chainman.GetConsensus())};
+    if (source_chain.empty()) return false;
+    if (size_t(tip_height) >= source_chain.size() || source_chain[tip_height].first != tip_hash) {
+        std::cerr << "The chainstate tip at height " << tip_height << " is not on the best chain of " << fs::PathToString(opts.source_datadir) << std::endl;
+        return false;
+    }
+    const int end_height{std::min<int>(opts.stop_height, source_chain.size() - 1)};
+    const auto time_start{SteadyClock::now()};
+
+    const auto connect{[&](RawBlock&& raw) -> bool {
+        const int height{tip_height + 1};
+        const bool measured{height >= opts.start_height};
+        if (height == opts.start_height) perf::Snapshot(/*reset=*/true);
+
+        auto time_0{SteadyClock::now()};
+        auto block{std::make_shared<CBlock>()};
+        try {
+            DataStream stream{raw.data};
+            stream >> TX_WITH_WITNESS(*block);
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to deserialize block at height " << height << ": " << e.what() << std::endl;
+            return false;
+        }
+        const auto time_1{SteadyClock::now()};
+        BlockValidationState state;
+        if (!CheckBlock(*block, state, chainman.GetConsensus())) {
+            std::cerr << "CheckBlock failed at height " << height << ": " << state.ToString() << std::endl;
+            return false;
+        }
+        const auto time_2{SteadyClock::now()};
+        if (!chainman.ProcessNewBlock(block, /*force_processing=*/true, /*min_pow_checked=*/true, /*new_block=*/nullptr) ||
+            WITH_LOCK(cs_main, return chainman.ActiveTip()->GetBlockHash()) != block->GetHash()) {
+            std::cerr << "Failed to connect block at height " << height << std::endl;
+            return false;
+        }
+        const auto time_3{SteadyClock::now()};
+        if (opts.flush_interval > 0 && height % opts.flush_interval == 0) {
+            LOCK(cs_main);
+            chainman.ActiveChainstate().ForceFlushStateToDisk();
+        }
+
+        tip_hash = block->GetHash();
+        tip_height = height;
+        if (measured) {
+            ++stats.blocks;
+            stats.transactions += block->vtx.size();
+            stats.read += raw.read;
+            stats.deserialize += time_1 - time_0;
+            stats.check_block += time_2 - time_1;
+            stats.process_block += time_3 - time_2;
+        }
+        return true;
+    }};
+
+    bool ok{true};
+    std::optional<AutoFile> file;
+    int file_num{-1};
+    while (ok && tip_height < end_height) {
+        const auto& [hash, pos]{source_chain[tip_height + 1]};
+        const fs::path path{blocks_dir / fs::PathFromString(strprintf("blk%05u.dat", pos.nFile))};
+        RawBlock raw;
+        const auto time_read{SteadyClock::now()};
+        try {
+            if (pos.nFile != file_num) {
+                file.emplace(fsbridge::fopen(path, "rb"), obfuscation);
+                file_num = pos.nFile;
+                if (file->IsNull()) throw std::ios_base::failure("Failed to open file");
+            }
+            // The block is preceded by the network magic and its size.
+            if (pos.nPos < 8) throw std::ios_base::failure("Invalid position");
+            file->seek(pos.nPos - 8, SEEK_SET);
+            MessageStartChars magic;
+            uint32_t size;
+            *file >> magic >> size;
+            if (magic != message_start) throw std::ios_base::failure("Invalid magic");
+            if (size < 80 || size > MAX_BLOCK_SERIALIZED_SIZE) throw std::ios_base::failure(strprintf("Invalid block size %u", size));
+            raw.data.resize(size);
+            file->read(raw.data);
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to read block at height " << tip_height + 1 << " from " << fs::PathToString(path) << ": " << e.what() << std::endl;
+            file.reset();
+            file_num = -1;
+            ok = false;
+            break;
+        }
+        raw.read = SteadyClock::now() - time_read;
+
+        CBlockHeader header;
+        try {
+            SpanReader{raw.data} >> header;
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to deserialize block header at height " << tip_height + 1 << ": " << e.what() << std::endl;
+            ok = false;
+            break;
+        }
+        if (header.GetHash() != hash) {
+            std::cerr << "Block at height " << tip_height + 1 << " in " << fs::PathToString(path) << " does not match the block index" << std::endl;
+            ok = false;
+            break;
+        }
+        ok = connect(std::move(raw));
+    }
+
+    if (opts.flush_at_end) {
+        const auto time_flush{SteadyClock::now()};
+        LOCK(cs_main);
+        chainman.ActiveChainstate().ForceFlushStateToDisk();
+        stats.final_flush = SteadyClock::now() - time_flush;
+    }
+    const auto elapsed{SteadyClock::now() - time_start};
+
+    const auto perf_stats{perf::Snapshot(/*reset=*/false)};
+    const int64_t input_fetch{PerfTotalMicros(perf_stats, "ConnectBlock.connect")};
+    std::cout << "{" << settings_json
+              << strprintf(R"(,"ok":%s,"tip_height":%d,"blocks":%d,"transactions":%d,"elapsed_us":%d,)",
+                           ok ? "true" : "false", tip_height, stats.blocks, stats.transactions, Ticks<std::chrono::microseconds>(elapsed))
+              << strprintf(R"("phases_us":{"read":%d,"deserialize":%d,"check_block":%d,"process_block":%d,)",
+                           Ticks<std::chrono::microseconds>(stats.read), Ticks<std::chrono::microseconds>(stats.deserialize),
+                           Ticks<std::chrono::microseconds>(stats.check_block), Ticks<std::chrono::microseconds>(stats.process_block))
+              << strprintf(R"("input_fetch":%d,"script_checks":%d,"undo_write":%d,"utxo_flush":%d,"final_flush":%d}})",
+                           input_fetch, PerfTotalMicros(perf_stats, "ConnectBlock.verify") - input_fetch,
+                           PerfTotalMicros(perf_stats, "ConnectBlock.undo"), PerfTotalMicros(perf_stats, "FlushStateToDisk"),
+                           Ticks<std::chrono::microseconds>(stats.final_flush))
+              << std::endl;
+    return ok;
+}
+
+void PrintUsage(const char* name)
+{
+    std::cerr
+        << "Usage: " << name << " [options] DATADIR" << std::endl
+        << "Display DATADIR information, and process hex-encoded blocks on standard input." << std::endl
+        << std::endl
+        << "With -replay=<source datadir>, instead connect the blocks of the source datadir's" << std::endl
+        << "best chain, as recorded in its block index, to a fresh chainstate in DATADIR and" << std::endl
+        << "print the time spent in each validation phase as JSON. Script checks done by the" << std::endl
+        << "validation thread itself (-par=0) are counted as input_fetch." << std::endl
+        << std::endl
+        << "Options:" << std::endl
+        << "  -chain=<chain>        main, test, testnet4, signet or regtest (default: main)" << std::endl
+        << "  -dbcache=<MiB>        Database and UTXO cache size (default: " << (DEFAULT_KERNEL_CACHE >> 20) << ")" << std::endl
+        << "  -par=<n>              Script verification threads besides the validation thread (default: 0)" << std::endl
+        << "  -replay=<datadir>     Replay the blocks of another datadir" << std::endl
+        << "  -startheight=<n>      Only measure blocks from this height on (default: 1)" << std::endl
+        << "  -stopheight=<n>       Stop replaying after this height (default: all blocks)" << std::endl
+        << "  -flush=<policy>       end: flush the chainstate once at the end (default)," << std::endl
+        << "                        none: only flush when the cache is full," << std::endl
+        << "                        <n>: also flush every n blocks" << std::endl
+        << "  -assumevalid          Skip script checks below the chain's assumed valid block" << std::endl
+        << std::endl
+        << "IMPORTANT: THIS EXECUTABLE IS EXPERIMENTAL, FOR TESTING ONLY, AND EXPECTED TO" << std::endl
+        << "           BREAK IN FUTURE VERSIONS. DO NOT USE ON YOUR ACTUAL DATADIR." << std::endl;
+}
+
+} // namespace
 
 int main(int argc, char* argv[])
 {
@@ -49,17 +365,30 @@ int main(int argc, char* argv[])
     LogInstance().DisableLogging();
 
     // SETUP: Argument parsing and handling
-    if (argc != 2) {
-        std::cerr
-            << "Usage: " << argv[0] << " DATADIR" << std::endl
-            << "Display DATADIR information, and process hex-encoded blocks on standard input." << std::endl
-            << std::endl
-            << "IMPORTANT: THIS EXECUTABLE IS EXPERIMENTAL, FOR TESTING ONLY, AND EXPECTED TO" << std::endl
-            << "           BREAK IN FUTURE VERSIONS. DO NOT USE ON YOUR ACTUAL DATADIR." << std::endl;
+    std::vector<std::string> args(argv + 1, argv + argc);
+    const std::string chain{GetOption(args, "-chain").value_or("main")};
+    const auto dbcache_mib{ToIntegral<uint32_t>(GetOption(args, "-dbcache").value_or(ToString(DEFAULT_KERNEL_CACHE >> 20)))};
+    const auto par{ToIntegral<int>(GetOption(args, "-par").value_or("0"))};
+    const std::optional<std::string> replay_source{GetOption(args, "-replay")};
+    const auto start_height{ToIntegral<int>(GetOption(args, "-startheight").value_or("1"))};
+    const auto stop_height{ToIntegral<int>(GetOption(args, "-stopheight").value_or(ToString(std::numeric_limits<int>::max())))};
+    const std::string flush{GetOption(args, "-flush").value_or("end")};
+    const auto flush_interval{flush == "end" || flush == "none" ? std::optional<int>{0} : ToIntegral<int>(flush)};
+    const bool assumevalid{GetOption(args, "-assumevalid").has_value()};
+    std::unique_ptr<const CChainParams> chainparams;
+    if (chain == "main") chainparams = CChainParams::Main();
+    if (chain == "test") chainparams = CChainParams::TestNet();
+    if (chain == "testnet4") chainparams = CChainParams::TestNet4();
+    if (chain == "signet") chainparams = CChainParams::SigNet({});
+    if (chain == "regtest") chainparams = CChainParams::RegTest({});
+    if (args.size() != 1 || args[0].starts_with('-') || !chainparams || !dbcache_mib || !par || *par < 0 ||
+        !start_height || !stop_height || !flush_interval || *flush_interval < 0) {
+        PrintUsage(argv[0]);
         return 1;
     }
-    fs::path abs_datadir{fs::absolute(argv[1])};
+    fs::path abs_datadir{fs::absolute(fs::PathFromString(args[0]))};
     fs::create_directories(abs_datadir);
+    int exit_status{0};
 
 
     // SETUP: Context
@@ -74,18 +403,23 @@ int main(int argc, char* argv[])
     class KernelNotifications : public kernel::Notifications
     {
     public:
+        //! Keep stdout machine-readable while replaying.
+        const bool m_quiet;
+
+        explicit KernelNotifications(bool quiet) : m_quiet{quiet} {}
+
         kernel::InterruptResult blockTip(SynchronizationState, CBlockIndex&, double) override
         {
-            std::cout << "Block tip changed" << std::endl;
+            if (!m_quiet) std::cout << "Block tip changed" << std::endl;
             return {};
         }
         void headerTip(SynchronizationState, int64_t height, int64_t timestamp, bool presync) override
         {
-            std::cout << "Header tip changed: " << height << ", " << timestamp << ", " << presync << std::endl;
+            if (!m_quiet) std::cout << "Header tip changed: " << height << ", " << timestamp << ", " << presync << std::endl;
         }
         void progress(const bilingual_str& title, int progress_percent, bool resume_possible) override
         {
-            std::cout << "Progress: " << title.original << ", " << progress_percent << ", " << resume_possible << std::endl;
+            if (!m_quiet) std::cout << "Progress: " << title.original << ", " << progress_percent << ", " << resume_possible << std::endl;
         }
         void warningSet(kernel::Warning id, const bilingual_str& message) override
         {
@@ -104,18 +438,19 @@ int main(int argc, char* argv[])
             std::cerr << "Error: " << message.original << std::endl;
         }
     };
-    auto notifications = std::make_unique<KernelNotifications>();
+    auto notifications = std::make_unique<KernelNotifications>(/*quiet=*/replay_source.has_value());
 
-    kernel::CacheSizes cache_sizes{DEFAULT_KERNEL_CACHE};
+    kernel::CacheSizes cache_sizes(static_cast<size_t>(*dbcache_mib) << 20);
 
     // SETUP: Chainstate
-    auto chainparams = CChainParams::Main();
-    const ChainstateManager::Options chainman_opts{
+    ChainstateManager::Options chainman_opts{
         .chainparams = *chainparams,
         .datadir = abs_datadir,
         .notifications = *notifications,
         .signals = &validation_signals,
     };
+    chainman_opts.worker_threads_num = *par;
+    if (!assumevalid) chainman_opts.assumed_valid_block = uint256{};
     const node::BlockManager::Options blockman_opts{
         .chainparams = chainman_opts.chainparams,
         .blocks_dir = abs_datadir / "blocks",
@@ -149,6 +484,21 @@ int main(int argc, char* argv[])
         }
     }
 
+    if (replay_source) {
+        perf::SetEnabled(true);
+        const ReplayOptions replay_opts{
+            .source_datadir = fs::absolute(fs::PathFromString(*replay_source)),
+            .start_height = *start_height,
+            .stop_height = *stop_height,
+            .flush_interval = *flush_interval,
+            .flush_at_end = flush != "none",
+        };
+        const std::string settings_json{strprintf(R"("chain":"%s","dbcache_mib":%u,"par":%d,"flush":"%s","assumevalid":%s,"start_height":%d)",
+                                                  chain, *dbcache_mib, *par, flush, assumevalid ? "true" : "false", *start_height)};
+        if (!Replay(chainman, replay_opts, settings_json)) exit_status = 1;
+        goto epilogue;
+    }
+
     // Main program logic starts here
     std::cout
         << "Hello! I'm going to print out some information about your datadir." << std::endl
@@ -267,4 +617,5 @@ epilogue:
             }
         }
     }
+    return exit_status;
 }
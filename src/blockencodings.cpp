@@ -15,6 +15,7 @@
 #include <txmempool.h>
 #include <validation.h>
 
+#include <algorithm>
 #include <unordered_map>
 
 CBlockHeaderAndShortTxIDs::CBlockHeaderAndShortTxIDs(const CBlock& block, const uint64_t nonce) :
@@ -23,10 +24,12 @@ CBlockHeaderAndShortTxIDs::CBlockHeaderAndShortTxIDs(const CBlock& block, const
     FillShortTxIDSelector();
     //TODO: Use our mempool prior to block acceptance to predictively fill more than just the coinbase
     prefilledtxn[0] = {0, block.vtx[0]};
+    std::vector<const uint256*> wtxids;
+    wtxids.reserve(block.vtx.size() - 1);
     for (size_t i = 1; i < block.vtx.size(); i++) {
-        const CTransaction& tx = *block.vtx[i];
-        shorttxids[i - 1] = GetShortID(tx.GetWitnessHash());
+        wtxids.push_back(&block.vtx[i]->GetWitnessHash().ToUint256());
     }
+    GetShortIDs(wtxids, shorttxids.data());
 }
 
 void CBlockHeaderAndShortTxIDs::FillShortTxIDSelector() const {
@@ -45,6 +48,11 @@ uint64_t CBlockHeaderAndShortTxIDs::GetShortID(const Wtxid& wtxid) const {
     return SipHashUint256(shorttxidk0, shorttxidk1, wtxid.ToUint256()) & 0xffffffffffffL;
 }
 
+void CBlockHeaderAndShortTxIDs::GetShortIDs(std::span<const uint256* const> wtxids, uint64_t* out) const {
+    SipHashUint256Multi(shorttxidk0, shorttxidk1, wtxids, out);
+    for (size_t i = 0; i < wtxids.size(); ++i) out[i] &= 0xffffffffffffL;
+}
+
 /* Reconstructing a compact block is in the hot-path for block relay,
  * so we want to do it as quickly as possible. Because this often
  * involves iterating over the entire mempool, we put all the data we
@@ -114,29 +122,44 @@ ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& c
     std::vector<bool> have_txn(txn_available.size());
     {
     LOCK(pool->cs);
-    for (const auto& [wtxid, txit] : pool->txns_randomized) {
-        uint64_t shortid = cmpctblock.GetShortID(wtxid);
-        std::unordered_map<uint64_t, uint16_t>::iterator idit = shorttxids.find(shortid);
-        if (idit != shorttxids.end()) {
-            if (!have_txn[idit->second]) {
-                txn_available[idit->second] = txit->GetSharedTx();
-                have_txn[idit->second]  = true;
-                mempool_count++;
-            } else {
-                // If we find two mempool txn that match the short id, just request it.
-                // This should be rare enough that the extra bandwidth doesn't matter,
-                // but eating a round-trip due to FillBlock failure would be annoying
-                if (txn_available[idit->second]) {
-                    txn_available[idit->second].reset();
-                    mempool_count--;
+    // Short IDs are computed a batch at a time, so several can be hashed in parallel.
+    static constexpr size_t SHORTID_BATCH_SIZE{64};
+    std::vector<const uint256*> batch_wtxids;
+    batch_wtxids.reserve(SHORTID_BATCH_SIZE);
+    uint64_t batch_shortids[SHORTID_BATCH_SIZE];
+    bool done{false};
+    for (size_t start = 0; start < pool->txns_randomized.size() && !done; start += SHORTID_BATCH_SIZE) {
+        const size_t end{std::min(start + SHORTID_BATCH_SIZE, pool->txns_randomized.size())};
+        batch_wtxids.clear();
+        for (size_t i = start; i < end; ++i) batch_wtxids.push_back(&pool->txns_randomized[i].first.ToUint256());
+        cmpctblock.GetShortIDs(batch_wtxids, batch_shortids);
+        for (size_t i = start; i < end; ++i) {
+            const auto& txit{pool->txns_randomized[i].second};
+            uint64_t shortid = batch_shortids[i - start];
+            std::unordered_map<uint64_t, uint16_t>::iterator idit = shorttxids.find(shortid);
+            if (idit != shorttxids.end()) {
+                if (!have_txn[idit->second]) {
+                    txn_available[idit->second] = txit->GetSharedTx();
+                    have_txn[idit->second]  = true;
+                    mempool_count++;
+                } else {
+                    // If we find two mempool txn that match the short id, just request it.
+                    // This should be rare enough that the extra bandwidth doesn't matter,
+                    // but eating a round-trip due to FillBlock failure would be annoying
+                    if (txn_available[idit->second]) {
+                        txn_available[idit->second].reset();
+                        mempool_count--;
+                    }
                 }
             }
+            // Though ideally we'd continue scanning for the two-txn-match-shortid case,
+            // the performance win of an early exit here is too good to pass up and worth
+            // the extra risk.
+            if (mempool_count == shorttxids.size()) {
+                done = true;
+                break;
+            }
         }
-        // Though ideally we'd continue scanning for the two-txn-match-shortid case,
-        // the performance win of an early exit here is too good to pass up and worth
-        // the extra risk.
-        if (mempool_count == shorttxids.size())
-            break;
     }
     }
 
@@ -8,6 +8,7 @@
 #include <primitives/block.h>
 
 #include <functional>
+#include <span>
 
 class CTxMemPool;
 class BlockValidationState;
@@ -115,6 +116,8 @@ public:
     CBlockHeaderAndShortTxIDs(const CBlock& block, const uint64_t nonce);
 
     uint64_t GetShortID(const Wtxid& wtxid) const;
+    /** Compute the short IDs of several wtxids at once, writing one per wtxid to out. */
+    void GetShortIDs(std::span<const uint256* const> wtxids, uint64_t* out) const;
 
     size_t BlockTxCount() const { return shorttxids.size() + prefilledtxn.size(); }
 
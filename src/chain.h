@@ -54,16 +54,24 @@ public:
     unsigned int nHeightLast{};  //!< highest height of block in file
     uint64_t nTimeFirst{};       //!< earliest time of block in file
     uint64_t nTimeLast{};        //!< latest time of block in file
+    uint64_t nPunchedBytes{};    //!< number of bytes freed by punching holes into the block and undo files
 
-    SERIALIZE_METHODS(CBlockFileInfo, obj)
+    template <typename Stream>
+    void Serialize(Stream& s) const
     {
-        READWRITE(VARINT(obj.nBlocks));
-        READWRITE(VARINT(obj.nSize));
-        READWRITE(VARINT(obj.nUndoSize));
-        READWRITE(VARINT(obj.nHeightFirst));
-        READWRITE(VARINT(obj.nHeightLast));
-        READWRITE(VARINT(obj.nTimeFirst));
-        READWRITE(VARINT(obj.nTimeLast));
+        s << VARINT(nBlocks) << VARINT(nSize) << VARINT(nUndoSize) << VARINT(nHeightFirst) << VARINT(nHeightLast)
+          << VARINT(nTimeFirst) << VARINT(nTimeLast);
+        // Optional trailing field, so that the records of files without holes are unchanged.
+        if (nPunchedBytes != 0) s << VARINT(nPunchedBytes);
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        s >> VARINT(nBlocks) >> VARINT(nSize) >> VARINT(nUndoSize) >> VARINT(nHeightFirst) >> VARINT(nHeightLast)
+          >> VARINT(nTimeFirst) >> VARINT(nTimeLast);
+        nPunchedBytes = 0;
+        if (!s.empty()) s >> VARINT(nPunchedBytes);
     }
 
     CBlockFileInfo() = default;
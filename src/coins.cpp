@@ -9,6 +9,8 @@
 #include <random.h>
 #include <util/trace.h>
 
+#include <algorithm>
+
 TRACEPOINT_SEMAPHORE(utxocache, add);
 TRACEPOINT_SEMAPHORE(utxocache, spent);
 TRACEPOINT_SEMAPHORE(utxocache, uncache);
@@ -48,6 +50,7 @@ size_t CCoinsViewCache::DynamicMemoryUsage() const {
 CCoinsMap::iterator CCoinsViewCache::FetchCoin(const COutPoint &outpoint) const {
     const auto [ret, inserted] = cacheCoins.try_emplace(outpoint);
     if (inserted) {
+        ++m_cache_misses;
         if (auto coin{base->GetCoin(outpoint)}) {
             ret->second.coin = std::move(*coin);
             cachedCoinsUsage += ret->second.coin.DynamicMemoryUsage();
@@ -59,6 +62,8 @@ CCoinsMap::iterator CCoinsViewCache::FetchCoin(const COutPoint &outpoint) const
             cacheCoins.erase(ret);
             return cacheCoins.end();
         }
+    } else {
+        ++m_cache_hits;
     }
     return ret;
 }
@@ -116,6 +121,15 @@ void CCoinsViewCache::EmplaceCoinInternalDANGER(COutPoint&& outpoint, Coin&& coi
     if (inserted) CCoinsCacheEntry::SetDirty(*it, m_sentinel);
 }
 
+void CCoinsViewCache::PrefetchCoin(const COutPoint& outpoint, Coin&& coin)
+{
+    assert(!coin.IsSpent());
+    auto [it, inserted] = cacheCoins.try_emplace(outpoint);
+    if (!inserted) return;
+    it->second.coin = std::move(coin);
+    cachedCoinsUsage += it->second.coin.DynamicMemoryUsage();
+}
+
 void AddCoins(CCoinsViewCache& cache, const CTransaction &tx, int nHeight, bool check_for_overwrite) {
     bool fCoinbase = tx.IsCoinBase();
     const Txid& txid = tx.GetHash();
@@ -290,6 +304,17 @@ unsigned int CCoinsViewCache::GetCacheSize() const {
     return cacheCoins.size();
 }
 
+std::vector<COutPoint> CCoinsViewCache::GetCachedOutPoints(size_t max_count) const
+{
+    std::vector<COutPoint> outpoints;
+    outpoints.reserve(std::min(max_count, cacheCoins.size()));
+    for (const auto& [outpoint, entry] : cacheCoins) {
+        if (outpoints.size() >= max_count) break;
+        if (!entry.coin.IsSpent()) outpoints.push_back(outpoint);
+    }
+    return outpoints;
+}
+
 bool CCoinsViewCache::HaveInputs(const CTransaction& tx) const
 {
     if (!tx.IsCoinBase()) {
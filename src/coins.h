@@ -21,6 +21,7 @@
 
 #include <functional>
 #include <unordered_map>
+#include <vector>
 
 /**
  * A UTXO entry.
@@ -378,6 +379,10 @@ protected:
     /* Cached dynamic memory usage for the inner Coin objects. */
     mutable size_t cachedCoinsUsage{0};
 
+    /* Lookups answered from the cache, and lookups passed on to the backing view. */
+    mutable uint64_t m_cache_hits{0};
+    mutable uint64_t m_cache_misses{0};
+
 public:
     CCoinsViewCache(CCoinsView *baseIn, bool deterministic = false);
 
@@ -430,6 +435,16 @@ public:
      */
     void EmplaceCoinInternalDANGER(COutPoint&& outpoint, Coin&& coin);
 
+    /**
+     * Insert a coin read from the backing view as an unmodified entry, so that
+     * a later access does not have to go to the backing view. Has no effect if
+     * the outpoint is already cached.
+     *
+     * The caller must ensure that coin is what the backing view currently holds
+     * for outpoint. Used to warm the cache on startup.
+     */
+    void PrefetchCoin(const COutPoint& outpoint, Coin&& coin);
+
     /**
      * Spend a coin. Pass moveto in order to get the deleted data.
      * If no unspent output exists for the passed outpoint, this call
@@ -463,9 +478,17 @@ public:
     //! Calculate the size of the cache (in number of transaction outputs)
     unsigned int GetCacheSize() const;
 
+    //! Return the outpoints of up to max_count unspent coins held in the cache.
+    std::vector<COutPoint> GetCachedOutPoints(size_t max_count) const;
+
     //! Calculate the size of the cache (in bytes)
     size_t DynamicMemoryUsage() const;
 
+    //! Number of lookups answered from the cache since it was created.
+    uint64_t GetCacheHits() const { return m_cache_hits; }
+    //! Number of lookups passed on to the backing view since the cache was created.
+    uint64_t GetCacheMisses() const { return m_cache_misses; }
+
     //! Check whether all prevouts of the transaction are present in the UTXO set represented by this view
     bool HaveInputs(const CTransaction& tx) const;
 
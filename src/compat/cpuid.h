@@ -22,5 +22,25 @@ void static inline GetCPUID(uint32_t leaf, uint32_t subleaf, uint32_t& a, uint32
 #endif
 }
 
+/** Return the low half of XCR0, the register state enabled by the OS. Only call this when CPUID reports XSAVE support. */
+uint32_t static inline GetXCR0()
+{
+    uint32_t a, d;
+    __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+    return a;
+}
+
+/** Check whether the OS has enabled AVX registers. Only call this when CPUID reports XSAVE and AVX support. */
+bool static inline AVXEnabled()
+{
+    return (GetXCR0() & 6) == 6;
+}
+
+/** Check whether the OS has enabled AVX-512 registers (opmask and ZMM state). Only call this when CPUID reports XSAVE and AVX support. */
+bool static inline AVX512Enabled()
+{
+    return (GetXCR0() & 0xe6) == 0xe6;
+}
+
 #endif // defined(__x86_64__) || defined(__amd64__) || defined(__i386__)
 #endif // BITCOIN_COMPAT_CPUID_H
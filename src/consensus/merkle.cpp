@@ -189,3 +189,13 @@ std::vector<uint256> TransactionMerklePath(const CBlock& block, uint32_t positio
     }
     return ComputeMerklePath(leaves, position);
 }
+
+uint256 ComputeMerkleRootFromPath(const uint256& leaf, uint32_t position, std::span<const uint256> path)
+{
+    uint256 h = leaf;
+    for (const uint256& sibling : path) {
+        h = (position & 1) ? Hash(sibling, h) : Hash(h, sibling);
+        position >>= 1;
+    }
+    return h;
+}
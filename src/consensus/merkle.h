@@ -5,6 +5,7 @@
 #ifndef BITCOIN_CONSENSUS_MERKLE_H
 #define BITCOIN_CONSENSUS_MERKLE_H
 
+#include <span>
 #include <vector>
 
 #include <primitives/block.h>
@@ -34,4 +35,15 @@ uint256 BlockWitnessMerkleRoot(const CBlock& block, bool* mutated = nullptr);
  */
 std::vector<uint256> TransactionMerklePath(const CBlock& block, uint32_t position);
 
+/**
+ * Compute the merkle root from a leaf and its merkle path
+ *
+ * @param[in] leaf the hash at position
+ * @param[in] position index of the leaf (0 is the coinbase)
+ * @param[in] path merkle path ordered from the deepest, as returned by TransactionMerklePath
+ *
+ * @return merkle root
+ */
+uint256 ComputeMerkleRootFromPath(const uint256& leaf, uint32_t position, std::span<const uint256> path);
+
 #endif // BITCOIN_CONSENSUS_MERKLE_H
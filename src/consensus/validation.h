@@ -143,25 +143,30 @@ static inline int64_t GetTransactionInputWeight(const CTxIn& txin)
     return ::GetSerializeSize(TX_NO_WITNESS(txin)) * (WITNESS_SCALE_FACTOR - 1) + ::GetSerializeSize(TX_WITH_WITNESS(txin)) + ::GetSerializeSize(txin.scriptWitness.stack);
 }
 
-/** Compute at which vout of the block's coinbase transaction the witness commitment occurs, or -1 if not found */
-inline int GetWitnessCommitmentIndex(const CBlock& block)
+/** Compute at which vout of a coinbase transaction the witness commitment occurs, or -1 if not found */
+inline int GetWitnessCommitmentIndex(const CTransaction& coinbase)
 {
     int commitpos = NO_WITNESS_COMMITMENT;
-    if (!block.vtx.empty()) {
-        for (size_t o = 0; o < block.vtx[0]->vout.size(); o++) {
-            const CTxOut& vout = block.vtx[0]->vout[o];
-            if (vout.scriptPubKey.size() >= MINIMUM_WITNESS_COMMITMENT &&
-                vout.scriptPubKey[0] == OP_RETURN &&
-                vout.scriptPubKey[1] == 0x24 &&
-                vout.scriptPubKey[2] == 0xaa &&
-                vout.scriptPubKey[3] == 0x21 &&
-                vout.scriptPubKey[4] == 0xa9 &&
-                vout.scriptPubKey[5] == 0xed) {
-                commitpos = o;
-            }
+    for (size_t o = 0; o < coinbase.vout.size(); o++) {
+        const CTxOut& vout = coinbase.vout[o];
+        if (vout.scriptPubKey.size() >= MINIMUM_WITNESS_COMMITMENT &&
+            vout.scriptPubKey[0] == OP_RETURN &&
+            vout.scriptPubKey[1] == 0x24 &&
+            vout.scriptPubKey[2] == 0xaa &&
+            vout.scriptPubKey[3] == 0x21 &&
+            vout.scriptPubKey[4] == 0xa9 &&
+            vout.scriptPubKey[5] == 0xed) {
+            commitpos = o;
         }
     }
     return commitpos;
 }
 
+/** Compute at which vout of the block's coinbase transaction the witness commitment occurs, or -1 if not found */
+inline int GetWitnessCommitmentIndex(const CBlock& block)
+{
+    if (block.vtx.empty()) return NO_WITNESS_COMMITMENT;
+    return GetWitnessCommitmentIndex(*block.vtx[0]);
+}
+
 #endif // BITCOIN_CONSENSUS_VALIDATION_H
@@ -5,6 +5,7 @@
 #include <crypto/hmac_sha512.h>
 
 #include <cstring>
+#include <vector>
 
 CHMAC_SHA512::CHMAC_SHA512(const unsigned char* key, size_t keylen)
 {
@@ -32,3 +33,13 @@ void CHMAC_SHA512::Finalize(unsigned char hash[OUTPUT_SIZE])
     inner.Finalize(temp);
     outer.Write(temp, 64).Finalize(hash);
 }
+
+void CHMAC_SHA512::FinalizeMulti(std::span<const std::span<const unsigned char>> inputs, unsigned char* output) const
+{
+    std::vector<unsigned char> temp(inputs.size() * 64);
+    inner.FinalizeMulti(inputs, temp.data());
+    std::vector<std::span<const unsigned char>> inner_hashes;
+    inner_hashes.reserve(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) inner_hashes.emplace_back(temp.data() + i * 64, 64);
+    outer.FinalizeMulti(inner_hashes, output);
+}
@@ -9,6 +9,7 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <span>
 
 /** A hasher class for HMAC-SHA-512. */
 class CHMAC_SHA512
@@ -27,6 +28,12 @@ public:
         return *this;
     }
     void Finalize(unsigned char hash[OUTPUT_SIZE]);
+
+    /** Finish one HMAC per input, each over the data written so far followed
+     *  by that input, without modifying this object.
+     *  output: pointer to an inputs.size()*OUTPUT_SIZE byte output buffer
+     */
+    void FinalizeMulti(std::span<const std::span<const unsigned char>> inputs, unsigned char* output) const;
 };
 
 #endif // BITCOIN_CRYPTO_HMAC_SHA512_H
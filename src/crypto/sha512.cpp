@@ -6,7 +6,22 @@
 
 #include <crypto/common.h>
 
+#include <algorithm>
+#include <cassert>
 #include <cstring>
+#include <vector>
+
+#include <compat/cpuid.h>
+
+namespace sha512_avx2
+{
+void Transform_4way(uint64_t* const s[4], const unsigned char* const chunk[4]);
+}
+
+namespace sha512_avx512
+{
+void Transform_8way(uint64_t* const s[8], const unsigned char* const chunk[8]);
+}
 
 // Internal implementation code.
 namespace
@@ -146,8 +161,139 @@ void Transform(uint64_t* s, const unsigned char* chunk)
 
 } // namespace sha512
 
+/** Perform one SHA-512 transformation on each of several independent states, one chunk each. */
+typedef void (*TransformMultiType)(uint64_t* const* s, const unsigned char* const* chunk);
+
+TransformMultiType TransformMulti = nullptr;
+//! Number of states processed by each TransformMulti call.
+size_t TransformMultiLanes = 1;
+constexpr size_t MAX_TRANSFORM_LANES = 8;
+
+/** Run the given number of consecutive chunks through each state, interleaving
+ *  them over the available lanes so that messages of different length do not
+ *  leave lanes idle. */
+void TransformInterleaved(std::span<uint64_t> states, std::span<const unsigned char* const> chunks, std::span<const size_t> num_chunks)
+{
+    const size_t count{num_chunks.size()};
+    if (!TransformMulti || count < 2) {
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t n = 0; n < num_chunks[i]; ++n) sha512::Transform(&states[8 * i], chunks[i] + 128 * n);
+        }
+        return;
+    }
+
+    // Idle lanes run over a scratch state so every call processes a full set.
+    uint64_t scratch_state[8]{};
+    static const unsigned char scratch_chunk[128]{};
+
+    size_t lane_job[MAX_TRANSFORM_LANES];
+    size_t lane_pos[MAX_TRANSFORM_LANES];
+    bool lane_active[MAX_TRANSFORM_LANES]{};
+    size_t next_job{0};
+    while (true) {
+        size_t active{0};
+        for (size_t lane = 0; lane < TransformMultiLanes; ++lane) {
+            while (!lane_active[lane] && next_job < count) {
+                if (num_chunks[next_job] > 0) {
+                    lane_job[lane] = next_job;
+                    lane_pos[lane] = 0;
+                    lane_active[lane] = true;
+                }
+                ++next_job;
+            }
+            active += lane_active[lane];
+        }
+        if (active == 0) break;
+
+        uint64_t* lane_states[MAX_TRANSFORM_LANES];
+        const unsigned char* lane_chunks[MAX_TRANSFORM_LANES];
+        for (size_t lane = 0; lane < TransformMultiLanes; ++lane) {
+            lane_states[lane] = lane_active[lane] ? &states[8 * lane_job[lane]] : scratch_state;
+            lane_chunks[lane] = lane_active[lane] ? chunks[lane_job[lane]] + 128 * lane_pos[lane] : scratch_chunk;
+        }
+        if (active == 1) {
+            // Not worth a multi-buffer transform for a single message.
+            for (size_t lane = 0; lane < TransformMultiLanes; ++lane) {
+                if (lane_active[lane]) sha512::Transform(lane_states[lane], lane_chunks[lane]);
+            }
+        } else {
+            TransformMulti(lane_states, lane_chunks);
+        }
+        for (size_t lane = 0; lane < TransformMultiLanes; ++lane) {
+            if (lane_active[lane] && ++lane_pos[lane] == num_chunks[lane_job[lane]]) lane_active[lane] = false;
+        }
+    }
+}
+
+bool SelfTest()
+{
+    // Messages of varying length, some spanning several chunks, hashed at
+    // once must give the same results as hashing them one by one.
+    unsigned char data[300];
+    for (size_t i = 0; i < sizeof(data); ++i) data[i] = i * 37 + 11;
+    static const size_t lengths[] = {0, 37, 111, 112, 128, 200, 1, 64, 300, 239, 17};
+    for (const size_t prefix : {0, 128, 150}) {
+        CSHA512 hasher;
+        hasher.Write(data, prefix);
+        std::vector<std::span<const unsigned char>> inputs;
+        for (const size_t len : lengths) inputs.emplace_back(data, len);
+        std::vector<unsigned char> out(inputs.size() * CSHA512::OUTPUT_SIZE);
+        hasher.FinalizeMulti(inputs, out.data());
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            unsigned char expected[CSHA512::OUTPUT_SIZE];
+            CSHA512{hasher}.Write(inputs[i].data(), inputs[i].size()).Finalize(expected);
+            if (!std::equal(expected, expected + CSHA512::OUTPUT_SIZE, out.data() + i * CSHA512::OUTPUT_SIZE)) return false;
+        }
+    }
+    return true;
+}
+
 } // namespace
 
+std::string SHA512AutoDetect(sha512_implementation::UseImplementation use_implementation)
+{
+    std::string ret = "standard";
+    TransformMulti = nullptr;
+    TransformMultiLanes = 1;
+
+#if defined(HAVE_GETCPUID)
+    uint32_t eax, ebx, ecx, edx;
+    GetCPUID(0, 0, eax, ebx, ecx, edx);
+    const uint32_t max_leaf = eax;
+    GetCPUID(1, 0, eax, ebx, ecx, edx);
+    const bool have_xsave = (ecx >> 27) & 1;
+    const bool have_avx = (ecx >> 28) & 1;
+    const bool enabled_avx = have_xsave && have_avx && AVXEnabled();
+    const bool enabled_avx512 = enabled_avx && AVX512Enabled();
+    [[maybe_unused]] bool have_avx2 = false;
+    [[maybe_unused]] bool have_avx512 = false;
+    if (max_leaf >= 7) {
+        GetCPUID(7, 0, eax, ebx, ecx, edx);
+        // AVX2 needs the YMM state enabled, AVX-512F additionally the opmask and ZMM state.
+        have_avx2 = (use_implementation & sha512_implementation::USE_AVX2) && ((ebx >> 5) & 1) && enabled_avx;
+        have_avx512 = (use_implementation & sha512_implementation::USE_AVX512) && ((ebx >> 16) & 1) && enabled_avx512;
+    }
+
+#if defined(ENABLE_AVX2)
+    if (have_avx2) {
+        TransformMulti = sha512_avx2::Transform_4way;
+        TransformMultiLanes = 4;
+        ret = "avx2(4way)";
+    }
+#endif
+#if defined(ENABLE_AVX512)
+    if (have_avx512) {
+        TransformMulti = sha512_avx512::Transform_8way;
+        TransformMultiLanes = 8;
+        ret = "avx512(8way)";
+    }
+#endif
+#endif // defined(HAVE_GETCPUID)
+
+    assert(SelfTest());
+    return ret;
+}
+
 
 ////// SHA-512
 
@@ -205,3 +351,39 @@ CSHA512& CSHA512::Reset()
     sha512::Initialize(s);
     return *this;
 }
+
+void CSHA512::FinalizeMulti(std::span<const std::span<const unsigned char>> inputs, unsigned char* output) const
+{
+    // Lay out what remains of every message (buffered data, input and
+    // padding) as whole chunks, each continuing from the current state.
+    const size_t bufsize = bytes % 128;
+    std::vector<size_t> num_chunks;
+    num_chunks.reserve(inputs.size());
+    size_t total{0};
+    for (const auto& input : inputs) {
+        num_chunks.push_back((bufsize + input.size() + 1 + 16 + 127) / 128);
+        total += num_chunks.back();
+    }
+    std::vector<unsigned char> data(total * 128);
+    std::vector<const unsigned char*> chunks;
+    chunks.reserve(inputs.size());
+    std::vector<uint64_t> states;
+    states.reserve(inputs.size() * 8);
+    unsigned char* pos = data.data();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const size_t len = bufsize + inputs[i].size();
+        memcpy(pos, buf, bufsize);
+        if (!inputs[i].empty()) memcpy(pos + bufsize, inputs[i].data(), inputs[i].size());
+        pos[len] = 0x80;
+        WriteBE64(pos + num_chunks[i] * 128 - 8, (bytes + inputs[i].size()) << 3);
+        chunks.push_back(pos);
+        states.insert(states.end(), s, s + 8);
+        pos += num_chunks[i] * 128;
+    }
+
+    TransformInterleaved(states, chunks, num_chunks);
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        for (int j = 0; j < 8; ++j) WriteBE64(output + i * OUTPUT_SIZE + j * 8, states[i * 8 + j]);
+    }
+}
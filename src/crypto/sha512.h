@@ -7,6 +7,8 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <span>
+#include <string>
 
 /** A hasher class for SHA-512. */
 class CSHA512
@@ -24,6 +26,28 @@ public:
     void Finalize(unsigned char hash[OUTPUT_SIZE]);
     CSHA512& Reset();
     uint64_t Size() const { return bytes; }
+
+    /** Finish one hash per input, each continuing from the data written so far
+     *  and followed by that input, without modifying this object.
+     *  output: pointer to an inputs.size()*OUTPUT_SIZE byte output buffer
+     *  The inputs are hashed in parallel when a multi-buffer implementation is
+     *  available (see SHA512AutoDetect).
+     */
+    void FinalizeMulti(std::span<const std::span<const unsigned char>> inputs, unsigned char* output) const;
+};
+
+namespace sha512_implementation {
+enum UseImplementation : uint8_t {
+    STANDARD = 0,
+    USE_AVX2 = 1 << 0,
+    USE_AVX512 = 1 << 1,
+    USE_ALL = USE_AVX2 | USE_AVX512,
 };
+}
+
+/** Autodetect the best available multi-buffer SHA512 implementation used by
+ *  CSHA512::FinalizeMulti. Returns the name of the implementation.
+ */
+std::string SHA512AutoDetect(sha512_implementation::UseImplementation use_implementation = sha512_implementation::USE_ALL);
 
 #endif // BITCOIN_CRYPTO_SHA512_H
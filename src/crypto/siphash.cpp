@@ -4,7 +4,15 @@
 
 #include <crypto/siphash.h>
 
+#include <compat/cpuid.h>
+
 #include <bit>
+#include <cassert>
+
+namespace siphash_avx2
+{
+void SipHashUint256_4way(uint64_t k0, uint64_t k1, const uint256* const vals[4], uint64_t out[4]);
+}
 
 #define SIPROUND do { \
     v0 += v1; v1 = std::rotl(v1, 13); v1 ^= v0; \
@@ -172,3 +180,55 @@ uint64_t SipHashUint256Extra(uint64_t k0, uint64_t k1, const uint256& val, uint3
     SIPROUND;
     return v0 ^ v1 ^ v2 ^ v3;
 }
+
+namespace {
+/** Whether the 4-way AVX2 implementation can be used on this CPU. */
+bool UseSipHash4Way()
+{
+#if defined(ENABLE_AVX2) && defined(HAVE_GETCPUID)
+    static const bool use_avx2{[] {
+        uint32_t eax, ebx, ecx, edx;
+        GetCPUID(0, 0, eax, ebx, ecx, edx);
+        if (eax < 7) return false;
+        GetCPUID(1, 0, eax, ebx, ecx, edx);
+        if (!((ecx >> 27) & 1) || !((ecx >> 28) & 1)) return false; // XSAVE and AVX
+        if (!AVXEnabled()) return false;
+        GetCPUID(7, 0, eax, ebx, ecx, edx);
+        return ((ebx >> 5) & 1) != 0;
+    }()};
+    return use_avx2;
+#else
+    return false;
+#endif
+}
+} // namespace
+
+void SipHashUint256Multi(uint64_t k0, uint64_t k1, std::span<const uint256* const> vals, uint64_t* out)
+{
+    size_t i{0};
+    if (UseSipHash4Way()) {
+        for (; i + 4 <= vals.size(); i += 4) {
+            siphash_avx2::SipHashUint256_4way(k0, k1, vals.data() + i, out + i);
+        }
+    }
+    for (; i < vals.size(); ++i) out[i] = SipHashUint256(k0, k1, *vals[i]);
+}
+
+bool SipHash_SelfTest()
+{
+    // Check the multi-value path, in full and partial groups of 4, against
+    // the scalar implementation.
+    constexpr uint64_t k0{0x0706050403020100ULL}, k1{0x0F0E0D0C0B0A0908ULL};
+    uint256 vals[7];
+    const uint256* ptrs[7];
+    for (int i = 0; i < 7; ++i) {
+        for (int j = 0; j < 32; ++j) vals[i].data()[j] = uint8_t(i * 32 + j);
+        ptrs[i] = &vals[i];
+    }
+    uint64_t out[7];
+    SipHashUint256Multi(k0, k1, ptrs, out);
+    for (int i = 0; i < 7; ++i) {
+        if (out[i] != SipHashUint256(k0, k1, vals[i])) return false;
+    }
+    return true;
+}
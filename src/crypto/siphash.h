@@ -45,4 +45,12 @@ public:
 uint64_t SipHashUint256(uint64_t k0, uint64_t k1, const uint256& val);
 uint64_t SipHashUint256Extra(uint64_t k0, uint64_t k1, const uint256& val, uint32_t extra);
 
+/** Compute SipHashUint256(k0, k1, *vals[i]) for every i, writing the results to out.
+ *  Several values are hashed in parallel when the CPU supports AVX2.
+ */
+void SipHashUint256Multi(uint64_t k0, uint64_t k1, std::span<const uint256* const> vals, uint64_t* out);
+
+/** Check that SipHashUint256Multi agrees with SipHashUint256 on this CPU. */
+bool SipHash_SelfTest();
+
 #endif // BITCOIN_CRYPTO_SIPHASH_H
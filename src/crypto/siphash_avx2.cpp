@@ -0,0 +1,63 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_AVX2
+
+#include <cstdint>
+#include <immintrin.h>
+
+#include <attributes.h>
+#include <uint256.h>
+
+namespace siphash_avx2 {
+namespace {
+
+__m256i inline Add(__m256i x, __m256i y) { return _mm256_add_epi64(x, y); }
+__m256i inline Xor(__m256i x, __m256i y) { return _mm256_xor_si256(x, y); }
+__m256i inline RotL(__m256i x, int n) { return _mm256_or_si256(_mm256_slli_epi64(x, n), _mm256_srli_epi64(x, 64 - n)); }
+__m256i inline RotL32(__m256i x) { return _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)); }
+
+void ALWAYS_INLINE SipRound(__m256i& v0, __m256i& v1, __m256i& v2, __m256i& v3)
+{
+    v0 = Add(v0, v1); v1 = RotL(v1, 13); v1 = Xor(v1, v0);
+    v0 = RotL32(v0);
+    v2 = Add(v2, v3); v3 = RotL(v3, 16); v3 = Xor(v3, v2);
+    v0 = Add(v0, v3); v3 = RotL(v3, 21); v3 = Xor(v3, v0);
+    v2 = Add(v2, v1); v1 = RotL(v1, 17); v1 = Xor(v1, v2);
+    v2 = RotL32(v2);
+}
+
+void ALWAYS_INLINE Compress(__m256i& v0, __m256i& v1, __m256i& v2, __m256i& v3, __m256i d)
+{
+    v3 = Xor(v3, d);
+    SipRound(v0, v1, v2, v3);
+    SipRound(v0, v1, v2, v3);
+    v0 = Xor(v0, d);
+}
+
+} // namespace
+
+void SipHashUint256_4way(uint64_t k0, uint64_t k1, const uint256* const vals[4], uint64_t out[4])
+{
+    __m256i v0 = _mm256_set1_epi64x(0x736f6d6570736575ULL ^ k0);
+    __m256i v1 = _mm256_set1_epi64x(0x646f72616e646f6dULL ^ k1);
+    __m256i v2 = _mm256_set1_epi64x(0x6c7967656e657261ULL ^ k0);
+    __m256i v3 = _mm256_set1_epi64x(0x7465646279746573ULL ^ k1);
+
+    for (int i = 0; i < 4; ++i) {
+        Compress(v0, v1, v2, v3, _mm256_set_epi64x(vals[3]->GetUint64(i), vals[2]->GetUint64(i), vals[1]->GetUint64(i), vals[0]->GetUint64(i)));
+    }
+    Compress(v0, v1, v2, v3, _mm256_set1_epi64x(uint64_t{32} << 56));
+
+    v2 = Xor(v2, _mm256_set1_epi64x(0xFF));
+    SipRound(v0, v1, v2, v3);
+    SipRound(v0, v1, v2, v3);
+    SipRound(v0, v1, v2, v3);
+    SipRound(v0, v1, v2, v3);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), Xor(Xor(v0, v1), Xor(v2, v3)));
+}
+
+} // namespace siphash_avx2
+
+#endif
@@ -12,6 +12,7 @@
 #include <util/fs.h>
 #include <util/fs_helpers.h>
 #include <util/obfuscation.h>
+#include <util/perfcounters.h>
 #include <util/strencodings.h>
 
 #include <algorithm>
@@ -304,6 +305,7 @@ size_t CDBWrapper::DynamicMemoryUsage() const
 
 std::optional<std::string> CDBWrapper::ReadImpl(std::span<const std::byte> key) const
 {
+    perf::ScopedTimer timer{"leveldb", "read"};
     leveldb::Slice slKey(CharCast(key.data()), key.size());
     std::string strValue;
     leveldb::Status status = DBContext().pdb->Get(DBContext().readoptions, slKey, &strValue);
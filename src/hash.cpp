@@ -8,7 +8,9 @@
 #include <crypto/hmac_sha512.h>
 
 #include <bit>
+#include <cstring>
 #include <string>
+#include <vector>
 
 unsigned int MurmurHash3(unsigned int nHashSeed, std::span<const unsigned char> vDataToHash)
 {
@@ -75,6 +77,21 @@ void BIP32Hash(const ChainCode &chainCode, unsigned int nChild, unsigned char he
     CHMAC_SHA512(chainCode.begin(), chainCode.size()).Write(&header, 1).Write(data, 32).Write(num, 4).Finalize(output);
 }
 
+void BIP32Hash(const ChainCode& chainCode, std::span<const unsigned int> children, unsigned char header, const unsigned char data[32], unsigned char* output)
+{
+    std::vector<unsigned char> messages(children.size() * 37);
+    std::vector<std::span<const unsigned char>> inputs;
+    inputs.reserve(children.size());
+    for (size_t i = 0; i < children.size(); ++i) {
+        unsigned char* msg = messages.data() + i * 37;
+        msg[0] = header;
+        memcpy(msg + 1, data, 32);
+        WriteBE32(msg + 33, children[i]);
+        inputs.emplace_back(msg, 37);
+    }
+    CHMAC_SHA512(chainCode.begin(), chainCode.size()).FinalizeMulti(inputs, output);
+}
+
 uint256 SHA256Uint256(const uint256& input)
 {
     uint256 result;
@@ -209,6 +209,8 @@ public:
 unsigned int MurmurHash3(unsigned int nHashSeed, std::span<const unsigned char> vDataToHash);
 
 void BIP32Hash(const ChainCode &chainCode, unsigned int nChild, unsigned char header, const unsigned char data[32], unsigned char output[64]);
+/** Compute BIP32Hash for several children of the same parent at once, writing 64 bytes per child to output. */
+void BIP32Hash(const ChainCode& chainCode, std::span<const unsigned int> children, unsigned char header, const unsigned char data[32], unsigned char* output);
 
 /** Return a HashWriter primed for tagged hashes (as specified in BIP 340).
  *
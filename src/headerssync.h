@@ -15,6 +15,7 @@
 #include <util/hasher.h>
 
 #include <deque>
+#include <span>
 #include <vector>
 
 // A compressed CBlockHeader, which leaves out the prevhash
@@ -156,6 +157,9 @@ public:
      *                   rules).
      * full_headers_message: true if the message was at max capacity,
      *                       indicating more headers may be available
+     * hashes:               the hashes of received_headers, if the caller
+     *                       computed them already (e.g. while checking their
+     *                       proof-of-work); computed here when left empty.
      * ProcessingResult.pow_validated_headers: will be filled in with any
      *                       headers that the caller can fully process and
      *                       validate now (because these returned headers are
@@ -166,7 +170,7 @@ public:
      *                       NextHeadersRequestLocator and send a getheaders message using it.
      */
     ProcessingResult ProcessNextHeaders(const std::vector<CBlockHeader>&
-            received_headers, bool full_headers_message);
+            received_headers, bool full_headers_message, std::span<const uint256> hashes = {});
 
     /** Issue the next GETHEADERS message to our peer.
      *
@@ -195,14 +199,14 @@ private:
      *  processed headers.
      *  On failure, this invokes Finalize() and returns false.
      */
-    bool ValidateAndStoreHeadersCommitments(const std::vector<CBlockHeader>& headers);
+    bool ValidateAndStoreHeadersCommitments(const std::vector<CBlockHeader>& headers, std::span<const uint256> hashes);
 
     /** In PRESYNC, process and update state for a single header */
-    bool ValidateAndProcessSingleHeader(const CBlockHeader& current);
+    bool ValidateAndProcessSingleHeader(const CBlockHeader& current, const uint256& hash);
 
     /** In REDOWNLOAD, check a header's commitment (if applicable) and add to
      * buffer for later processing */
-    bool ValidateAndStoreRedownloadedHeader(const CBlockHeader& header);
+    bool ValidateAndStoreRedownloadedHeader(const CBlockHeader& header, const uint256& hash);
 
     /** Return a set of headers that satisfy our proof-of-work threshold */
     std::vector<CBlockHeader> PopHeadersReadyForAcceptance();
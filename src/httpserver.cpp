@@ -14,6 +14,7 @@
 #include <rpc/protocol.h>
 #include <sync.h>
 #include <util/check.h>
+#include <util/perfcounters.h>
 #include <util/signalinterrupt.h>
 #include <util/strencodings.h>
 #include <util/threadnames.h>
@@ -53,18 +54,20 @@ static const size_t MAX_HEADERS_SIZE = 8192;
 class HTTPWorkItem final : public HTTPClosure
 {
 public:
-    HTTPWorkItem(std::unique_ptr<HTTPRequest> _req, const std::string &_path, const HTTPRequestHandler& _func):
-        req(std::move(_req)), path(_path), func(_func)
+    HTTPWorkItem(std::unique_ptr<HTTPRequest> _req, const std::string& _prefix, const std::string &_path, const HTTPRequestHandler& _func):
+        req(std::move(_req)), prefix(_prefix), path(_path), func(_func)
     {
     }
     void operator()() override
     {
+        perf::ScopedTimer timer{"http", prefix};
         func(req.get(), path);
     }
 
     std::unique_ptr<HTTPRequest> req;
 
 private:
+    std::string prefix;
     std::string path;
     HTTPRequestHandler func;
 };
@@ -327,7 +330,7 @@ static void http_request_cb(struct evhttp_request* req, void* arg)
 
     // Dispatch to worker thread
     if (i != iend) {
-        std::unique_ptr<HTTPWorkItem> item(new HTTPWorkItem(std::move(hreq), path, i->handler));
+        std::unique_ptr<HTTPWorkItem> item(new HTTPWorkItem(std::move(hreq), i->prefix, path, i->handler));
         assert(g_work_queue);
         if (g_work_queue->Enqueue(item.get())) {
             item.release(); /* if true, queue took ownership */
@@ -47,9 +47,11 @@
 #include <netgroup.h>
 #include <node/blockmanager_args.h>
 #include <node/blockstorage.h>
+#include <node/cache_governor.h>
 #include <node/caches.h>
 #include <node/chainstate.h>
 #include <node/chainstatemanager_args.h>
+#include <node/coinscache_persist.h>
 #include <node/context.h>
 #include <node/interface_ui.h>
 #include <node/kernel_notifications.h>
@@ -83,6 +85,7 @@
 #include <util/fs.h>
 #include <util/fs_helpers.h>
 #include <util/moneystr.h>
+#include <util/perfcounters.h>
 #include <util/result.h>
 #include <util/signalinterrupt.h>
 #include <util/strencodings.h>
@@ -127,19 +130,28 @@ using common::ResolveErrMsg;
 
 using node::ApplyArgsManOptions;
 using node::BlockManager;
+using node::CACHE_GOVERNOR_INTERVAL;
+using node::CacheGovernor;
 using node::CalculateCacheSizes;
 using node::ChainstateLoadResult;
 using node::ChainstateLoadStatus;
+using node::CoinsCachePath;
+using node::DEFAULT_ADAPTIVE_DBCACHE;
+using node::DEFAULT_PERSIST_COINS_CACHE;
 using node::DEFAULT_PERSIST_MEMPOOL;
 using node::DEFAULT_PRINT_MODIFIED_FEE;
 using node::DEFAULT_STOPATHEIGHT;
+using node::DumpCoinsCache;
 using node::DumpMempool;
+using node::FindCgroupMemoryDir;
 using node::ImportBlocks;
 using node::KernelNotifications;
 using node::LoadChainstate;
+using node::LoadCoinsCache;
 using node::LoadMempool;
 using node::MempoolPath;
 using node::NodeContext;
+using node::ShouldPersistCoinsCache;
 using node::ShouldPersistMempool;
 using node::VerifyLoadedChainstate;
 using util::Join;
@@ -150,6 +162,10 @@ static constexpr bool DEFAULT_PROXYRANDOMIZE{true};
 static constexpr bool DEFAULT_REST_ENABLE{false};
 static constexpr bool DEFAULT_I2P_ACCEPT_INCOMING{true};
 static constexpr bool DEFAULT_STOPAFTERBLOCKIMPORT{false};
+//! Number of threads delivering validation interface notifications, so that
+//! one slow subscriber does not hold up the others.
+static constexpr int DEFAULT_NOTIFICATION_THREADS{4};
+static constexpr int MAX_NOTIFICATION_THREADS{8};
 
 #ifdef WIN32
 // Win32 LevelDB doesn't use filedescriptors, and the ones used for
@@ -324,6 +340,7 @@ void Shutdown(NodeContext& node)
     // the scheduler. After this point, SyncWithValidationInterfaceQueue() should not be called anymore
     // as this would prevent the shutdown from completing.
     if (node.scheduler) node.scheduler->stop();
+    if (node.notification_scheduler) node.notification_scheduler->stop();
 
     // After the threads that potentially access these pointers have been stopped,
     // destruct and reset all to nullptr.
@@ -337,6 +354,11 @@ void Shutdown(NodeContext& node)
         DumpMempool(*node.mempool, MempoolPath(*node.args));
     }
 
+    // Must happen before the chainstate is flushed, which empties the UTXO cache.
+    if (node.chainman && node.coins_cache_load_tried && ShouldPersistCoinsCache(*node.args)) {
+        DumpCoinsCache(node.chainman->ActiveChainstate(), CoinsCachePath(*node.args));
+    }
+
     // Drop transactions we were still watching, record fee estimations and unregister
     // fee estimator from validation interface.
     if (node.fee_estimator) {
@@ -404,6 +426,7 @@ void Shutdown(NodeContext& node)
     node.fee_estimator.reset();
     node.chainman.reset();
     node.validation_signals.reset();
+    node.notification_scheduler.reset();
     node.scheduler.reset();
     node.ecc_context.reset();
     node.kernel.reset();
@@ -411,6 +434,7 @@ void Shutdown(NodeContext& node)
     RemovePidFile(*node.args);
 
     LogInfo("Shutdown done");
+    LogInstance().StopAsyncWriter();
 }
 
 /**
@@ -501,17 +525,19 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-datadir=<dir>", "Specify data directory", ArgsManager::ALLOW_ANY | ArgsManager::DISALLOW_NEGATION, OptionsCategory::OPTIONS);
     argsman.AddArg("-dbbatchsize", strprintf("Maximum database write batch size in bytes (default: %u)", nDefaultDbBatchSize), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
      argsman.AddArg("-dbcache=<n>", strprintf("Maximum database cache size <n> MiB (minimum %d, default: %d). Make sure you have enough RAM. In addition, unused memory allocated to the mempool is shared with this cache (see -maxmempool).", MIN_DB_CACHE >> 20, DEFAULT_DB_CACHE >> 20), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-adaptivedbcache", strprintf("Resize the UTXO cache at runtime: shrink it when the cgroup the node runs in is short of memory, grow it beyond -dbcache into free cgroup memory when it misses often, and write it to disk while no blocks arrive (default: %u)", DEFAULT_ADAPTIVE_DBCACHE), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
      argsman.AddArg("-descriptor=<desc>", "Output descriptor to use (required). Must be a valid descriptor string.", ArgsManager::ALLOW_ANY | ArgsManager::DISALLOW_NEGATION, OptionsCategory::OPTIONS);
      argsman.AddArg("-includeconf=<file>", "Specify additional configuration file, relative to the -datadir path (only useable from configuration file, not command line)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-allowignoredconf", strprintf("For backwards compatibility, treat an unused %s file in the datadir as a warning, not an error.", BITCOIN_CONF_FILENAME), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-loadblock=<file>", "Imports blocks from external file on startup", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
-    argsman.AddArg("-maxmempool=<n>", strprintf("Keep the transaction memory pool below <n> megabytes (default: %u)", DEFAULT_MAX_MEMPOOL_SIZE_MB), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-maxmempool=<n>", strprintf("Keep the transaction memory pool below <n> megabytes (default: %u). This includes the outputs spent by each transaction, kept for block validation: about 400 bytes per transaction and 50 to 100 bytes per input", DEFAULT_MAX_MEMPOOL_SIZE_MB), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     // TODO: remove in v31.0
     argsman.AddArg("-maxorphantx=<n>", strprintf("(Removed option, see release notes)"), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-mempoolexpiry=<n>", strprintf("Do not keep transactions in the mempool longer than <n> hours (default: %u)", DEFAULT_MEMPOOL_EXPIRY_HOURS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-minimumchainwork=<hex>", strprintf("Minimum work assumed to exist on a valid chain in hex (default: %s, testnet3: %s, testnet4: %s, signet: %s)", defaultChainParams->GetConsensus().nMinimumChainWork.GetHex(), testnetChainParams->GetConsensus().nMinimumChainWork.GetHex(), testnet4ChainParams->GetConsensus().nMinimumChainWork.GetHex(), signetChainParams->GetConsensus().nMinimumChainWork.GetHex()), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
     argsman.AddArg("-par=<n>", strprintf("Set the number of script verification threads (0 = auto, up to %d, <0 = leave that many cores free, default: %d)",
         MAX_SCRIPTCHECK_THREADS, DEFAULT_SCRIPTCHECK_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-persistcoinscache", strprintf("Whether to save the outpoints held in the UTXO cache on shutdown and read their coins back into the cache on restart (default: %u)", DEFAULT_PERSIST_COINS_CACHE), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-persistmempool", strprintf("Whether to save the mempool on shutdown and load on restart (default: %u)", DEFAULT_PERSIST_MEMPOOL), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-persistmempoolv1",
                    strprintf("Whether a mempool.dat file created by -persistmempool or the savemempool RPC will be written in the legacy format "
@@ -522,6 +548,7 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-prune=<n>", strprintf("Reduce storage requirements by enabling pruning (deleting) of old blocks. This allows the pruneblockchain RPC to be called to delete specific blocks and enables automatic pruning of old blocks if a target size in MiB is provided. This mode is incompatible with -txindex. "
             "Warning: Reverting this setting requires re-downloading the entire blockchain. "
             "(default: 0 = disable pruning blocks, 1 = allow manual pruning via RPC, >=%u = automatically prune block files to stay under the specified target size in MiB)", MIN_DISK_SPACE_FOR_BLOCK_FILES / 1024 / 1024), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-prunepunchholes", strprintf("When automatic pruning cannot reach the target by deleting whole block files, also free the space of prunable blocks inside block files that are still needed, if the file system supports it (default: %u)", kernel::DEFAULT_PRUNE_PUNCH_HOLES), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-reindex", "If enabled, wipe chain state and block index, and rebuild them from blk*.dat files on disk. Also wipe and rebuild other optional indexes that are active. If an assumeutxo snapshot was loaded, its chainstate will be wiped as well. The snapshot can then be reloaded via RPC.", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-reindex-chainstate", "If enabled, wipe chain state, and rebuild it from blk*.dat files on disk. If an assumeutxo snapshot was loaded, its chainstate will be wiped as well. The snapshot can then be reloaded via RPC.", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-settings=<file>", strprintf("Specify path to dynamic settings data file. Can be disabled with -nosettings. File is written at runtime and not meant to be edited by users (use %s instead for custom settings). Relative paths will be prefixed by datadir location. (default: %s)", BITCOIN_CONF_FILENAME, BITCOIN_SETTINGS_FILENAME), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
@@ -564,6 +591,7 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-v2transport", strprintf("Support v2 transport (default: %u)", DEFAULT_V2_TRANSPORT), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-peerbloomfilters", strprintf("Support filtering of blocks and transaction with bloom filters (default: %u)", DEFAULT_PEERBLOOMFILTERS), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-peerblockfilters", strprintf("Serve compact block filters to peers per BIP 157 (default: %u)", DEFAULT_PEERBLOCKFILTERS), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
+    argsman.AddArg("-signetproofrelay", strprintf("Exchange signet solution proofs with peers ahead of block announcements, so blocks with an invalid solution are not downloaded (signet only, default: %u)", DEFAULT_SIGNET_PROOF_RELAY), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-txreconciliation", strprintf("Enable transaction reconciliations per BIP 330 (default: %d)", DEFAULT_TXRECONCILIATION_ENABLE), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::CONNECTION);
     argsman.AddArg("-port=<port>", strprintf("Listen for connections on <port> (default: %u, testnet3: %u, testnet4: %u, signet: %u, regtest: %u). Not relevant for I2P (see doc/i2p.md). If set to a value x, the default onion listening port will be set to x+1.", defaultChainParams->GetDefaultPort(), testnetChainParams->GetDefaultPort(), testnet4ChainParams->GetDefaultPort(), signetChainParams->GetDefaultPort(), regtestChainParams->GetDefaultPort()), ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::CONNECTION);
     const std::string proxy_doc_for_value =
@@ -633,6 +661,7 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-checkblocks=<n>", strprintf("How many blocks to check at startup (default: %u, 0 = all)", DEFAULT_CHECKBLOCKS), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-checklevel=<n>", strprintf("How thorough the block verification of -checkblocks is: %s (0-4, default: %u)", Join(CHECKLEVEL_DOC, ", "), DEFAULT_CHECKLEVEL), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-checkblockindex", strprintf("Do a consistency check for the block tree, chainstate, and other validation data structures every <n> operations. Use 0 to disable. (default: %u, regtest: %u)", defaultChainParams->DefaultConsistencyChecks(), regtestChainParams->DefaultConsistencyChecks()), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
+    argsman.AddArg("-checkblockindexincremental", strprintf("With -checkblockindex, only check the block index entries that changed since the previous check, and check the whole block index in the background every %d minutes (default: %u)", CHECK_BLOCK_INDEX_SWEEP_INTERVAL.count(), kernel::DEFAULT_CHECK_BLOCK_INDEX_INCREMENTAL), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-checkaddrman=<n>", strprintf("Run addrman consistency checks every <n> operations. Use 0 to disable. (default: %u)", DEFAULT_ADDRMAN_CONSISTENCY_CHECKS), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-checkmempool=<n>", strprintf("Run mempool consistency checks every <n> transactions. Use 0 to disable. (default: %u, regtest: %u)", defaultChainParams->DefaultConsistencyChecks(), regtestChainParams->DefaultConsistencyChecks()), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     // Checkpoints were removed. We keep `-checkpoints` as a hidden arg to display a more user friendly error when set.
@@ -646,6 +675,8 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-limitdescendantsize=<n>", strprintf("Do not accept transactions if any ancestor would have more than <n> kilobytes of in-mempool descendants (default: %u).", DEFAULT_DESCENDANT_SIZE_LIMIT_KVB), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-test=<option>", "Pass a test-only option. Options include : " + Join(TEST_OPTIONS_DOC, ", ") + ".", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-capturemessages", "Capture all P2P messages to disk", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
+    argsman.AddArg("-notificationthreads=<n>", strprintf("Number of threads delivering validation notifications to their subscribers (1 to %d, default: %d)", MAX_NOTIFICATION_THREADS, DEFAULT_NOTIFICATION_THREADS), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
+    argsman.AddArg("-perfcounters", "Collect timing histograms of hot code paths, see the getperfcounters RPC (default: 0)", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-mocktime=<n>", "Replace actual time with " + UNIX_EPOCH_TIME + " (default: 0)", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-maxsigcachesize=<n>", strprintf("Limit sum of signature cache and script execution cache sizes to <n> MiB (default: %u)", DEFAULT_VALIDATION_CACHE_BYTES >> 20), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-maxtipage=<n>",
@@ -1442,7 +1473,9 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
                 LogError("Failed to send shutdown signal after disk space check\n");
             }
         }
-    }, std::chrono::minutes{5});
+    }, std::chrono::minutes{5}, CScheduler::Priority::LOW);
+
+    perf::SetEnabled(args.GetBoolArg("-perfcounters", false));
 
     if (args.GetBoolArg("-logratelimit", BCLog::DEFAULT_LOGRATELIMIT)) {
         LogInstance().SetRateLimiting(BCLog::LogRateLimiter::Create(
@@ -1453,8 +1486,24 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         LogInfo("Log rate limiting disabled");
     }
 
+    // Notifications must not queue up behind background maintenance tasks, so
+    // they are delivered by a scheduler of their own. Each subscriber gets its
+    // own queue, so e.g. ZMQ does not wait for the wallets to process a block.
+    // Only SerialTaskRunners use this scheduler, which makes it safe to
+    // service it with several threads.
+    assert(!node.notification_scheduler);
+    node.notification_scheduler = std::make_unique<CScheduler>();
+    auto& notification_scheduler = *node.notification_scheduler;
+    notification_scheduler.m_service_thread = std::thread(util::TraceThread, "notify", [&] { notification_scheduler.serviceQueue(); });
+    const int notification_threads{std::clamp<int>(args.GetIntArg("-notificationthreads", DEFAULT_NOTIFICATION_THREADS), 1, MAX_NOTIFICATION_THREADS)};
+    for (int n = 1; n < notification_threads; ++n) {
+        notification_scheduler.m_worker_threads.emplace_back(util::TraceThread, strprintf("notify.%d", n), [&] { notification_scheduler.serviceQueue(); });
+    }
+
     assert(!node.validation_signals);
-    node.validation_signals = std::make_unique<ValidationSignals>(std::make_unique<SerialTaskRunner>(scheduler));
+    node.validation_signals = std::make_unique<ValidationSignals>(
+        std::make_unique<SerialTaskRunner>(notification_scheduler, CScheduler::Priority::HIGH),
+        [&notification_scheduler] { return std::make_unique<SerialTaskRunner>(notification_scheduler, CScheduler::Priority::HIGH); });
     auto& validation_signals = *node.validation_signals;
 
     // Create client interfaces for wallets that are supposed to be loaded
@@ -1601,7 +1650,7 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
 
         // Flush estimates to disk periodically
         CBlockPolicyEstimator* fee_estimator = node.fee_estimator.get();
-        scheduler.scheduleEvery([fee_estimator] { fee_estimator->FlushFeeEstimates(); }, FEE_FLUSH_INTERVAL);
+        scheduler.scheduleEvery([fee_estimator] { fee_estimator->FlushFeeEstimates(); }, FEE_FLUSH_INTERVAL, CScheduler::Priority::LOW);
         validation_signals.RegisterValidationInterface(fee_estimator);
     }
 
@@ -1971,6 +2020,11 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
             chainman.GetNotifications().fatalError(err_str);
             return;
         }
+        // Warm up the UTXO cache with the coins it held before the last shutdown
+        if (ShouldPersistCoinsCache(args)) {
+            LoadCoinsCache(chainman.ActiveChainstate(), CoinsCachePath(args));
+        }
+        node.coins_cache_load_tried = !chainman.m_interrupt;
         // Load mempool from disk
         if (auto* pool{chainman.ActiveChainstate().GetMempool()}) {
             LoadMempool(*pool, ShouldPersistMempool(args) ? MempoolPath(args) : fs::path{}, chainman.ActiveChainstate(), {});
@@ -2196,10 +2250,24 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     BanMan* banman = node.banman.get();
     scheduler.scheduleEvery([banman]{
         banman->DumpBanlist();
-    }, DUMP_BANS_INTERVAL);
+    }, DUMP_BANS_INTERVAL, CScheduler::Priority::LOW);
 
     if (node.peerman) node.peerman->StartScheduledTasks(scheduler);
 
+    if (chainman.m_options.check_block_index_incremental && *Assert(chainman.m_options.check_block_index)) {
+        // The full check walks the whole block index with cs_main held, so it
+        // stalls validation and the other maintenance tasks for its duration.
+        // That is accepted for this debug-only option, which trades the cost of
+        // a check after every block for a pause every few minutes. Notifications
+        // are not delayed by it, as they have a scheduler of their own.
+        scheduler.scheduleEvery([&chainman] { chainman.CheckFullBlockIndex(); }, CHECK_BLOCK_INDEX_SWEEP_INTERVAL, CScheduler::Priority::LOW);
+    }
+
+    if (args.GetBoolArg("-adaptivedbcache", DEFAULT_ADAPTIVE_DBCACHE)) {
+        auto governor{std::make_shared<CacheGovernor>(chainman, FindCgroupMemoryDir())};
+        scheduler.scheduleEvery([governor] { governor->Tick(); }, CACHE_GOVERNOR_INTERVAL, CScheduler::Priority::LOW);
+    }
+
 #if HAVE_SYSTEM
     StartupNotify(args);
 #endif
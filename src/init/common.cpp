@@ -38,6 +38,7 @@ void AddLoggingArgs(ArgsManager& argsman)
     argsman.AddArg("-logsourcelocations", strprintf("Prepend debug output with name of the originating source location (source file, line number and function name) (default: %u)", DEFAULT_LOGSOURCELOCATIONS), ArgsManager::ALLOW_ANY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-logtimemicros", strprintf("Add microsecond precision to debug timestamps (default: %u)", DEFAULT_LOGTIMEMICROS), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-loglevelalways", strprintf("Always prepend a category and level (default: %u)", DEFAULT_LOGLEVELALWAYS), ArgsManager::ALLOW_ANY, OptionsCategory::DEBUG_TEST);
+    argsman.AddArg("-logasync=<policy>", strprintf("Write the debug log file from a dedicated thread instead of the logging thread. When more than %u bytes are waiting to be written, <policy> \"drop\" discards new log lines and records how many were lost, \"block\" makes logging threads wait, \"off\" writes synchronously (default: off)", BCLog::DEFAULT_MAX_ASYNC_LOG_QUEUE), ArgsManager::ALLOW_ANY | ArgsManager::DISALLOW_NEGATION, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-logratelimit", strprintf("Apply rate limiting to unconditional logging to mitigate disk-filling attacks (default: %u)", BCLog::DEFAULT_LOGRATELIMIT), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-printtoconsole", "Send trace/debug info to console (default: 1 when no -daemon. To disable logging to file, set -nodebuglogfile)", ArgsManager::ALLOW_ANY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-shrinkdebugfile", "Shrink debug.log file on client startup (default: 1 when no -debug)", ArgsManager::ALLOW_ANY, OptionsCategory::DEBUG_TEST);
@@ -110,6 +111,14 @@ bool StartLogging(const ArgsManager& args)
             LogInstance().ShrinkDebugFile();
         }
     }
+    const std::string async_policy{args.GetArg("-logasync", "off")};
+    if (async_policy == "drop") {
+        LogInstance().m_async_policy = BCLog::AsyncLogPolicy::DROP;
+    } else if (async_policy == "block") {
+        LogInstance().m_async_policy = BCLog::AsyncLogPolicy::BLOCK;
+    } else if (async_policy != "off") {
+        return InitError(strprintf(_("Invalid -logasync value '%s'. Valid values: off, drop, block."), async_policy));
+    }
     if (!LogInstance().StartLogging()) {
             return InitError(Untranslated(strprintf("Could not open debug log file %s",
                 fs::PathToString(LogInstance().m_file_path))));
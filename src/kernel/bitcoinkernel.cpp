@@ -1,11 +1,407 @@
 // Copyright (c) 2022 The Bitcoin Core developers
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define BITCOINKERNEL_BUILD
+
+#include <kernel/bitcoinkernel.h>
+
+#include <chain.h>
+#include <consensus/amount.h>
+#include <consensus/validation.h>
+#include <kernel/caches.h>
+#include <kernel/chainparams.h>
+#include <kernel/checks.h>
+#include <kernel/context.h>
+#include <kernel/notifications_interface.h>
+#include <kernel/warning.h>
+#include <logging.h>
+#include <node/blockstorage.h>
+#include <node/chainstate.h>
+#include <primitives/block.h>
+#include <primitives/transaction.h>
+#include <script/interpreter.h>
+#include <script/script.h>
+#include <serialize.h>
+#include <streams.h>
+#include <sync.h>
+#include <util/fs.h>
+#include <util/signalinterrupt.h>
+#include <util/task_runner.h>
+#include <util/threadpool.h>
 #include <util/translation.h>
+#include <validation.h>
+#include <validationinterface.h>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <functional>
+#include <memory>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 
 // Define G_TRANSLATION_FUN symbol in libbitcoinkernel library so users of the
 // library aren't required to export this symbol
 extern const TranslateFn G_TRANSLATION_FUN{nullptr};
+
+static_assert(static_cast<unsigned int>(btck_ScriptFlags_P2SH) == SCRIPT_VERIFY_P2SH);
+static_assert(static_cast<unsigned int>(btck_ScriptFlags_DERSIG) == SCRIPT_VERIFY_DERSIG);
+static_assert(static_cast<unsigned int>(btck_ScriptFlags_NULLDUMMY) == SCRIPT_VERIFY_NULLDUMMY);
+static_assert(static_cast<unsigned int>(btck_ScriptFlags_CHECKLOCKTIMEVERIFY) == SCRIPT_VERIFY_CHECKLOCKTIMEVERIFY);
+static_assert(static_cast<unsigned int>(btck_ScriptFlags_CHECKSEQUENCEVERIFY) == SCRIPT_VERIFY_CHECKSEQUENCEVERIFY);
+static_assert(static_cast<unsigned int>(btck_ScriptFlags_WITNESS) == SCRIPT_VERIFY_WITNESS);
+static_assert(static_cast<unsigned int>(btck_ScriptFlags_TAPROOT) == SCRIPT_VERIFY_TAPROOT);
+
+struct btck_Context {
+    kernel::Context context;
+    std::unique_ptr<const CChainParams> chainparams;
+    //! Workers of btck_script_verify_batch(), shared by all its calls
+    mutable ThreadPool script_pool{"kernelverify"};
+};
+
+struct btck_Block {
+    std::shared_ptr<const CBlock> block;
+};
+
+struct btck_Transaction {
+    CTransactionRef tx;
+};
+
+struct btck_TransactionOutput {
+    CTxOut output;
+};
+
+struct btck_PrecomputedTransactionData {
+    const CTransactionRef tx;
+    PrecomputedTransactionData txdata;
+};
+
+namespace {
+
+class KernelNotifications : public kernel::Notifications
+{
+public:
+    kernel::InterruptResult blockTip(SynchronizationState, CBlockIndex&, double) override { return {}; }
+    void headerTip(SynchronizationState, int64_t, int64_t, bool) override {}
+    void progress(const bilingual_str&, int, bool) override {}
+    void warningSet(kernel::Warning, const bilingual_str& message) override
+    {
+        LogWarning("%s", message.original);
+    }
+    void warningUnset(kernel::Warning) override {}
+    void flushError(const bilingual_str& message) override
+    {
+        LogError("Error flushing block data to disk: %s", message.original);
+    }
+    void fatalError(const bilingual_str& message) override
+    {
+        LogError("Fatal error: %s", message.original);
+    }
+};
+
+template <typename T>
+bool Deserialize(const void* raw, size_t len, T&& obj)
+{
+    try {
+        DataStream stream{std::span{static_cast<const std::byte*>(raw), len}};
+        stream >> obj;
+        return stream.empty();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool VerifyInput(const btck_PrecomputedTransactionData& data, unsigned int input_index, unsigned int flags, btck_ScriptVerifyStatus* status)
+{
+    const auto set_status{[&](btck_ScriptVerifyStatus value) {
+        if (status) *status = value;
+    }};
+    if (input_index >= data.tx->vin.size()) {
+        set_status(btck_ScriptVerifyStatus_ERROR_TX_INPUT_INDEX);
+        return false;
+    }
+    if (flags & ~static_cast<unsigned int>(btck_ScriptFlags_ALL)) {
+        set_status(btck_ScriptVerifyStatus_ERROR_INVALID_FLAGS);
+        return false;
+    }
+    if ((flags & btck_ScriptFlags_WITNESS) && !(flags & btck_ScriptFlags_P2SH)) {
+        set_status(btck_ScriptVerifyStatus_ERROR_INVALID_FLAGS_COMBINATION);
+        return false;
+    }
+    const CTxIn& txin{data.tx->vin[input_index]};
+    const CTxOut& spent{data.txdata.m_spent_outputs[input_index]};
+    const bool valid{VerifyScript(txin.scriptSig, spent.scriptPubKey, &txin.scriptWitness, flags,
+                                  TransactionSignatureChecker{data.tx.get(), input_index, spent.nValue, data.txdata, MissingDataBehavior::FAIL},
+                                  nullptr)};
+    set_status(valid ? btck_ScriptVerifyStatus_OK : btck_ScriptVerifyStatus_ERROR_INVALID_SCRIPT);
+    return valid;
+}
+
+} // namespace
+
+struct btck_ChainstateManager {
+    KernelNotifications notifications;
+    ValidationSignals signals{std::make_unique<util::ImmediateTaskRunner>()};
+    util::SignalInterrupt interrupt;
+    std::unique_ptr<ChainstateManager> chainman;
+
+    ~btck_ChainstateManager()
+    {
+        if (!chainman) return;
+        signals.FlushBackgroundCallbacks();
+        LOCK(cs_main);
+        for (Chainstate* chainstate : chainman->GetAll()) {
+            if (chainstate->CanFlushToDisk()) {
+                chainstate->ForceFlushStateToDisk();
+                chainstate->ResetCoinsViews();
+            }
+        }
+    }
+};
+
+void btck_logging_disable()
+{
+    LogInstance().DisableLogging();
+}
+
+int btck_logging_set_callback(btck_LogCallback callback, void* user_data)
+{
+    if (!callback) return -1;
+    LogInstance().m_print_to_console = false;
+    LogInstance().m_print_to_file = false;
+    LogInstance().PushBackCallback([callback, user_data](const std::string& str) { callback(user_data, str.data(), str.size()); });
+    return LogInstance().StartLogging() ? 0 : -1;
+}
+
+btck_Context* btck_context_create(btck_ChainType chain_type, unsigned int script_threads)
+{
+    try {
+        auto context{std::make_unique<btck_Context>()};
+        switch (chain_type) {
+        case btck_ChainType_MAINNET: context->chainparams = CChainParams::Main(); break;
+        case btck_ChainType_TESTNET: context->chainparams = CChainParams::TestNet(); break;
+        case btck_ChainType_TESTNET_4: context->chainparams = CChainParams::TestNet4(); break;
+        case btck_ChainType_SIGNET: context->chainparams = CChainParams::SigNet({}); break;
+        case btck_ChainType_REGTEST: context->chainparams = CChainParams::RegTest({}); break;
+        }
+        if (!context->chainparams || !kernel::SanityChecks(context->context)) return nullptr;
+        context->script_pool.Start(std::max(script_threads, 1U) - 1);
+        return context.release();
+    } catch (const std::exception& e) {
+        LogError("Failed to create context: %s", e.what());
+        return nullptr;
+    }
+}
+
+void btck_context_destroy(btck_Context* context)
+{
+    delete context;
+}
+
+btck_ChainstateManager* btck_chainstate_manager_create(const btck_Context* context, const char* data_dir, size_t data_dir_len,
+                                                       int64_t dbcache_bytes, int worker_threads)
+{
+    if (!context || !data_dir) return nullptr;
+    try {
+        const fs::path abs_datadir{fs::absolute(fs::PathFromString({data_dir, data_dir_len}))};
+        fs::create_directories(abs_datadir / "blocks");
+
+        auto handle{std::make_unique<btck_ChainstateManager>()};
+        const kernel::CacheSizes cache_sizes{dbcache_bytes > 0 ? static_cast<size_t>(dbcache_bytes) : DEFAULT_KERNEL_CACHE};
+        ChainstateManager::Options chainman_opts{
+            .chainparams = *context->chainparams,
+            .datadir = abs_datadir,
+            .notifications = handle->notifications,
+            .signals = &handle->signals,
+        };
+        chainman_opts.worker_threads_num = std::max(worker_threads, 0);
+        const node::BlockManager::Options blockman_opts{
+            .chainparams = chainman_opts.chainparams,
+            .blocks_dir = abs_datadir / "blocks",
+            .notifications = chainman_opts.notifications,
+            .block_tree_db_params = DBParams{
+                .path = abs_datadir / "blocks" / "index",
+                .cache_bytes = cache_sizes.block_tree_db,
+            },
+        };
+        handle->chainman = std::make_unique<ChainstateManager>(handle->interrupt, chainman_opts, blockman_opts);
+
+        node::ChainstateLoadOptions options;
+        auto [status, error] = node::LoadChainstate(*handle->chainman, cache_sizes, options);
+        if (status == node::ChainstateLoadStatus::SUCCESS) {
+            std::tie(status, error) = node::VerifyLoadedChainstate(*handle->chainman, options);
+        }
+        if (status != node::ChainstateLoadStatus::SUCCESS) {
+            LogError("Failed to load chainstate: %s", error.original);
+            return nullptr;
+        }
+        for (Chainstate* chainstate : WITH_LOCK(::cs_main, return handle->chainman->GetAll())) {
+            BlockValidationState state;
+            if (!chainstate->ActivateBestChain(state, nullptr)) {
+                LogError("Failed to connect best block: %s", state.ToString());
+                return nullptr;
+            }
+        }
+        return handle.release();
+    } catch (const std::exception& e) {
+        LogError("Failed to create chainstate manager: %s", e.what());
+        return nullptr;
+    }
+}
+
+int btck_chainstate_manager_process_block(btck_ChainstateManager* chainman, const btck_Block* block, int* new_block)
+{
+    bool is_new{false};
+    bool accepted{false};
+    try {
+        accepted = chainman->chainman->ProcessNewBlock(block->block, /*force_processing=*/true, /*min_pow_checked=*/true, &is_new);
+    } catch (const std::exception& e) {
+        LogError("Failed to process block: %s", e.what());
+    }
+    if (new_block) *new_block = is_new ? 1 : 0;
+    return accepted ? 1 : 0;
+}
+
+int btck_chainstate_manager_import_blocks(btck_ChainstateManager* chainman, const char* const* block_file_paths,
+                                          const size_t* block_file_path_lens, size_t count)
+{
+    try {
+        std::vector<fs::path> import_paths;
+        import_paths.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            import_paths.push_back(fs::PathFromString({block_file_paths[i], block_file_path_lens[i]}));
+        }
+        node::ImportBlocks(*chainman->chainman, import_paths);
+    } catch (const std::exception& e) {
+        LogError("Failed to import blocks: %s", e.what());
+        return -1;
+    }
+    return chainman->interrupt ? -1 : 0;
+}
+
+int32_t btck_chainstate_manager_get_tip_height(const btck_ChainstateManager* chainman)
+{
+    LOCK(chainman->chainman->GetMutex());
+    return chainman->chainman->ActiveHeight();
+}
+
+void btck_chainstate_manager_destroy(btck_ChainstateManager* chainman)
+{
+    delete chainman;
+}
+
+btck_Block* btck_block_create(const void* raw_block, size_t raw_block_len)
+{
+    try {
+        auto block{std::make_shared<CBlock>()};
+        if (!Deserialize(raw_block, raw_block_len, TX_WITH_WITNESS(*block))) return nullptr;
+        return new btck_Block{std::move(block)};
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+}
+
+void btck_block_get_hash(const btck_Block* block, unsigned char* hash_out)
+{
+    const uint256 hash{block->block->GetHash()};
+    std::copy(hash.begin(), hash.end(), hash_out);
+}
+
+size_t btck_block_count_transactions(const btck_Block* block)
+{
+    return block->block->vtx.size();
+}
+
+btck_Transaction* btck_block_get_transaction_at(const btck_Block* block, size_t index)
+{
+    if (index >= block->block->vtx.size()) return nullptr;
+    try {
+        return new btck_Transaction{block->block->vtx[index]};
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+}
+
+void btck_block_destroy(btck_Block* block)
+{
+    delete block;
+}
+
+btck_Transaction* btck_transaction_create(const void* raw_transaction, size_t raw_transaction_len)
+{
+    try {
+        CMutableTransaction mtx;
+        if (!Deserialize(raw_transaction, raw_transaction_len, TX_WITH_WITNESS(mtx))) return nullptr;
+        return new btck_Transaction{MakeTransactionRef(std::move(mtx))};
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+}
+
+size_t btck_transaction_count_inputs(const btck_Transaction* transaction)
+{
+    return transaction->tx->vin.size();
+}
+
+void btck_transaction_destroy(btck_Transaction* transaction)
+{
+    delete transaction;
+}
+
+btck_TransactionOutput* btck_transaction_output_create(const unsigned char* script_pubkey, size_t script_pubkey_len, int64_t amount)
+{
+    try {
+        return new btck_TransactionOutput{CTxOut{amount, CScript(script_pubkey, script_pubkey + script_pubkey_len)}};
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+}
+
+void btck_transaction_output_destroy(btck_TransactionOutput* output)
+{
+    delete output;
+}
+
+btck_PrecomputedTransactionData* btck_precomputed_transaction_data_create(const btck_Transaction* tx_to, const btck_TransactionOutput* const* spent_outputs,
+                                                                          size_t spent_outputs_len)
+{
+    if (spent_outputs_len != tx_to->tx->vin.size()) return nullptr;
+    try {
+        std::vector<CTxOut> outputs;
+        outputs.reserve(spent_outputs_len);
+        for (size_t i = 0; i < spent_outputs_len; ++i) {
+            outputs.push_back(spent_outputs[i]->output);
+        }
+        auto data{std::make_unique<btck_PrecomputedTransactionData>(tx_to->tx)};
+        data->txdata.Init(*data->tx, std::move(outputs), /*force=*/true);
+        return data.release();
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+}
+
+void btck_precomputed_transaction_data_destroy(btck_PrecomputedTransactionData* txdata)
+{
+    delete txdata;
+}
+
+int btck_script_verify(const btck_PrecomputedTransactionData* txdata, unsigned int input_index, unsigned int flags,
+                       btck_ScriptVerifyStatus* status)
+{
+    return VerifyInput(*txdata, input_index, flags, status) ? 1 : 0;
+}
+
+int btck_script_verify_batch(const btck_Context* context, const btck_ScriptVerifyJob* jobs, size_t jobs_len, int* results)
+{
+    std::atomic<bool> all_valid{true};
+    const auto verify{[&](size_t i) {
+        const bool valid{VerifyInput(*jobs[i].txdata, jobs[i].input_index, jobs[i].flags, nullptr)};
+        if (results) results[i] = valid ? 1 : 0;
+        if (!valid) all_valid.store(false, std::memory_order_relaxed);
+    }};
+    context->script_pool.ParallelFor(jobs_len, verify);
+    return all_valid ? 1 : 0;
+}
@@ -0,0 +1,226 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_KERNEL_BITCOINKERNEL_H
+#define BITCOIN_KERNEL_BITCOINKERNEL_H
+
+#ifndef __cplusplus
+#include <stddef.h>
+#include <stdint.h>
+#else
+#include <cstddef>
+#include <cstdint>
+#endif // __cplusplus
+
+#ifndef BITCOINKERNEL_API
+#ifdef BITCOINKERNEL_BUILD
+#if defined(_WIN32)
+#define BITCOINKERNEL_API __declspec(dllexport)
+#else
+#define BITCOINKERNEL_API __attribute__((visibility("default")))
+#endif
+#else
+#if defined(_WIN32) && !defined(BITCOINKERNEL_STATIC)
+#define BITCOINKERNEL_API __declspec(dllimport)
+#else
+#define BITCOINKERNEL_API
+#endif
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/**
+ * @file bitcoinkernel.h
+ * C interface to the validation engine in libbitcoinkernel.
+ *
+ * All types are opaque and owned by the caller: every object returned by a
+ * *_create function (or a function documented to return a new object) must be
+ * released with its matching *_destroy function. Functions taking a const
+ * pointer never retain it past the call, unless stated otherwise.
+ *
+ * The interface is stable: once released, functions and types are not changed
+ * or removed incompatibly, and new functionality is added through new
+ * declarations. Enumerations may gain new values.
+ */
+
+typedef struct btck_Context btck_Context;
+typedef struct btck_ChainstateManager btck_ChainstateManager;
+typedef struct btck_Block btck_Block;
+typedef struct btck_Transaction btck_Transaction;
+typedef struct btck_TransactionOutput btck_TransactionOutput;
+typedef struct btck_PrecomputedTransactionData btck_PrecomputedTransactionData;
+
+typedef enum {
+    btck_ChainType_MAINNET = 0,
+    btck_ChainType_TESTNET,
+    btck_ChainType_TESTNET_4,
+    btck_ChainType_SIGNET,
+    btck_ChainType_REGTEST,
+} btck_ChainType;
+
+/** Script verification flags. They may be combined with a bitwise OR. */
+typedef enum {
+    btck_ScriptFlags_NONE = 0,
+    btck_ScriptFlags_P2SH = (1U << 0),
+    btck_ScriptFlags_DERSIG = (1U << 2),
+    btck_ScriptFlags_NULLDUMMY = (1U << 4),
+    btck_ScriptFlags_CHECKLOCKTIMEVERIFY = (1U << 9),
+    btck_ScriptFlags_CHECKSEQUENCEVERIFY = (1U << 10),
+    btck_ScriptFlags_WITNESS = (1U << 11),
+    btck_ScriptFlags_TAPROOT = (1U << 17),
+    btck_ScriptFlags_ALL = btck_ScriptFlags_P2SH | btck_ScriptFlags_DERSIG | btck_ScriptFlags_NULLDUMMY |
+                           btck_ScriptFlags_CHECKLOCKTIMEVERIFY | btck_ScriptFlags_CHECKSEQUENCEVERIFY |
+                           btck_ScriptFlags_WITNESS | btck_ScriptFlags_TAPROOT,
+} btck_ScriptFlags;
+
+typedef enum {
+    btck_ScriptVerifyStatus_OK = 0,
+    btck_ScriptVerifyStatus_ERROR_TX_INPUT_INDEX,
+    btck_ScriptVerifyStatus_ERROR_INVALID_FLAGS,
+    btck_ScriptVerifyStatus_ERROR_INVALID_FLAGS_COMBINATION,
+    btck_ScriptVerifyStatus_ERROR_INVALID_SCRIPT,
+} btck_ScriptVerifyStatus;
+
+/** Receives one formatted log line, which is not null-terminated. */
+typedef void (*btck_LogCallback)(void* user_data, const char* message, size_t message_len);
+
+/** One input to check in btck_script_verify_batch(). */
+typedef struct {
+    const btck_PrecomputedTransactionData* txdata;
+    unsigned int input_index;
+    unsigned int flags;
+} btck_ScriptVerifyJob;
+
+///@{ Logging. Call one of these once, before creating a context.
+/** Discard all log output. */
+BITCOINKERNEL_API void btck_logging_disable(void);
+
+/** Send log output to callback. The callback may be invoked from any thread. Returns 0 on success. */
+BITCOINKERNEL_API int btck_logging_set_callback(btck_LogCallback callback, void* user_data);
+///@}
+
+///@{ Context holding the chain parameters and library-wide state.
+/**
+ * @param[in] script_threads  Number of threads btck_script_verify_batch() runs
+ *                            on, the calling thread included. 0 is treated as 1.
+ * @return                    The context, or NULL on failure.
+ */
+BITCOINKERNEL_API btck_Context* btck_context_create(btck_ChainType chain_type, unsigned int script_threads);
+
+BITCOINKERNEL_API void btck_context_destroy(btck_Context* context);
+///@}
+
+///@{ Chainstate manager
+/**
+ * Load (or create) the block index and chainstate in data_dir and connect the
+ * best known chain. The context must outlive the returned object.
+ *
+ * @param[in] dbcache_bytes   Total database and UTXO cache, 0 for the default.
+ * @param[in] worker_threads  Number of script verification threads, in
+ *                            addition to the validation thread.
+ * @return                    The chainstate manager, or NULL on failure.
+ */
+BITCOINKERNEL_API btck_ChainstateManager* btck_chainstate_manager_create(
+    const btck_Context* context, const char* data_dir, size_t data_dir_len,
+    int64_t dbcache_bytes, int worker_threads);
+
+/**
+ * Validate a block and connect it if it extends the best chain.
+ *
+ * @param[out] new_block  Set to 1 if the block was not processed before. May be NULL.
+ * @return                1 if the block was accepted, 0 otherwise, including on
+ *                        internal errors such as running out of memory.
+ */
+BITCOINKERNEL_API int btck_chainstate_manager_process_block(
+    btck_ChainstateManager* chainman, const btck_Block* block, int* new_block);
+
+/**
+ * Import the blocks in the given blk*.dat style files, then connect the best
+ * known chain. count may be 0 to only connect the best chain. Returns 0 on
+ * success.
+ */
+BITCOINKERNEL_API int btck_chainstate_manager_import_blocks(
+    btck_ChainstateManager* chainman, const char* const* block_file_paths,
+    const size_t* block_file_path_lens, size_t count);
+
+/** Height of the active chain tip, or -1 if there is none. */
+BITCOINKERNEL_API int32_t btck_chainstate_manager_get_tip_height(const btck_ChainstateManager* chainman);
+
+/** Flush the chainstate to disk and free the chainstate manager. */
+BITCOINKERNEL_API void btck_chainstate_manager_destroy(btck_ChainstateManager* chainman);
+///@}
+
+///@{ Blocks
+/** Deserialize a block in network serialization. Returns NULL on failure. */
+BITCOINKERNEL_API btck_Block* btck_block_create(const void* raw_block, size_t raw_block_len);
+
+/** Write the 32 byte block hash, in internal byte order, to hash_out. */
+BITCOINKERNEL_API void btck_block_get_hash(const btck_Block* block, unsigned char* hash_out);
+
+BITCOINKERNEL_API size_t btck_block_count_transactions(const btck_Block* block);
+
+/** Return a new reference to the transaction at index, or NULL if out of range or on failure. */
+BITCOINKERNEL_API btck_Transaction* btck_block_get_transaction_at(const btck_Block* block, size_t index);
+
+BITCOINKERNEL_API void btck_block_destroy(btck_Block* block);
+///@}
+
+///@{ Transactions and outputs
+/** Deserialize a transaction in network serialization. Returns NULL on failure. */
+BITCOINKERNEL_API btck_Transaction* btck_transaction_create(const void* raw_transaction, size_t raw_transaction_len);
+
+BITCOINKERNEL_API size_t btck_transaction_count_inputs(const btck_Transaction* transaction);
+
+BITCOINKERNEL_API void btck_transaction_destroy(btck_Transaction* transaction);
+
+/** Create a transaction output. Returns NULL on failure. */
+BITCOINKERNEL_API btck_TransactionOutput* btck_transaction_output_create(
+    const unsigned char* script_pubkey, size_t script_pubkey_len, int64_t amount);
+
+BITCOINKERNEL_API void btck_transaction_output_destroy(btck_TransactionOutput* output);
+///@}
+
+///@{ Script verification
+/**
+ * Compute the signature hash data shared by all inputs of a transaction.
+ *
+ * spent_outputs[i] is the output spent by input i; spent_outputs_len must
+ * equal the number of inputs. The transaction and outputs are copied.
+ * Returns NULL if the lengths do not match or on failure.
+ */
+BITCOINKERNEL_API btck_PrecomputedTransactionData* btck_precomputed_transaction_data_create(
+    const btck_Transaction* tx_to, const btck_TransactionOutput* const* spent_outputs, size_t spent_outputs_len);
+
+BITCOINKERNEL_API void btck_precomputed_transaction_data_destroy(btck_PrecomputedTransactionData* txdata);
+
+/**
+ * Verify that input input_index of the transaction correctly spends its
+ * spent output under flags.
+ *
+ * @param[out] status  Reason for failure other than an invalid script. May be NULL.
+ * @return             1 if the input is valid, 0 otherwise.
+ */
+BITCOINKERNEL_API int btck_script_verify(
+    const btck_PrecomputedTransactionData* txdata, unsigned int input_index, unsigned int flags,
+    btck_ScriptVerifyStatus* status);
+
+/**
+ * Verify many inputs, possibly of different transactions, on the script
+ * threads of context. May be called concurrently with the same context.
+ *
+ * @param[out] results  Per job result as in btck_script_verify(). May be NULL.
+ * @return              1 if all jobs are valid, 0 otherwise.
+ */
+BITCOINKERNEL_API int btck_script_verify_batch(
+    const btck_Context* context, const btck_ScriptVerifyJob* jobs, size_t jobs_len, int* results);
+///@}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif // __cplusplus
+
+#endif // BITCOIN_KERNEL_BITCOINKERNEL_H
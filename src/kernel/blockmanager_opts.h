@@ -16,6 +16,7 @@ class CChainParams;
 namespace kernel {
 
 static constexpr bool DEFAULT_XOR_BLOCKSDIR{true};
+static constexpr bool DEFAULT_PRUNE_PUNCH_HOLES{false};
 
 /**
  * An options struct for `BlockManager`, more ergonomically referred to as
@@ -26,6 +27,8 @@ struct BlockManagerOpts {
     bool use_xor{DEFAULT_XOR_BLOCKSDIR};
     uint64_t prune_target{0};
     bool fast_prune{false};
+    //! Free the space of pruned blocks inside block files that are still needed, where the file system supports it
+    bool prune_punch_holes{DEFAULT_PRUNE_PUNCH_HOLES};
     const fs::path blocks_dir;
     Notifications& notifications;
     DBParams block_tree_db_params;
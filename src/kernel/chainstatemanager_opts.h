@@ -25,6 +25,8 @@ static constexpr auto DEFAULT_MAX_TIP_AGE{24h};
 
 namespace kernel {
 
+static constexpr bool DEFAULT_CHECK_BLOCK_INDEX_INCREMENTAL{false};
+
 /**
  * An options struct for `ChainstateManager`, more ergonomically referred to as
  * `ChainstateManager::Options` due to the using-declaration in
@@ -34,6 +36,8 @@ struct ChainstateManagerOpts {
     const CChainParams& chainparams;
     fs::path datadir;
     std::optional<int32_t> check_block_index{};
+    //! Only check the block index entries that changed since the previous check, see ChainstateManager::CheckChangedBlockIndex().
+    bool check_block_index_incremental{DEFAULT_CHECK_BLOCK_INDEX_INCREMENTAL};
     //! If set, it will override the minimum work we will assume exists on some valid chain.
     std::optional<arith_uint256> minimum_chain_work{};
     //! If set, it will override the block hash whose ancestors we will assume to have valid scripts without checking them.
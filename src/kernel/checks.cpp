@@ -4,6 +4,7 @@
 
 #include <kernel/checks.h>
 
+#include <crypto/siphash.h>
 #include <random.h>
 #include <util/result.h>
 #include <util/translation.h>
@@ -18,6 +19,10 @@ util::Result<void> SanityChecks(const Context&)
         return util::Error{Untranslated("OS cryptographic RNG sanity check failure. Aborting.")};
     }
 
+    if (!SipHash_SelfTest()) {
+        return util::Error{Untranslated("SipHash self-test failure. Aborting.")};
+    }
+
     return {};
 }
 
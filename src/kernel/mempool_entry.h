@@ -11,6 +11,7 @@
 #include <policy/policy.h>
 #include <policy/settings.h>
 #include <primitives/transaction.h>
+#include <script/interpreter.h>
 #include <util/epochguard.h>
 #include <util/overflow.h>
 
@@ -64,6 +65,14 @@ struct CompareIteratorByHash {
 
 class CTxMemPoolEntry
 {
+    static size_t PrecomputedTxDataUsage(const std::shared_ptr<PrecomputedTransactionData>& txdata)
+    {
+        if (!txdata) return 0;
+        size_t mem{memusage::DynamicUsage(txdata) + memusage::DynamicUsage(txdata->m_spent_outputs)};
+        for (const CTxOut& out : txdata->m_spent_outputs) mem += RecursiveDynamicUsage(out);
+        return mem;
+    }
+
 public:
     typedef std::reference_wrapper<const CTxMemPoolEntry> CTxMemPoolEntryRef;
     // two aliases, should the types ever diverge
@@ -89,6 +98,8 @@ private:
     const int64_t sigOpCost;        //!< Total sigop cost
     CAmount m_modified_fee;         //!< Used for determining the priority of the transaction for mining in a block
     mutable LockPoints lockPoints;  //!< Track the height and time at which tx was final
+    //! Sighash midstates computed during mempool acceptance, handed on to block validation
+    const std::shared_ptr<PrecomputedTransactionData> m_precomputed_txdata;
 
     // Information about descendants of this transaction that are in the
     // mempool; if we remove this transaction we must remove all of these
@@ -109,11 +120,12 @@ public:
     CTxMemPoolEntry(const CTransactionRef& tx, CAmount fee,
                     int64_t time, unsigned int entry_height, uint64_t entry_sequence,
                     bool spends_coinbase,
-                    int64_t sigops_cost, LockPoints lp)
+                    int64_t sigops_cost, LockPoints lp,
+                    std::shared_ptr<PrecomputedTransactionData> txdata = nullptr)
         : tx{tx},
           nFee{fee},
           nTxWeight{GetTransactionWeight(*tx)},
-          nUsageSize{RecursiveDynamicUsage(tx)},
+          nUsageSize{RecursiveDynamicUsage(tx) + PrecomputedTxDataUsage(txdata)},
           nTime{time},
           entry_sequence{entry_sequence},
           entryHeight{entry_height},
@@ -121,6 +133,7 @@ public:
           sigOpCost{sigops_cost},
           m_modified_fee{nFee},
           lockPoints{lp},
+          m_precomputed_txdata{std::move(txdata)},
           nSizeWithDescendants{GetTxSize()},
           nModFeesWithDescendants{nFee},
           nSizeWithAncestors{GetTxSize()},
@@ -149,6 +162,7 @@ public:
     CAmount GetModifiedFee() const { return m_modified_fee; }
     size_t DynamicMemoryUsage() const { return nUsageSize; }
     const LockPoints& GetLockPoints() const { return lockPoints; }
+    const std::shared_ptr<PrecomputedTransactionData>& GetPrecomputedTxData() const { return m_precomputed_txdata; }
 
     // Adjusts the descendant state.
     void UpdateDescendantState(int32_t modifySize, CAmount modifyFee, int64_t modifyCount);
@@ -365,6 +365,42 @@ bool CExtKey::Derive(CExtKey &out, unsigned int _nChild) const {
     return key.Derive(out.key, out.chaincode, _nChild, chaincode);
 }
 
+bool CExtKey::Derive(std::span<const unsigned int> children, std::vector<CExtKey>& out) const {
+    if (nDepth == std::numeric_limits<unsigned char>::max()) return false;
+    assert(key.IsValid());
+    assert(key.IsCompressed());
+    assert(key.size() == 32);
+    for (const unsigned int child : children) assert((child >> 31) == 1);
+    // The HMAC messages hold the private key, so keep them in secure memory.
+    std::vector<unsigned char, secure_allocator<unsigned char>> messages(children.size() * 37);
+    std::vector<std::span<const unsigned char>> inputs;
+    inputs.reserve(children.size());
+    for (size_t i = 0; i < children.size(); ++i) {
+        unsigned char* msg = messages.data() + i * 37;
+        msg[0] = 0;
+        memcpy(msg + 1, UCharCast(key.begin()), 32);
+        WriteBE32(msg + 33, children[i]);
+        inputs.emplace_back(msg, 37);
+    }
+    std::vector<unsigned char, secure_allocator<unsigned char>> hashes(children.size() * 64);
+    CHMAC_SHA512(chaincode.begin(), chaincode.size()).FinalizeMulti(inputs, hashes.data());
+    const CKeyID id = key.GetPubKey().GetID();
+    out.reserve(out.size() + children.size());
+    for (size_t i = 0; i < children.size(); ++i) {
+        CExtKey& child = out.emplace_back();
+        child.nDepth = nDepth + 1;
+        memcpy(child.vchFingerprint, &id, 4);
+        child.nChild = children[i];
+        memcpy(child.chaincode.begin(), hashes.data() + i * 64 + 32, 32);
+        child.key.Set(key.begin(), key.end(), true);
+        if (!secp256k1_ec_seckey_tweak_add(secp256k1_context_sign, (unsigned char*)child.key.begin(), hashes.data() + i * 64)) {
+            out.pop_back();
+            return false;
+        }
+    }
+    return true;
+}
+
 void CExtKey::SetSeed(std::span<const std::byte> seed)
 {
     static const unsigned char hashkey[] = {'B','i','t','c','o','i','n',' ','s','e','e','d'};
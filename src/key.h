@@ -12,6 +12,7 @@
 #include <support/allocators/secure.h>
 #include <uint256.h>
 
+#include <span>
 #include <stdexcept>
 #include <vector>
 
@@ -249,6 +250,8 @@ struct CExtKey {
     void Encode(unsigned char code[BIP32_EXTKEY_SIZE]) const;
     void Decode(const unsigned char code[BIP32_EXTKEY_SIZE]);
     [[nodiscard]] bool Derive(CExtKey& out, unsigned int nChild) const;
+    //! Derive several hardened children at once, appending them to out.
+    [[nodiscard]] bool Derive(std::span<const unsigned int> children, std::vector<CExtKey>& out) const;
     CExtPubKey Neuter() const;
     void SetSeed(std::span<const std::byte> seed);
 };
@@ -92,11 +92,99 @@ bool BCLog::Logger::StartLogging()
     m_cur_buffer_memusage = 0;
     if (m_print_to_console) fflush(stdout);
 
+    if (m_print_to_file && m_async_policy != AsyncLogPolicy::OFF) {
+        // Hand the file over to the writer thread so callers no longer block on
+        // disk I/O while holding m_cs.
+        m_async_fileout = std::exchange(m_fileout, nullptr);
+        {
+            StdLockGuard async_lock(m_async_mutex);
+            m_async_stop = false;
+        }
+        m_async_active = true;
+        m_async_thread = std::thread([this] {
+            util::ThreadRename("logwriter");
+            AsyncWriterThread();
+        });
+    }
+
     return true;
 }
 
+void BCLog::Logger::StopAsyncWriter()
+{
+    StdLockGuard scoped_lock(m_cs);
+    if (!m_async_active) return;
+    // The writer thread never takes m_cs, so it can drain the queue while we
+    // hold it and no new lines can be queued in the meantime.
+    {
+        StdLockGuard async_lock(m_async_mutex);
+        m_async_stop = true;
+    }
+    m_async_cv.notify_one();
+    m_async_thread.join();
+    m_fileout = std::exchange(m_async_fileout, nullptr);
+    m_async_active = false;
+}
+
+void BCLog::Logger::PushAsync(std::string&& str)
+{
+    {
+        StdLockGuard scoped_lock(m_async_mutex);
+        if (m_async_queue_bytes + str.size() > m_max_async_queue && !m_async_queue.empty()) {
+            if (m_async_policy == AsyncLogPolicy::DROP) {
+                ++m_async_lines_dropped;
+                return;
+            }
+            m_async_space_cv.wait(m_async_mutex, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_async_mutex) { return m_async_queue.empty(); });
+        }
+        m_async_queue_bytes += str.size();
+        m_async_queue.push_back(std::move(str));
+    }
+    m_async_cv.notify_one();
+}
+
+void BCLog::Logger::AsyncWriterThread()
+{
+    std::vector<std::string> batch;
+    std::string out;
+    while (true) {
+        size_t dropped;
+        {
+            StdLockGuard scoped_lock(m_async_mutex);
+            m_async_cv.wait(m_async_mutex, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_async_mutex) { return m_async_stop || !m_async_queue.empty() || m_async_lines_dropped > 0; });
+            if (m_async_queue.empty() && m_async_lines_dropped == 0) return;
+            batch.swap(m_async_queue);
+            m_async_queue_bytes = 0;
+            dropped = std::exchange(m_async_lines_dropped, 0);
+        }
+        m_async_space_cv.notify_all();
+
+        out.clear();
+        for (const std::string& line : batch) out += line;
+        batch.clear();
+        if (dropped > 0) {
+            std::string note{strprintf("Log writer could not keep up, %d log lines discarded.\n", dropped)};
+            FormatLogStrInPlace(note, BCLog::ALL, Level::Warning, std::source_location::current(), util::ThreadGetInternalName(), SystemClock::now(), GetMockTime());
+            out += note;
+        }
+
+        // reopen the log file, if requested
+        if (m_reopen_file.exchange(false)) {
+            FILE* new_fileout = fsbridge::fopen(m_file_path, "a");
+            if (new_fileout) {
+                setbuf(new_fileout, nullptr); // unbuffered
+                fclose(m_async_fileout);
+                m_async_fileout = new_fileout;
+            }
+        }
+        // One write for the whole batch instead of one per line.
+        FileWriteStr(out, m_async_fileout);
+    }
+}
+
 void BCLog::Logger::DisconnectTestLogger()
 {
+    StopAsyncWriter();
     StdLockGuard scoped_lock(m_cs);
     m_buffering = true;
     if (m_fileout != nullptr) fclose(m_fileout);
@@ -493,7 +581,9 @@ void BCLog::Logger::LogPrintStr_(std::string_view str, std::source_location&& so
     for (const auto& cb : m_print_callbacks) {
         cb(str_prefixed);
     }
-    if (m_print_to_file && !ratelimit) {
+    if (m_print_to_file && !ratelimit && m_async_active) {
+        PushAsync(std::move(str_prefixed));
+    } else if (m_print_to_file && !ratelimit) {
         assert(m_fileout != nullptr);
 
         // reopen the log file, if requested
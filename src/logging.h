@@ -14,6 +14,7 @@
 #include <util/time.h>
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <cstring>
 #include <functional>
@@ -22,6 +23,7 @@
 #include <mutex>
 #include <source_location>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -109,6 +111,14 @@ namespace BCLog {
     constexpr uint64_t RATELIMIT_MAX_BYTES{1024 * 1024}; // maximum number of bytes per source location that can be logged within the RATELIMIT_WINDOW
     constexpr auto RATELIMIT_WINDOW{1h}; // time window after which log ratelimit stats are reset
     constexpr bool DEFAULT_LOGRATELIMIT{true};
+    constexpr size_t DEFAULT_MAX_ASYNC_LOG_QUEUE{4'000'000}; // queue up to 4MB of log data for the async writer thread
+
+    //! What to do with a log line when the async writer thread cannot keep up.
+    enum class AsyncLogPolicy {
+        OFF,   //!< Write to the log file synchronously on the calling thread
+        DROP,  //!< Discard the line and note the number of dropped lines in the log
+        BLOCK, //!< Wait until the writer thread made room in the queue
+    };
 
     //! Fixed window rate limiter for logging.
     class LogRateLimiter
@@ -205,6 +215,28 @@ namespace BCLog {
         /** Log categories bitfield. */
         std::atomic<CategoryMask> m_categories{BCLog::NONE};
 
+        //! Protects the queue handed to the async writer thread. Never acquired
+        //! before m_cs by the writer thread, so callers may hold m_cs.
+        mutable StdMutex m_async_mutex;
+        //! Wakes the writer thread when lines are queued or it should stop.
+        std::condition_variable_any m_async_cv;
+        //! Wakes callers blocked by AsyncLogPolicy::BLOCK once the queue was drained.
+        std::condition_variable_any m_async_space_cv;
+        std::vector<std::string> m_async_queue GUARDED_BY(m_async_mutex);
+        size_t m_async_queue_bytes GUARDED_BY(m_async_mutex){0};
+        size_t m_async_lines_dropped GUARDED_BY(m_async_mutex){0};
+        bool m_async_stop GUARDED_BY(m_async_mutex){false};
+        //! Whether file output currently goes through the writer thread.
+        bool m_async_active GUARDED_BY(m_cs){false};
+        //! Log file owned by the writer thread while it runs; m_fileout is
+        //! nullptr during that time.
+        FILE* m_async_fileout{nullptr};
+        std::thread m_async_thread;
+
+        /** Queue a formatted line for the writer thread, applying m_async_policy. */
+        void PushAsync(std::string&& str) EXCLUSIVE_LOCKS_REQUIRED(m_cs, !m_async_mutex);
+        void AsyncWriterThread() EXCLUSIVE_LOCKS_REQUIRED(!m_async_mutex);
+
         void FormatLogStrInPlace(std::string& str, LogFlags category, Level level, const std::source_location& source_loc, std::string_view threadname, SystemClock::time_point now, std::chrono::seconds mocktime) const;
 
         std::string LogTimestampStr(SystemClock::time_point now, std::chrono::seconds mocktime) const;
@@ -214,7 +246,7 @@ namespace BCLog {
 
         /** Send a string to the log output (internal) */
         void LogPrintStr_(std::string_view str, std::source_location&& source_loc, BCLog::LogFlags category, BCLog::Level level, bool should_ratelimit)
-            EXCLUSIVE_LOCKS_REQUIRED(m_cs);
+            EXCLUSIVE_LOCKS_REQUIRED(m_cs, !m_async_mutex);
 
         std::string GetLogPrefix(LogFlags category, Level level) const;
 
@@ -231,9 +263,13 @@ namespace BCLog {
         fs::path m_file_path;
         std::atomic<bool> m_reopen_file{false};
 
+        //! Write the log file from a dedicated thread, see StartLogging(). Must be set before StartLogging().
+        AsyncLogPolicy m_async_policy{AsyncLogPolicy::OFF};
+        size_t m_max_async_queue{DEFAULT_MAX_ASYNC_LOG_QUEUE};
+
         /** Send a string to the log output */
         void LogPrintStr(std::string_view str, std::source_location&& source_loc, BCLog::LogFlags category, BCLog::Level level, bool should_ratelimit)
-            EXCLUSIVE_LOCKS_REQUIRED(!m_cs);
+            EXCLUSIVE_LOCKS_REQUIRED(!m_cs, !m_async_mutex);
 
         /** Returns whether logs will be written to any output */
         bool Enabled() const EXCLUSIVE_LOCKS_REQUIRED(!m_cs)
@@ -258,9 +294,15 @@ namespace BCLog {
         }
 
         /** Start logging (and flush all buffered messages) */
-        bool StartLogging() EXCLUSIVE_LOCKS_REQUIRED(!m_cs);
+        bool StartLogging() EXCLUSIVE_LOCKS_REQUIRED(!m_cs, !m_async_mutex);
         /** Only for testing */
-        void DisconnectTestLogger() EXCLUSIVE_LOCKS_REQUIRED(!m_cs);
+        void DisconnectTestLogger() EXCLUSIVE_LOCKS_REQUIRED(!m_cs, !m_async_mutex);
+        /**
+         * Write out all lines queued for the async writer thread and join it.
+         * Later log lines are written to the file synchronously. No-op when the
+         * writer thread is not running.
+         */
+        void StopAsyncWriter() EXCLUSIVE_LOCKS_REQUIRED(!m_cs, !m_async_mutex);
 
         void SetRateLimiting(std::shared_ptr<LogRateLimiter> limiter) EXCLUSIVE_LOCKS_REQUIRED(!m_cs)
         {
@@ -274,7 +316,7 @@ namespace BCLog {
          * Mostly intended for libbitcoin-kernel apps that don't want any logging.
          * Should be used instead of StartLogging().
          */
-        void DisableLogging() EXCLUSIVE_LOCKS_REQUIRED(!m_cs);
+        void DisableLogging() EXCLUSIVE_LOCKS_REQUIRED(!m_cs, !m_async_mutex);
 
         void ShrinkDebugFile();
 
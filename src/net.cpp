@@ -3391,7 +3391,7 @@ bool CConnman::Start(CScheduler& scheduler, const Options& connOptions)
     }
 
     // Dump network addresses
-    scheduler.scheduleEvery([this] { DumpAddresses(); }, DUMP_PEERS_INTERVAL);
+    scheduler.scheduleEvery([this] { DumpAddresses(); }, DUMP_PEERS_INTERVAL, CScheduler::Priority::LOW);
 
     // Run the ASMap Health check once and then schedule it to run every 24h.
     if (m_netgroupman.UsingASMap()) {
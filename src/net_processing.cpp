@@ -13,6 +13,7 @@
 #include <chain.h>
 #include <chainparams.h>
 #include <common/bloom.h>
+#include <common/system.h>
 #include <consensus/amount.h>
 #include <consensus/params.h>
 #include <consensus/validation.h>
@@ -42,6 +43,7 @@
 #include <policy/fees.h>
 #include <policy/packages.h>
 #include <policy/policy.h>
+#include <pow.h>
 #include <primitives/block.h>
 #include <primitives/transaction.h>
 #include <protocol.h>
@@ -49,6 +51,7 @@
 #include <scheduler.h>
 #include <script/script.h>
 #include <serialize.h>
+#include <signet.h>
 #include <signetpsbt.h>
 #include <span.h>
 #include <streams.h>
@@ -57,7 +60,9 @@
 #include <txmempool.h>
 #include <uint256.h>
 #include <util/check.h>
+#include <util/perfcounters.h>
 #include <util/strencodings.h>
+#include <util/threadpool.h>
 #include <util/time.h>
 #include <util/trace.h>
 #include <validation.h>
@@ -97,6 +102,8 @@ static constexpr auto HEADERS_DOWNLOAD_TIMEOUT_BASE = 15min;
 static constexpr auto HEADERS_DOWNLOAD_TIMEOUT_PER_HEADER = 1ms;
 /** How long to wait for a peer to respond to a getheaders request */
 static constexpr auto HEADERS_RESPONSE_TIME{2min};
+/** Maximum number of threads, besides the message handler, hashing received headers. */
+static constexpr int MAX_HEADERS_HASH_WORKERS{3};
 /** Protect at least this many outbound peers from disconnection due to slow/
  * behind headers chain.
  */
@@ -149,6 +156,8 @@ static constexpr double BLOCK_DOWNLOAD_TIMEOUT_BASE = 1;
 static constexpr double BLOCK_DOWNLOAD_TIMEOUT_PER_PEER = 0.5;
 /** Maximum number of headers to announce when relaying blocks with headers message.*/
 static const unsigned int MAX_BLOCKS_TO_ANNOUNCE = 8;
+/** Number of blocks whose signet solution proof was found valid to remember, so it is not checked again. */
+static constexpr unsigned int MAX_SIGNET_PROOFS_VERIFIED{1000};
 /** Minimum blocks required to signal NODE_NETWORK_LIMITED */
 static const unsigned int NODE_NETWORK_LIMITED_MIN_BLOCKS = 288;
 /** Window, in blocks, for connecting to NODE_NETWORK_LIMITED peers */
@@ -456,6 +465,10 @@ struct CNodeState {
     bool m_requested_hb_cmpctblocks{false};
     /** Whether this peer will send us cmpctblocks if we request them. */
     bool m_provides_cmpctblocks{false};
+    /** Whether this peer wants a signetproof ahead of our block announcements. */
+    bool m_wants_signet_proofs{false};
+    /** The block of the last signetproof we sent this peer. */
+    uint256 m_last_signet_proof_sent{};
 
     /** State used to enforce CHAIN_SYNC_TIMEOUT and EXTRA_PEER_CHECK_INTERVAL logic.
       *
@@ -644,8 +657,9 @@ private:
                                bool via_compact_block)
         EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex, !m_headers_presync_mutex, g_msgproc_mutex);
     /** Various helpers for headers processing, invoked by ProcessHeadersMessage() */
-    /** Return true if headers are continuous and have valid proof-of-work (DoS points assigned on failure) */
-    bool CheckHeadersPoW(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, Peer& peer);
+    /** Return true if headers are continuous and have valid proof-of-work (DoS points assigned on failure).
+     *  The header hashes are returned in hashes. */
+    bool CheckHeadersPoW(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, Peer& peer, std::vector<uint256>& hashes);
     /** Calculate an anti-DoS work threshold for headers chains */
     arith_uint256 GetAntiDoSWorkThreshold();
     /** Deal with state tracking and headers sync for peers that send
@@ -653,7 +667,7 @@ private:
      * announcements for blocks interacting with the 2hr (MAX_FUTURE_BLOCK_TIME) rule). */
     void HandleUnconnectingHeaders(CNode& pfrom, Peer& peer, const std::vector<CBlockHeader>& headers) EXCLUSIVE_LOCKS_REQUIRED(g_msgproc_mutex);
     /** Return true if the headers connect to each other, false otherwise */
-    bool CheckHeadersAreContinuous(const std::vector<CBlockHeader>& headers) const;
+    bool CheckHeadersAreContinuous(const std::vector<CBlockHeader>& headers, std::span<const uint256> hashes) const;
     /** Try to continue a low-work headers sync that has already begun.
      * Assumes the caller has already verified the headers connect, and has
      * checked that each header satisfies the proof-of-work target included in
@@ -661,6 +675,7 @@ private:
      *  @param[in]  peer                            The peer we're syncing with.
      *  @param[in]  pfrom                           CNode of the peer
      *  @param[in,out] headers                      The headers to be processed.
+     *  @param[in]  hashes                          The hashes of headers, or empty.
      *  @return     True if the passed in headers were successfully processed
      *              as the continuation of a low-work headers sync in progress;
      *              false otherwise.
@@ -673,7 +688,7 @@ private:
      *              acceptance by the caller).
      */
     bool IsContinuationOfLowWorkHeadersSync(Peer& peer, CNode& pfrom,
-            std::vector<CBlockHeader>& headers)
+            std::vector<CBlockHeader>& headers, std::span<const uint256> hashes)
         EXCLUSIVE_LOCKS_REQUIRED(peer.m_headers_sync_mutex, !m_headers_presync_mutex, g_msgproc_mutex);
     /** Check work on a headers chain to be processed, and if insufficient,
      * initiate our anti-DoS headers sync mechanism.
@@ -682,13 +697,15 @@ private:
      * @param[in]   pfrom               CNode of the peer
      * @param[in]   chain_start_header  Where these headers connect in our index.
      * @param[in,out]   headers             The headers to be processed.
+     * @param[in]   hashes              The hashes of headers, or empty.
      *
      * @return      True if chain was low work (headers will be empty after
      *              calling); false otherwise.
      */
     bool TryLowWorkHeadersSync(Peer& peer, CNode& pfrom,
                                   const CBlockIndex* chain_start_header,
-                                  std::vector<CBlockHeader>& headers)
+                                  std::vector<CBlockHeader>& headers,
+                                  std::span<const uint256> hashes)
         EXCLUSIVE_LOCKS_REQUIRED(!peer.m_headers_sync_mutex, !m_peer_mutex, !m_headers_presync_mutex, g_msgproc_mutex);
 
     /** Return true if the given header is an ancestor of
@@ -852,6 +869,22 @@ private:
     std::shared_ptr<const CBlockHeaderAndShortTxIDs> m_most_recent_compact_block GUARDED_BY(m_most_recent_block_mutex);
     uint256 m_most_recent_block_hash GUARDED_BY(m_most_recent_block_mutex);
     std::unique_ptr<const std::map<GenTxid, CTransactionRef>> m_most_recent_block_txs GUARDED_BY(m_most_recent_block_mutex);
+    //! Only set on signet with -signetproofrelay.
+    std::shared_ptr<const SignetSolutionProof> m_most_recent_signet_proof GUARDED_BY(m_most_recent_block_mutex);
+
+    /** Blocks whose signet solution proof was found valid, as every peer
+     *  sends the proof of a new block. A false positive only skips the early
+     *  check: the solution is still checked when the block is received. */
+    CRollingBloomFilter m_signet_proofs_verified GUARDED_BY(cs_main){MAX_SIGNET_PROOFS_VERIFIED, 0.000'001};
+
+    /** Send the signet solution proof of block hash to a peer that asked for
+     *  proofs, if it is the most recent block and was not sent already. */
+    void MaybePushSignetProof(CNode& node, CNodeState& state, const uint256& hash)
+        EXCLUSIVE_LOCKS_REQUIRED(cs_main, !m_most_recent_block_mutex);
+
+    /** Check the signet solution of a block announced with a signetproof message. */
+    void ProcessSignetProof(Peer& peer, const SignetSolutionProof& proof)
+        EXCLUSIVE_LOCKS_REQUIRED(!cs_main);
 
     // Data about the low-work headers synchronization, aggregated from all peers' HeadersSyncStates.
     /** Mutex guarding the other m_headers_presync_* variables. */
@@ -870,6 +903,9 @@ private:
     NodeId m_headers_presync_bestpeer GUARDED_BY(m_headers_presync_mutex) {-1};
     /** The m_headers_presync_stats improved, and needs signalling. */
     std::atomic_bool m_headers_presync_should_signal{false};
+    /** Workers helping the message handler hash received headers, which is
+     *  most of the cost of a headers message on a low-difficulty chain. */
+    ThreadPool m_headers_hash_pool{"headershash"};
 
     /** Height of the highest block announced using BIP 152 high-bandwidth mode. */
     int m_highest_fast_announce GUARDED_BY(::cs_main){0};
@@ -1903,6 +1939,7 @@ PeerManagerImpl::PeerManagerImpl(CConnman& connman, AddrMan& addrman,
     if (opts.reconcile_txs) {
         m_txreconciliation = std::make_unique<TxReconciliationTracker>(TXRECONCILIATION_VERSION);
     }
+    m_headers_hash_pool.Start(std::clamp(GetNumCores() - 1, 0, MAX_HEADERS_HASH_WORKERS));
 }
 
 void PeerManagerImpl::StartScheduledTasks(CScheduler& scheduler)
@@ -1982,6 +2019,10 @@ void PeerManagerImpl::BlockDisconnected(const std::shared_ptr<const CBlock> &blo
 void PeerManagerImpl::NewPoWValidBlock(const CBlockIndex *pindex, const std::shared_ptr<const CBlock>& pblock)
 {
     auto pcmpctblock = std::make_shared<const CBlockHeaderAndShortTxIDs>(*pblock, FastRandomContext().rand64());
+    std::shared_ptr<const SignetSolutionProof> signet_proof;
+    if (m_opts.signet_proof_relay && m_chainman.GetConsensus().signet_blocks) {
+        signet_proof = std::make_shared<const SignetSolutionProof>(MakeSignetSolutionProof(*pblock));
+    }
 
     LOCK(cs_main);
 
@@ -2007,6 +2048,7 @@ void PeerManagerImpl::NewPoWValidBlock(const CBlockIndex *pindex, const std::sha
         m_most_recent_block = pblock;
         m_most_recent_compact_block = pcmpctblock;
         m_most_recent_block_txs = std::move(most_recent_block_txs);
+        m_most_recent_signet_proof = std::move(signet_proof);
     }
 
     m_connman.ForEachNode([this, pindex, &lazy_ser, &hashBlock](CNode* pnode) EXCLUSIVE_LOCKS_REQUIRED(::cs_main) {
@@ -2023,6 +2065,7 @@ void PeerManagerImpl::NewPoWValidBlock(const CBlockIndex *pindex, const std::sha
             LogDebug(BCLog::NET, "%s sending header-and-ids %s to peer=%d\n", "PeerManager::NewPoWValidBlock",
                     hashBlock.ToString(), pnode->GetId());
 
+            MaybePushSignetProof(*pnode, state, hashBlock);
             const CSerializedNetMsg& ser_cmpctblock{lazy_ser.get()};
             PushMessage(*pnode, ser_cmpctblock.Copy());
             state.pindexBestHeaderSent = pindex;
@@ -2030,6 +2073,63 @@ void PeerManagerImpl::NewPoWValidBlock(const CBlockIndex *pindex, const std::sha
     });
 }
 
+void PeerManagerImpl::MaybePushSignetProof(CNode& node, CNodeState& state, const uint256& hash)
+{
+    if (!state.m_wants_signet_proofs || state.m_last_signet_proof_sent == hash) return;
+
+    std::optional<CSerializedNetMsg> proof_msg;
+    {
+        LOCK(m_most_recent_block_mutex);
+        if (m_most_recent_signet_proof && m_most_recent_block_hash == hash) {
+            proof_msg = NetMsg::Make(NetMsgType::SIGNETPROOF, *m_most_recent_signet_proof);
+        }
+    }
+    if (!proof_msg) return;
+
+    LogDebug(BCLog::NET, "%s sending signetproof %s to peer=%d\n", __func__, hash.ToString(), node.GetId());
+    PushMessage(node, std::move(*proof_msg));
+    state.m_last_signet_proof_sent = hash;
+}
+
+void PeerManagerImpl::ProcessSignetProof(Peer& peer, const SignetSolutionProof& proof)
+{
+    const uint256 hash{proof.header.GetHash()};
+    {
+        LOCK(cs_main);
+        if (m_signet_proofs_verified.contains(hash)) return;
+
+        // Only spend a signature check on blocks we could download next.
+        const CBlockIndex* prev_block{m_chainman.m_blockman.LookupBlockIndex(proof.header.hashPrevBlock)};
+        if (!prev_block || prev_block->nChainWork + CalculateClaimedHeadersWork({{proof.header}}) < GetAntiDoSWorkThreshold()) {
+            LogDebug(BCLog::NET, "Ignoring signetproof %s from peer=%d\n", hash.ToString(), peer.m_id);
+            return;
+        }
+        const CBlockIndex* pindex{m_chainman.m_blockman.LookupBlockIndex(hash)};
+        if (pindex && ((pindex->nStatus & BLOCK_HAVE_DATA) || !pindex->IsValid(BLOCK_VALID_TREE))) return;
+    }
+
+    if (!CheckProofOfWork(hash, proof.header.nBits, m_chainman.GetConsensus())) {
+        Misbehaving(peer, "signetproof with invalid proof of work");
+        return;
+    }
+    if (!CheckSignetSolutionProofCommitment(proof)) {
+        Misbehaving(peer, "signetproof coinbase not committed to by its header");
+        return;
+    }
+    if (CheckSignetSolutionProof(proof, m_chainman.GetConsensus())) {
+        WITH_LOCK(cs_main, m_signet_proofs_verified.insert(hash));
+        return;
+    }
+
+    // The solution only depends on the header and the coinbase, so the block
+    // is invalid. Marking it failed keeps it and its descendants from being
+    // downloaded or reconstructed from a compact block.
+    BlockValidationState state;
+    state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-signet-blksig", "signet block solution proof validation failure");
+    m_chainman.ProcessInvalidBlockHeader(proof.header, /*min_pow_checked=*/true, state);
+    Misbehaving(peer, strprintf("signetproof %s with invalid block solution", hash.ToString()));
+}
+
 /**
  * Update our best height and announce any block hashes which weren't previously
  * in m_chainman.ActiveChain() to our peers.
@@ -2480,16 +2580,16 @@ void PeerManagerImpl::SendBlockTransactions(CNode& pfrom, Peer& peer, const CBlo
     MakeAndPushMessage(pfrom, NetMsgType::BLOCKTXN, resp);
 }
 
-bool PeerManagerImpl::CheckHeadersPoW(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, Peer& peer)
+bool PeerManagerImpl::CheckHeadersPoW(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, Peer& peer, std::vector<uint256>& hashes)
 {
     // Do these headers have proof-of-work matching what's claimed?
-    if (!HasValidProofOfWork(headers, consensusParams)) {
+    if (!HasValidProofOfWork(headers, consensusParams, m_headers_hash_pool, hashes)) {
         Misbehaving(peer, "header with invalid proof of work");
         return false;
     }
 
     // Are these headers connected to each other?
-    if (!CheckHeadersAreContinuous(headers)) {
+    if (!CheckHeadersAreContinuous(headers, hashes)) {
         Misbehaving(peer, "non-continuous headers sequence");
         return false;
     }
@@ -2534,22 +2634,20 @@ void PeerManagerImpl::HandleUnconnectingHeaders(CNode& pfrom, Peer& peer,
     WITH_LOCK(cs_main, UpdateBlockAvailability(pfrom.GetId(), headers.back().GetHash()));
 }
 
-bool PeerManagerImpl::CheckHeadersAreContinuous(const std::vector<CBlockHeader>& headers) const
+bool PeerManagerImpl::CheckHeadersAreContinuous(const std::vector<CBlockHeader>& headers, std::span<const uint256> hashes) const
 {
-    uint256 hashLastBlock;
-    for (const CBlockHeader& header : headers) {
-        if (!hashLastBlock.IsNull() && header.hashPrevBlock != hashLastBlock) {
+    for (size_t i = 1; i < headers.size(); ++i) {
+        if (headers[i].hashPrevBlock != hashes[i - 1]) {
             return false;
         }
-        hashLastBlock = header.GetHash();
     }
     return true;
 }
 
-bool PeerManagerImpl::IsContinuationOfLowWorkHeadersSync(Peer& peer, CNode& pfrom, std::vector<CBlockHeader>& headers)
+bool PeerManagerImpl::IsContinuationOfLowWorkHeadersSync(Peer& peer, CNode& pfrom, std::vector<CBlockHeader>& headers, std::span<const uint256> hashes)
 {
     if (peer.m_headers_sync) {
-        auto result = peer.m_headers_sync->ProcessNextHeaders(headers, headers.size() == m_opts.max_headers_result);
+        auto result = peer.m_headers_sync->ProcessNextHeaders(headers, headers.size() == m_opts.max_headers_result, hashes);
         // If it is a valid continuation, we should treat the existing getheaders request as responded to.
         if (result.success) peer.m_last_getheaders_timestamp = {};
         if (result.request_more) {
@@ -2628,7 +2726,7 @@ bool PeerManagerImpl::IsContinuationOfLowWorkHeadersSync(Peer& peer, CNode& pfro
     return false;
 }
 
-bool PeerManagerImpl::TryLowWorkHeadersSync(Peer& peer, CNode& pfrom, const CBlockIndex* chain_start_header, std::vector<CBlockHeader>& headers)
+bool PeerManagerImpl::TryLowWorkHeadersSync(Peer& peer, CNode& pfrom, const CBlockIndex* chain_start_header, std::vector<CBlockHeader>& headers, std::span<const uint256> hashes)
 {
     // Calculate the claimed total work on this chain.
     arith_uint256 total_work = chain_start_header->nChainWork + CalculateClaimedHeadersWork(headers);
@@ -2660,7 +2758,7 @@ bool PeerManagerImpl::TryLowWorkHeadersSync(Peer& peer, CNode& pfrom, const CBlo
             // Now a HeadersSyncState object for tracking this synchronization
             // is created, process the headers using it as normal. Failures are
             // handled inside of IsContinuationOfLowWorkHeadersSync.
-            (void)IsContinuationOfLowWorkHeadersSync(peer, pfrom, headers);
+            (void)IsContinuationOfLowWorkHeadersSync(peer, pfrom, headers, hashes);
         } else {
             LogDebug(BCLog::NET, "Ignoring low-work chain (height=%u) from peer=%d\n", chain_start_header->nHeight + headers.size(), pfrom.GetId());
         }
@@ -2848,7 +2946,8 @@ void PeerManagerImpl::ProcessHeadersMessage(CNode& pfrom, Peer& peer,
     // We'll rely on headers having valid proof-of-work further down, as an
     // anti-DoS criteria (note: this check is required before passing any
     // headers into HeadersSyncState).
-    if (!CheckHeadersPoW(headers, m_chainparams.GetConsensus(), peer)) {
+    std::vector<uint256> hashes;
+    if (!CheckHeadersPoW(headers, m_chainparams.GetConsensus(), peer, hashes)) {
         // Misbehaving() calls are handled within CheckHeadersPoW(), so we can
         // just return. (Note that even if a header is announced via compact
         // block, the header itself should be valid, so this type of error can
@@ -2870,7 +2969,10 @@ void PeerManagerImpl::ProcessHeadersMessage(CNode& pfrom, Peer& peer,
     {
         LOCK(peer.m_headers_sync_mutex);
 
-        already_validated_work = IsContinuationOfLowWorkHeadersSync(peer, pfrom, headers);
+        already_validated_work = IsContinuationOfLowWorkHeadersSync(peer, pfrom, headers, hashes);
+        // A successful continuation may have replaced the headers with
+        // ones whose hashes we did not compute.
+        if (already_validated_work) hashes.clear();
 
         // The headers we passed in may have been:
         // - untouched, perhaps if no headers-sync was in progress, or some
@@ -2930,7 +3032,7 @@ void PeerManagerImpl::ProcessHeadersMessage(CNode& pfrom, Peer& peer,
     // Do anti-DoS checks to determine if we should process or store for later
     // processing.
     if (!already_validated_work && TryLowWorkHeadersSync(peer, pfrom,
-                chain_start_header, headers)) {
+                chain_start_header, headers, hashes)) {
         // If we successfully started a low-work headers sync, then there
         // should be no headers to process any further.
         Assume(headers.empty());
@@ -3676,6 +3778,12 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
             MakeAndPushMessage(pfrom, NetMsgType::SENDCMPCT, /*high_bandwidth=*/false, /*version=*/CMPCTBLOCKS_VERSION);
         }
 
+        if (m_opts.signet_proof_relay && m_chainman.GetConsensus().signet_blocks) {
+            // Ask for the signet solution of new blocks ahead of their
+            // announcement, so that unsigned blocks are not downloaded.
+            MakeAndPushMessage(pfrom, NetMsgType::SENDSIGPROOF);
+        }
+
         if (m_txreconciliation) {
             if (!peer->m_wtxid_relay || !m_txreconciliation->IsPeerRegistered(pfrom.GetId())) {
                 // We could have optimistically pre-registered/registered the peer. In that case,
@@ -3718,6 +3826,13 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
         return;
     }
 
+    if (msg_type == NetMsgType::SENDSIGPROOF) {
+        if (!m_opts.signet_proof_relay || !m_chainman.GetConsensus().signet_blocks) return;
+        LOCK(cs_main);
+        State(pfrom.GetId())->m_wants_signet_proofs = true;
+        return;
+    }
+
     if (msg_type == NetMsgType::SENDCMPCT) {
         bool sendcmpct_hb{false};
         uint64_t sendcmpct_version{0};
@@ -4927,6 +5042,14 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
         return;
     }
 
+    if (msg_type == NetMsgType::SIGNETPROOF) {
+        if (!m_opts.signet_proof_relay || !m_chainman.GetConsensus().signet_blocks) return;
+        SignetSolutionProof proof;
+        vRecv >> proof;
+        ProcessSignetProof(*peer, proof);
+        return;
+    }
+
     // Ignore unknown commands for extensibility
     LogDebug(BCLog::NET, "Unknown command \"%s\" from peer=%d\n", SanitizeString(msg_type), pfrom.GetId());
     return;
@@ -5030,7 +5153,12 @@ bool PeerManagerImpl::ProcessMessages(CNode* pfrom, std::atomic<bool>& interrupt
     }
 
     try {
-        ProcessMessage(*pfrom, msg.m_type, msg.m_recv, msg.m_time, interruptMsgProc);
+        {
+            // Only known message types get their own counter; the type is peer-controlled.
+            const bool known_type{std::ranges::find(ALL_NET_MESSAGE_TYPES, msg.m_type) != ALL_NET_MESSAGE_TYPES.end()};
+            perf::ScopedTimer timer{"net", known_type ? msg.m_type : NET_MESSAGE_TYPE_OTHER};
+            ProcessMessage(*pfrom, msg.m_type, msg.m_recv, msg.m_time, interruptMsgProc);
+        }
         if (interruptMsgProc) return false;
         {
             LOCK(peer->m_getdata_requests_mutex);
@@ -5631,6 +5759,7 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
                     LogDebug(BCLog::NET, "%s sending header-and-ids %s to peer=%d\n", __func__,
                             vHeaders.front().GetHash().ToString(), pto->GetId());
 
+                    MaybePushSignetProof(*pto, state, pBestIndex->GetBlockHash());
                     std::optional<CSerializedNetMsg> cached_cmpctblock_msg;
                     {
                         LOCK(m_most_recent_block_mutex);
@@ -5658,6 +5787,7 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
                         LogDebug(BCLog::NET, "%s: sending header %s to peer=%d\n", __func__,
                                 vHeaders.front().GetHash().ToString(), pto->GetId());
                     }
+                    MaybePushSignetProof(*pto, state, pBestIndex->GetBlockHash());
                     MakeAndPushMessage(*pto, NetMsgType::HEADERS, TX_WITH_WITNESS(vHeaders));
                     state.pindexBestHeaderSent = pBestIndex;
                 } else
@@ -5682,6 +5812,7 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
 
                     // If the peer's chain has this block, don't inv it back.
                     if (!PeerHasHeader(&state, pindex)) {
+                        MaybePushSignetProof(*pto, state, hashToAnnounce);
                         peer->m_blocks_for_inv_relay.push_back(hashToAnnounce);
                         LogDebug(BCLog::NET, "%s: sending inv peer=%d hash=%s\n", __func__,
                             pto->GetId(), hashToAnnounce.ToString());
@@ -1048,16 +1048,14 @@ bool CSubNet::Match(const CNetAddr &addr) const
     return true;
 }
 
-std::string CSubNet::ToString() const
+size_t CSubNet::GetPrefixLength() const
 {
-    std::string suffix;
-
     switch (network.m_net) {
     case NET_IPV4:
     case NET_IPV6: {
         assert(network.m_addr.size() <= sizeof(netmask));
 
-        uint8_t cidr = 0;
+        size_t cidr = 0;
 
         for (size_t i = 0; i < network.m_addr.size(); ++i) {
             if (netmask[i] == 0x00) {
@@ -1066,9 +1064,29 @@ std::string CSubNet::ToString() const
             cidr += NetmaskBits(netmask[i]);
         }
 
-        suffix = strprintf("/%u", cidr);
+        return cidr;
+    }
+    case NET_ONION:
+    case NET_I2P:
+    case NET_CJDNS:
+    case NET_INTERNAL:
+    case NET_UNROUTABLE:
+    case NET_MAX:
         break;
     }
+
+    return network.m_addr.size() * 8;
+}
+
+std::string CSubNet::ToString() const
+{
+    std::string suffix;
+
+    switch (network.m_net) {
+    case NET_IPV4:
+    case NET_IPV6:
+        suffix = strprintf("/%u", GetPrefixLength());
+        break;
     case NET_ONION:
     case NET_I2P:
     case NET_CJDNS:
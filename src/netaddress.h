@@ -518,6 +518,15 @@ public:
 
     bool Match(const CNetAddr& addr) const;
 
+    //! Base address of the subnet, with the bits outside the netmask cleared.
+    const CNetAddr& GetBaseAddress() const { return network; }
+
+    /**
+     * Number of leading address bits that Match() compares: the CIDR prefix
+     * length for IPv4 and IPv6 subnets, all bits of the address otherwise.
+     */
+    size_t GetPrefixLength() const;
+
     std::string ToString() const;
     bool IsValid() const;
 
@@ -31,14 +31,18 @@
 #include <util/batchpriority.h>
 #include <util/check.h>
 #include <util/fs.h>
+#include <util/fs_helpers.h>
 #include <util/obfuscation.h>
 #include <util/signalinterrupt.h>
 #include <util/strencodings.h>
 #include <util/syserror.h>
+#include <util/threadnames.h>
 #include <util/translation.h>
 #include <validation.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdio>
 #include <map>
 #include <optional>
 #include <unordered_map>
@@ -238,38 +242,52 @@ CBlockIndex* BlockManager::AddToBlockIndex(const CBlockHeader& block, CBlockInde
     return pindexNew;
 }
 
+void BlockManager::PruneBlockData(CBlockIndex& index)
+{
+    AssertLockHeld(cs_main);
+    index.nStatus &= ~BLOCK_HAVE_DATA;
+    index.nStatus &= ~BLOCK_HAVE_UNDO;
+    index.nFile = 0;
+    index.nDataPos = 0;
+    index.nUndoPos = 0;
+    m_dirty_blockindex.insert(&index);
+
+    // Prune from m_blocks_unlinked -- any block we prune would have
+    // to be downloaded again in order to consider its chain, at which
+    // point it would be considered as a candidate for
+    // m_blocks_unlinked or setBlockIndexCandidates.
+    auto range = m_blocks_unlinked.equal_range(index.pprev);
+    while (range.first != range.second) {
+        std::multimap<CBlockIndex*, CBlockIndex*>::iterator _it = range.first;
+        range.first++;
+        if (_it->second == &index) {
+            m_blocks_unlinked.erase(_it);
+        }
+    }
+}
+
 void BlockManager::PruneOneBlockFile(const int fileNumber)
+{
+    PruneBlockFiles({fileNumber});
+}
+
+void BlockManager::PruneBlockFiles(const std::set<int>& file_numbers)
 {
     AssertLockHeld(cs_main);
     LOCK(cs_LastBlockFile);
+    if (file_numbers.empty()) return;
 
     for (auto& entry : m_block_index) {
-        CBlockIndex* pindex = &entry.second;
-        if (pindex->nFile == fileNumber) {
-            pindex->nStatus &= ~BLOCK_HAVE_DATA;
-            pindex->nStatus &= ~BLOCK_HAVE_UNDO;
-            pindex->nFile = 0;
-            pindex->nDataPos = 0;
-            pindex->nUndoPos = 0;
-            m_dirty_blockindex.insert(pindex);
-
-            // Prune from m_blocks_unlinked -- any block we prune would have
-            // to be downloaded again in order to consider its chain, at which
-            // point it would be considered as a candidate for
-            // m_blocks_unlinked or setBlockIndexCandidates.
-            auto range = m_blocks_unlinked.equal_range(pindex->pprev);
-            while (range.first != range.second) {
-                std::multimap<CBlockIndex*, CBlockIndex*>::iterator _it = range.first;
-                range.first++;
-                if (_it->second == pindex) {
-                    m_blocks_unlinked.erase(_it);
-                }
-            }
+        if (file_numbers.contains(entry.second.nFile)) {
+            PruneBlockData(entry.second);
         }
     }
 
-    m_blockfile_info.at(fileNumber) = CBlockFileInfo{};
-    m_dirty_fileinfo.insert(fileNumber);
+    for (const int file_number : file_numbers) {
+        m_blockfile_info.at(file_number) = CBlockFileInfo{};
+        m_dirty_fileinfo.insert(file_number);
+        m_punched_bytes.erase(file_number);
+    }
 }
 
 void BlockManager::FindFilesToPruneManual(
@@ -294,16 +312,17 @@ void BlockManager::FindFilesToPruneManual(
             continue;
         }
 
-        PruneOneBlockFile(fileNumber);
         setFilesToPrune.insert(fileNumber);
         count++;
     }
+    PruneBlockFiles(setFilesToPrune);
     LogInfo("[%s] Prune (Manual): prune_height=%d removed %d blk/rev pairs",
         chain.GetRole(), last_block_can_prune, count);
 }
 
 void BlockManager::FindFilesToPrune(
     std::set<int>& setFilesToPrune,
+    std::vector<PrunedBlockPos>& blocks_to_punch,
     int last_prune,
     const Chainstate& chain,
     ChainstateManager& chainman)
@@ -330,6 +349,7 @@ void BlockManager::FindFilesToPrune(
     uint64_t nBuffer = BLOCKFILE_CHUNK_SIZE + UNDOFILE_CHUNK_SIZE;
     uint64_t nBytesToPrune;
     int count = 0;
+    int punched = 0;
 
     if (nCurrentUsage + nBuffer >= target) {
         // On a prune event, the chainstate DB is flushed.
@@ -362,18 +382,52 @@ void BlockManager::FindFilesToPrune(
                 continue;
             }
 
-            PruneOneBlockFile(fileNumber);
             // Queue up the files for removal
             setFilesToPrune.insert(fileNumber);
             nCurrentUsage -= nBytesToPrune;
             count++;
         }
+        PruneBlockFiles(setFilesToPrune);
+
+        if (m_opts.prune_punch_holes && nCurrentUsage + nBuffer >= target) {
+            // The prunable blocks left are in files that also hold blocks which
+            // must be kept.
+            const size_t first_punched{blocks_to_punch.size()};
+            nCurrentUsage -= PruneBlocksInKeptFiles(blocks_to_punch, chain, min_block_to_prune, last_block_can_prune, nCurrentUsage + nBuffer - target + 1);
+            punched = blocks_to_punch.size() - first_punched;
+        }
     }
 
-    LogDebug(BCLog::PRUNE, "[%s] target=%dMiB actual=%dMiB diff=%dMiB min_height=%d max_prune_height=%d removed %d blk/rev pairs\n",
+    LogDebug(BCLog::PRUNE, "[%s] target=%dMiB actual=%dMiB diff=%dMiB min_height=%d max_prune_height=%d removed %d blk/rev pairs, %d blocks from kept files\n",
              chain.GetRole(), target / 1024 / 1024, nCurrentUsage / 1024 / 1024,
              (int64_t(target) - int64_t(nCurrentUsage)) / 1024 / 1024,
-             min_block_to_prune, last_block_can_prune, count);
+             min_block_to_prune, last_block_can_prune, count, punched);
+}
+
+uint64_t BlockManager::PruneBlocksInKeptFiles(std::vector<PrunedBlockPos>& blocks_to_punch, const Chainstate& chain, int min_height, int max_height, uint64_t bytes_to_free)
+{
+    AssertLockHeld(cs_main);
+    // Blocks below the cursor have been pruned by an earlier call, so this
+    // does not walk the block index. A reorg that deep would only leave the
+    // blocks of the new chain below the cursor in place.
+    int& cursor{m_punch_cursor[chain.GetRole()]};
+    int height{std::max(min_height, cursor)};
+    uint64_t freed{0};
+    for (; height <= std::min(max_height, chain.m_chain.Height()) && freed < bytes_to_free; ++height) {
+        CBlockIndex& index{*chain.m_chain[height]};
+        if (!(index.nStatus & BLOCK_HAVE_DATA)) continue;
+        const PrunedBlockPos block{index.nFile, index.nDataPos, (index.nStatus & BLOCK_HAVE_UNDO) ? index.nUndoPos : 0};
+        AutoFile block_file{OpenBlockFile({block.file, 0}, /*fReadOnly=*/true)};
+        if (const auto size{ReadStoredSize(block_file, block.data_pos)}) freed += STORAGE_HEADER_BYTES + *size;
+        if (block.undo_pos != 0) {
+            AutoFile undo_file{OpenUndoFile({block.file, 0}, /*fReadOnly=*/true)};
+            if (const auto size{ReadStoredSize(undo_file, block.undo_pos)}) freed += STORAGE_HEADER_BYTES + *size + uint256::size();
+        }
+        blocks_to_punch.push_back(block);
+        PruneBlockData(index);
+    }
+    cursor = height;
+    return freed;
 }
 
 void BlockManager::UpdatePruneLock(const std::string& name, const PruneLockInfo& lock_info) {
@@ -479,6 +533,15 @@ bool BlockManager::LoadBlockIndex(const std::optional<uint256>& snapshot_blockha
 bool BlockManager::WriteBlockIndexDB()
 {
     AssertLockHeld(::cs_main);
+    {
+        // Persist the holes punched by the prune thread since the last write.
+        LOCK(cs_LastBlockFile);
+        for (const auto& [file, bytes] : m_punched_bytes) {
+            m_blockfile_info[file].nPunchedBytes += bytes;
+            m_dirty_fileinfo.insert(file);
+        }
+        m_punched_bytes.clear();
+    }
     std::vector<std::pair<int, const CBlockFileInfo*>> vFiles;
     vFiles.reserve(m_dirty_fileinfo.size());
     for (std::set<int>::iterator it = m_dirty_fileinfo.begin(); it != m_dirty_fileinfo.end();) {
@@ -489,6 +552,7 @@ bool BlockManager::WriteBlockIndexDB()
     vBlocks.reserve(m_dirty_blockindex.size());
     for (std::set<CBlockIndex*>::iterator it = m_dirty_blockindex.begin(); it != m_dirty_blockindex.end();) {
         vBlocks.push_back(*it);
+        if (m_track_unchecked_blockindex) m_unchecked_blockindex.insert(*it);
         m_dirty_blockindex.erase(it++);
     }
     int max_blockfile = WITH_LOCK(cs_LastBlockFile, return this->MaxBlockfileNum());
@@ -760,7 +824,10 @@ uint64_t BlockManager::CalculateCurrentUsage()
 
     uint64_t retval = 0;
     for (const CBlockFileInfo& file : m_blockfile_info) {
-        retval += file.nSize + file.nUndoSize;
+        retval += file.nSize + file.nUndoSize - std::min<uint64_t>(file.nSize + file.nUndoSize, file.nPunchedBytes);
+    }
+    for (const auto& [file, bytes] : m_punched_bytes) {
+        retval -= std::min(retval, bytes);
     }
     return retval;
 }
@@ -778,6 +845,105 @@ void BlockManager::UnlinkPrunedFiles(const std::set<int>& setFilesToPrune) const
     }
 }
 
+std::optional<unsigned int> BlockManager::ReadStoredSize(AutoFile& file, unsigned int pos) const
+{
+    if (file.IsNull() || pos < STORAGE_HEADER_BYTES) return std::nullopt;
+    try {
+        MessageStartChars start;
+        unsigned int size;
+        file.seek(pos - STORAGE_HEADER_BYTES, SEEK_SET);
+        file >> start >> size;
+        if (start != GetParams().MessageStart()) return std::nullopt;
+        return size;
+    } catch (const std::exception& e) {
+        LogDebug(BCLog::PRUNE, "Failed to read the size of the data at position %d: %s\n", pos, e.what());
+        return std::nullopt;
+    }
+}
+
+uint64_t BlockManager::PunchBlock(const PrunedBlockPos& block) const
+{
+    // Free the storage header in front of the data, which holds its size, the
+    // data itself and the given number of bytes after it.
+    const auto punch{[&](const FlatFileSeq& seq, unsigned int pos, unsigned int trailing) -> uint64_t {
+        if (pos == 0) return 0;
+        // Unlike FlatFileSeq::Open(), do not create the file if it has been removed.
+        AutoFile file{fsbridge::fopen(seq.FileName({block.file, 0}), "rb+"), m_obfuscation};
+        const auto size{ReadStoredSize(file, pos)};
+        if (!size) return 0;
+        const uint64_t length{uint64_t{STORAGE_HEADER_BYTES} + *size + trailing};
+        std::FILE* raw{file.release()};
+        const bool punched{PunchFileHole(raw, pos - STORAGE_HEADER_BYTES, length)};
+        std::fclose(raw);
+        return punched ? length : 0;
+    }};
+    return punch(m_block_file_seq, block.data_pos, 0) + punch(m_undo_file_seq, block.undo_pos, uint256::size());
+}
+
+void BlockManager::SchedulePruning(std::set<int> files_to_prune, std::vector<PrunedBlockPos> blocks_to_punch)
+{
+    if (files_to_prune.empty() && blocks_to_punch.empty()) return;
+    {
+        LOCK(m_prune_mutex);
+        m_files_to_unlink.merge(files_to_prune);
+        m_blocks_to_punch.insert(m_blocks_to_punch.end(), blocks_to_punch.begin(), blocks_to_punch.end());
+        if (!m_prune_thread.joinable()) {
+            m_prune_thread = std::thread([this] {
+                util::ThreadRename("prune");
+                ThreadPrune();
+            });
+        }
+    }
+    m_prune_cv.notify_all();
+}
+
+void BlockManager::WaitForPruning()
+{
+    WAIT_LOCK(m_prune_mutex, lock);
+    m_prune_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_prune_mutex) {
+        return !m_prune_busy && m_files_to_unlink.empty() && m_blocks_to_punch.empty();
+    });
+}
+
+void BlockManager::ThreadPrune()
+{
+    WAIT_LOCK(m_prune_mutex, lock);
+    while (true) {
+        m_prune_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_prune_mutex) {
+            return m_stop_prune_thread || !m_files_to_unlink.empty() || !m_blocks_to_punch.empty();
+        });
+        // Finish the queued work before stopping.
+        if (m_files_to_unlink.empty() && m_blocks_to_punch.empty()) return;
+        const std::set<int> files{std::exchange(m_files_to_unlink, {})};
+        const std::vector<PrunedBlockPos> blocks{std::exchange(m_blocks_to_punch, {})};
+        m_prune_busy = true;
+        {
+            REVERSE_LOCK(lock, m_prune_mutex);
+            // Punch first, as some of the files to unlink may have had blocks queued to be punched out earlier.
+            std::map<int, uint64_t> freed;
+            for (const PrunedBlockPos& block : blocks) {
+                freed[block.file] += PunchBlock(block);
+            }
+            uint64_t total_freed{0};
+            {
+                LOCK(cs_LastBlockFile);
+                for (const auto& [file, bytes] : freed) {
+                    // Files pruned as a whole in the meantime no longer count.
+                    if (bytes == 0 || size_t(file) >= m_blockfile_info.size() || m_blockfile_info[file].nSize == 0) continue;
+                    m_punched_bytes[file] += bytes;
+                    total_freed += bytes;
+                }
+            }
+            if (!blocks.empty()) {
+                LogDebug(BCLog::PRUNE, "Punched %d pruned blocks out of %d block files, freeing %d KiB\n", blocks.size(), freed.size(), total_freed / 1024);
+            }
+            UnlinkPrunedFiles(files);
+        }
+        m_prune_busy = false;
+        m_prune_cv.notify_all();
+    }
+}
+
 AutoFile BlockManager::OpenBlockFile(const FlatFilePos& pos, bool fReadOnly) const
 {
     return AutoFile{m_block_file_seq.Open(pos, fReadOnly), m_obfuscation};
@@ -1197,6 +1363,15 @@ BlockManager::BlockManager(const util::SignalInterrupt& interrupt, Options opts)
     }
 }
 
+BlockManager::~BlockManager()
+{
+    std::thread prune_thread{WITH_LOCK(m_prune_mutex, m_stop_prune_thread = true; return std::move(m_prune_thread))};
+    if (prune_thread.joinable()) {
+        m_prune_cv.notify_all();
+        prune_thread.join();
+    }
+}
+
 class ImportingNow
 {
     std::atomic<bool>& m_importing;
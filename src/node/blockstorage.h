@@ -10,6 +10,7 @@
 #include <dbwrapper.h>
 #include <flatfile.h>
 #include <kernel/blockmanager_opts.h>
+#include <kernel/chain.h>
 #include <kernel/chainparams.h>
 #include <kernel/cs_main.h>
 #include <kernel/messagestartchars.h>
@@ -22,6 +23,7 @@
 
 #include <array>
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <limits>
@@ -31,6 +33,7 @@
 #include <set>
 #include <span>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -99,6 +102,14 @@ struct PruneLockInfo {
     int height_first{std::numeric_limits<int>::max()}; //! Height of earliest block that should be kept and not pruned
 };
 
+/** Where the data of a block that was pruned from a block file that is still in use was stored. */
+struct PrunedBlockPos {
+    int file{0};
+    //! Position of the block data and of its undo data (0 if it had none), as in CBlockIndex.
+    unsigned int data_pos{0};
+    unsigned int undo_pos{0};
+};
+
 enum BlockfileType {
     // Values used as array indexes - do not change carelessly.
     NORMAL = 0,
@@ -192,11 +203,16 @@ private:
      * The block index is updated by unsetting HAVE_DATA and HAVE_UNDO for any blocks that were stored in the deleted files.
      * A db flag records the fact that at least some block files have been pruned.
      *
+     * With -prunepunchholes, if removing whole files does not get below the target, the blocks in the prunable
+     * height range of files that also hold blocks which must be kept are pruned one by one, lowest first.
+     *
      * @param[out]   setFilesToPrune   The set of file indices that can be unlinked will be returned
+     * @param[out]   blocks_to_punch   The blocks whose data can be punched out of files that are kept
      * @param        last_prune        The last height we're able to prune, according to the prune locks
      */
     void FindFilesToPrune(
         std::set<int>& setFilesToPrune,
+        std::vector<PrunedBlockPos>& blocks_to_punch,
         int last_prune,
         const Chainstate& chain,
         ChainstateManager& chainman);
@@ -240,6 +256,14 @@ private:
     /** Dirty block index entries. */
     std::set<CBlockIndex*> m_dirty_blockindex;
 
+    /**
+     * Block index entries that were changed since the last
+     * ChainstateManager::CheckChangedBlockIndex(), besides those still in
+     * m_dirty_blockindex. Only tracked with an incremental -checkblockindex.
+     */
+    bool m_track_unchecked_blockindex{false};
+    std::set<const CBlockIndex*> m_unchecked_blockindex;
+
     /** Dirty block file entries. */
     std::set<int> m_dirty_fileinfo;
 
@@ -258,10 +282,43 @@ private:
     const FlatFileSeq m_block_file_seq;
     const FlatFileSeq m_undo_file_seq;
 
+    /**
+     * Bytes freed by the prune thread punching holes into each block file and its undo file, which are moved to
+     * CBlockFileInfo::nPunchedBytes when the block index is written next.
+     */
+    std::map<int, uint64_t> m_punched_bytes GUARDED_BY(cs_LastBlockFile);
+    //! Per chainstate role, the lowest height PruneBlocksInKeptFiles() has not looked at yet.
+    std::map<ChainstateRole, int> m_punch_cursor GUARDED_BY(::cs_main);
+
+    /**
+     * Pruned files and blocks waiting for m_prune_thread to remove them from
+     * disk. The block index no longer refers to them.
+     */
+    Mutex m_prune_mutex;
+    std::condition_variable m_prune_cv;
+    std::set<int> m_files_to_unlink GUARDED_BY(m_prune_mutex);
+    std::vector<PrunedBlockPos> m_blocks_to_punch GUARDED_BY(m_prune_mutex);
+    bool m_prune_busy GUARDED_BY(m_prune_mutex){false};
+    bool m_stop_prune_thread GUARDED_BY(m_prune_mutex){false};
+    //! Started by the first call to SchedulePruning().
+    std::thread m_prune_thread GUARDED_BY(m_prune_mutex);
+
+    /** Forget the block and undo data of a block, which is about to be removed from disk. */
+    void PruneBlockData(CBlockIndex& index) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+
+    void ThreadPrune() EXCLUSIVE_LOCKS_REQUIRED(!m_prune_mutex);
+
+    /** Free the disk space used by a pruned block and its undo data. Returns the number of bytes freed. */
+    uint64_t PunchBlock(const PrunedBlockPos& block) const;
+
+    /** Read the size of the data at pos in file from the storage header in front of it. */
+    std::optional<unsigned int> ReadStoredSize(AutoFile& file, unsigned int pos) const;
+
 public:
     using Options = kernel::BlockManagerOpts;
 
     explicit BlockManager(const util::SignalInterrupt& interrupt, Options opts);
+    ~BlockManager();
 
     const util::SignalInterrupt& m_interrupt;
     std::atomic<bool> m_importing{false};
@@ -315,8 +372,25 @@ public:
     /** Create a new block index entry for a given block hash */
     CBlockIndex* InsertBlockIndex(const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
+    //! Entries changed since the last incremental block index check, besides the dirty ones. Only used by tests.
+    const std::set<const CBlockIndex*>& GetUncheckedBlockIndex() const EXCLUSIVE_LOCKS_REQUIRED(::cs_main) { return m_unchecked_blockindex; }
+
     //! Mark one block file as pruned (modify associated database entries)
     void PruneOneBlockFile(const int fileNumber) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    //! Mark block files as pruned, in a single pass over the block index
+    void PruneBlockFiles(const std::set<int>& file_numbers) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+
+    /**
+     * Mark the blocks of chain between min_height and max_height as pruned,
+     * lowest first, until at least bytes_to_free bytes of block and undo data
+     * (as recorded in their storage headers) would be freed. Used by
+     * -prunepunchholes once no more files can be removed as a whole. Each
+     * height is only considered once per chainstate role.
+     *
+     * @param[out]   blocks_to_punch   The blocks whose data can be punched out of their files
+     * @returns the number of bytes the pruned blocks take up on disk
+     */
+    uint64_t PruneBlocksInKeptFiles(std::vector<PrunedBlockPos>& blocks_to_punch, const Chainstate& chain, int min_height, int max_height, uint64_t bytes_to_free) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     CBlockIndex* LookupBlockIndex(const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     const CBlockIndex* LookupBlockIndex(const uint256& hash) const EXCLUSIVE_LOCKS_REQUIRED(cs_main);
@@ -410,6 +484,17 @@ public:
      */
     void UnlinkPrunedFiles(const std::set<int>& setFilesToPrune) const;
 
+    /**
+     * Unlink the specified files and punch the specified blocks out of their
+     * files on a background thread, so that the caller does not wait for the
+     * file system. Only call this after the block index no longer referring to
+     * them has been written.
+     */
+    void SchedulePruning(std::set<int> files_to_prune, std::vector<PrunedBlockPos> blocks_to_punch) EXCLUSIVE_LOCKS_REQUIRED(!m_prune_mutex);
+
+    /** Wait until the files and blocks passed to SchedulePruning() have been removed from disk. */
+    void WaitForPruning() EXCLUSIVE_LOCKS_REQUIRED(!m_prune_mutex);
+
     /** Functions for disk access for blocks */
     bool ReadBlock(CBlock& block, const FlatFilePos& pos, const std::optional<uint256>& expected_hash) const;
     bool ReadBlock(CBlock& block, const CBlockIndex& index) const;
@@ -0,0 +1,209 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/cache_governor.h>
+
+#include <coins.h>
+#include <consensus/validation.h>
+#include <logging.h>
+#include <sync.h>
+#include <txdb.h>
+#include <util/strencodings.h>
+#include <util/string.h>
+#include <validation.h>
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace node {
+
+//! Shrink the budget once some task of the cgroup stalled on memory this share of the time, in percent.
+static constexpr double SHRINK_AT_PRESSURE_PERCENT{10.0};
+//! Shrink the budget once the cgroup uses this share of its limit, in percent.
+static constexpr uint64_t SHRINK_AT_USAGE_PERCENT{90};
+//! Share of the cgroup limit that a grown budget may fill, in percent.
+static constexpr uint64_t TARGET_USAGE_PERCENT{80};
+//! Only grow the budget when at least this share of lookups misses the cache, in percent.
+static constexpr uint64_t GROW_AT_MISS_PERCENT{2};
+//! cgroup v1 reports this, or a bigger value rounded to the page size, when there is no limit.
+static constexpr uint64_t CGROUP_V1_NO_LIMIT{uint64_t{1} << 62};
+
+namespace {
+
+std::optional<std::string> ReadFirstLine(const fs::path& path)
+{
+    std::ifstream file{path};
+    std::string line;
+    if (!file.is_open() || !std::getline(file, line)) return std::nullopt;
+    return line;
+}
+
+std::optional<uint64_t> ReadUint64(const fs::path& path)
+{
+    const auto line{ReadFirstLine(path)};
+    return line ? ToIntegral<uint64_t>(util::TrimStringView(*line)) : std::nullopt;
+}
+
+/** Value of key in a "key value" per line file such as memory.stat. */
+std::optional<uint64_t> ReadStat(const fs::path& path, std::string_view key)
+{
+    std::ifstream file{path};
+    std::string line;
+    while (std::getline(file, line)) {
+        const auto fields{util::SplitString(line, ' ')};
+        if (fields.size() == 2 && fields[0] == key) return ToIntegral<uint64_t>(fields[1]);
+    }
+    return std::nullopt;
+}
+
+/** The avg10 field of the "some" line of a pressure stall information file. */
+std::optional<double> ReadPressure(const fs::path& path)
+{
+    std::ifstream file{path};
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.starts_with("some ")) continue;
+        for (const auto& field : util::SplitString(line, ' ')) {
+            if (!field.starts_with("avg10=")) continue;
+            const std::string_view value{std::string_view{field}.substr(6)};
+            double result;
+            const auto [end, ec]{std::from_chars(value.data(), value.data() + value.size(), result)};
+            if (ec == std::errc{} && end == value.data() + value.size()) return result;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+fs::path FindCgroupMemoryDir()
+{
+    const fs::path root{"/sys/fs/cgroup"};
+    std::ifstream file{"/proc/self/cgroup"};
+    std::string line;
+    while (std::getline(file, line)) {
+        // The single cgroup v2 hierarchy is listed as "0::<path>".
+        if (!line.starts_with("0::/")) continue;
+        const fs::path dir{root / fs::PathFromString(line.substr(4))};
+        if (fs::exists(dir / "memory.current")) return dir;
+    }
+    return root;
+}
+
+std::optional<CgroupMemory> ReadCgroupMemory(const fs::path& cgroup_dir)
+{
+    CgroupMemory result;
+    // Page cache the kernel can drop at any time is not counted as used.
+    if (const auto current{ReadUint64(cgroup_dir / "memory.current")}) {
+        const uint64_t inactive_file{ReadStat(cgroup_dir / "memory.stat", "inactive_file").value_or(0)};
+        result.usage = *current - std::min(*current, inactive_file);
+        result.limit = ReadUint64(cgroup_dir / "memory.max"); // "max" when there is no limit
+        result.pressure = ReadPressure(cgroup_dir / "memory.pressure");
+        return result;
+    }
+    const fs::path v1_dir{cgroup_dir / "memory"};
+    if (const auto current{ReadUint64(v1_dir / "memory.usage_in_bytes")}) {
+        const uint64_t inactive_file{ReadStat(v1_dir / "memory.stat", "total_inactive_file").value_or(0)};
+        result.usage = *current - std::min(*current, inactive_file);
+        result.limit = ReadUint64(v1_dir / "memory.limit_in_bytes");
+        if (result.limit >= CGROUP_V1_NO_LIMIT) result.limit.reset();
+        return result;
+    }
+    return std::nullopt;
+}
+
+size_t NextCoinsCacheBudget(size_t configured, const CoinsCacheObservation& observation)
+{
+    const size_t budget{observation.budget};
+    const size_t min_budget{configured / 4};
+    const auto& cgroup{observation.cgroup};
+    const std::optional<uint64_t> limit{cgroup ? cgroup->limit : std::nullopt};
+    const bool stalling{cgroup && cgroup->pressure >= SHRINK_AT_PRESSURE_PERCENT};
+
+    if (stalling || (limit && cgroup->usage >= *limit / 100 * SHRINK_AT_USAGE_PERCENT)) {
+        // Give back at least a quarter, or as much as the cgroup is above its target.
+        const uint64_t target{limit ? *limit / 100 * TARGET_USAGE_PERCENT : 0};
+        const uint64_t excess{limit && cgroup->usage > target ? cgroup->usage - target : 0};
+        const uint64_t cut{std::max<uint64_t>(budget / 4, excess)};
+        return std::max<size_t>(min_budget, budget > cut ? budget - cut : 0);
+    }
+
+    // Without a limit there is no known free memory to grow into.
+    if (!limit) return budget < configured ? std::min(configured, budget + budget / 4) : configured;
+
+    const uint64_t target{*limit / 100 * TARGET_USAGE_PERCENT};
+    if (cgroup->usage >= target) return budget;
+    const uint64_t headroom{(target - cgroup->usage) / 2};
+    if (budget < configured) return std::min<uint64_t>(configured, budget + std::min<uint64_t>(budget / 4, headroom));
+
+    const uint64_t lookups{observation.hits + observation.misses};
+    const bool cache_full{observation.usage >= budget / 10 * 9};
+    const bool missing{lookups > 0 && observation.misses * 100 >= lookups * GROW_AT_MISS_PERCENT};
+    if (cache_full && missing) return budget + std::min<uint64_t>(budget / 4, headroom);
+    return budget;
+}
+
+CacheGovernor::CacheGovernor(ChainstateManager& chainman, fs::path cgroup_dir)
+    : m_chainman{chainman},
+      m_cgroup_dir{std::move(cgroup_dir)},
+      m_configured{WITH_LOCK(::cs_main, return chainman.m_total_coinstip_cache)}
+{
+    if (const auto cgroup{ReadCgroupMemory(m_cgroup_dir)}; cgroup && cgroup->limit) {
+        LogInfo("Adaptive dbcache: cgroup memory limit %.1f MiB at %s", *cgroup->limit * (1.0 / 1024 / 1024), fs::PathToString(m_cgroup_dir));
+    } else {
+        LogInfo("Adaptive dbcache: no cgroup memory limit found, the coins cache will not grow beyond -dbcache");
+    }
+}
+
+void CacheGovernor::Tick()
+{
+    // Read the cgroup files before taking cs_main.
+    const auto cgroup{ReadCgroupMemory(m_cgroup_dir)};
+
+    LOCK(::cs_main);
+    Chainstate& chainstate{m_chainman.ActiveChainstate()};
+    if (!chainstate.CanFlushToDisk()) return;
+    CCoinsViewCache& tip{chainstate.CoinsTip()};
+
+    // The counters restart when the active chainstate changes.
+    const uint64_t hits{tip.GetCacheHits()}, misses{tip.GetCacheMisses()};
+    const CoinsCacheObservation observation{
+        .budget = m_chainman.m_total_coinstip_cache,
+        .usage = tip.DynamicMemoryUsage(),
+        .hits = hits >= m_last_hits ? hits - m_last_hits : hits,
+        .misses = misses >= m_last_misses ? misses - m_last_misses : misses,
+        .cgroup = cgroup,
+    };
+    m_last_hits = hits;
+    m_last_misses = misses;
+
+    const size_t budget{NextCoinsCacheBudget(m_configured, observation)};
+    if (budget != observation.budget) {
+        LogInfo("Adaptive dbcache: coins cache budget %.1f MiB -> %.1f MiB (usage %.1f MiB, %u hits, %u misses)",
+                observation.budget * (1.0 / 1024 / 1024), budget * (1.0 / 1024 / 1024),
+                observation.usage * (1.0 / 1024 / 1024), observation.hits, observation.misses);
+        m_chainman.m_total_coinstip_cache = budget;
+        m_chainman.MaybeRebalanceCaches();
+    }
+
+    // Write the cache out once no block arrived for a while, so the write does not delay the next one.
+    const uint256 tip_hash{tip.GetBestBlock()};
+    const auto now{SteadyClock::now()};
+    if (tip_hash != m_last_tip) {
+        m_last_tip = tip_hash;
+        m_last_tip_change = now;
+    } else if (now - m_last_tip_change >= IDLE_FLUSH_DELAY && !m_chainman.IsInitialBlockDownload() &&
+               tip_hash != chainstate.CoinsDB().GetBestBlock()) {
+        BlockValidationState state;
+        if (!chainstate.FlushStateToDisk(state, FlushStateMode::IDLE)) {
+            LogWarning("Adaptive dbcache: failed to write the chainstate while idle (%s)", state.ToString());
+        }
+    }
+}
+
+} // namespace node
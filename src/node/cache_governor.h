@@ -0,0 +1,96 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NODE_CACHE_GOVERNOR_H
+#define BITCOIN_NODE_CACHE_GOVERNOR_H
+
+#include <sync.h>
+#include <uint256.h>
+#include <util/fs.h>
+#include <util/time.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+class ChainstateManager;
+
+extern RecursiveMutex cs_main;
+
+namespace node {
+
+//! -adaptivedbcache default
+static constexpr bool DEFAULT_ADAPTIVE_DBCACHE{false};
+//! How often the governor re-evaluates the coins cache budget.
+static constexpr std::chrono::seconds CACHE_GOVERNOR_INTERVAL{10};
+//! How long the tip must be unchanged before the coins cache is written out while idle.
+static constexpr std::chrono::seconds IDLE_FLUSH_DELAY{60};
+
+/** Memory accounting of a cgroup. */
+struct CgroupMemory {
+    std::optional<uint64_t> limit;
+    uint64_t usage{0};
+    //! Share of the last 10 seconds in which some task of the cgroup stalled on memory, in percent. cgroup v2 only.
+    std::optional<double> pressure;
+};
+
+/** Directory holding the memory controller files of the cgroup this process runs in. */
+fs::path FindCgroupMemoryDir();
+
+/** Read the memory limit, usage and pressure from cgroup_dir, which may use the cgroup v2 or v1 layout. */
+std::optional<CgroupMemory> ReadCgroupMemory(const fs::path& cgroup_dir);
+
+/** What the governor observed during the last interval. */
+struct CoinsCacheObservation {
+    //! Current coins cache budget, in bytes.
+    size_t budget{0};
+    //! Memory used by the coins cache, in bytes.
+    size_t usage{0};
+    //! Lookups answered from the cache, and passed on to the database, during the interval.
+    uint64_t hits{0};
+    uint64_t misses{0};
+    std::optional<CgroupMemory> cgroup;
+};
+
+/**
+ * Coins cache budget for the next interval, given the budget derived from
+ * -dbcache. Shrinks the budget while the cgroup is close to its memory limit
+ * or stalls on memory, grows it into free cgroup memory while a full cache
+ * misses often, and otherwise returns towards the configured size.
+ */
+size_t NextCoinsCacheBudget(size_t configured, const CoinsCacheObservation& observation);
+
+/**
+ * Periodically resizes the coins cache of a ChainstateManager according to
+ * NextCoinsCacheBudget(), and writes the cache to disk while no blocks arrive,
+ * so that the next flush, or a restart after a crash, has less to do.
+ *
+ * The mempool is not resized: the coins cache already uses the part of the
+ * mempool budget that the mempool does not need (see
+ * Chainstate::GetCoinsCacheSizeState()). The index databases' caches are fixed
+ * when they are opened.
+ */
+class CacheGovernor
+{
+public:
+    CacheGovernor(ChainstateManager& chainman, fs::path cgroup_dir) EXCLUSIVE_LOCKS_REQUIRED(!::cs_main);
+
+    //! Called every CACHE_GOVERNOR_INTERVAL.
+    void Tick() EXCLUSIVE_LOCKS_REQUIRED(!::cs_main);
+
+private:
+    ChainstateManager& m_chainman;
+    const fs::path m_cgroup_dir;
+    //! Coins cache budget derived from -dbcache.
+    const size_t m_configured;
+    uint64_t m_last_hits GUARDED_BY(::cs_main){0};
+    uint64_t m_last_misses GUARDED_BY(::cs_main){0};
+    uint256 m_last_tip GUARDED_BY(::cs_main);
+    SteadyClock::time_point m_last_tip_change GUARDED_BY(::cs_main);
+};
+
+} // namespace node
+
+#endif // BITCOIN_NODE_CACHE_GOVERNOR_H
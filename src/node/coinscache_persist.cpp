@@ -0,0 +1,173 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/coinscache_persist.h>
+
+#include <coins.h>
+#include <common/args.h>
+#include <common/system.h>
+#include <logging.h>
+#include <primitives/transaction.h>
+#include <serialize.h>
+#include <streams.h>
+#include <sync.h>
+#include <txdb.h>
+#include <util/fs.h>
+#include <util/fs_helpers.h>
+#include <util/signalinterrupt.h>
+#include <util/syserror.h>
+#include <util/threadpool.h>
+#include <util/time.h>
+#include <validation.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace node {
+
+static const uint64_t COINS_CACHE_DUMP_VERSION{1};
+//! Outpoints read per cs_main acquisition while loading.
+static constexpr size_t COINS_PREFETCH_BATCH_SIZE{512};
+//! Maximum number of threads reading coins from the database, the loading thread included.
+static constexpr int MAX_COINS_PREFETCH_THREADS{8};
+
+bool ShouldPersistCoinsCache(const ArgsManager& argsman)
+{
+    return argsman.GetBoolArg("-persistcoinscache", DEFAULT_PERSIST_COINS_CACHE);
+}
+
+fs::path CoinsCachePath(const ArgsManager& argsman)
+{
+    return argsman.GetDataDirNet() / "coinscache.dat";
+}
+
+bool DumpCoinsCache(Chainstate& chainstate, const fs::path& dump_path)
+{
+    const auto start{SteadyClock::now()};
+
+    std::vector<COutPoint> outpoints;
+    {
+        LOCK(cs_main);
+        if (!chainstate.CanFlushToDisk()) return false;
+        outpoints = chainstate.CoinsTip().GetCachedOutPoints(MAX_COINS_CACHE_DUMP_SIZE);
+    }
+    // Group the outputs of each transaction so that every txid is written once.
+    std::sort(outpoints.begin(), outpoints.end());
+
+    const fs::path file_fspath{dump_path + ".new"};
+    AutoFile file{fsbridge::fopen(file_fspath, "wb")};
+    if (file.IsNull()) {
+        return false;
+    }
+
+    try {
+        file << COINS_CACHE_DUMP_VERSION;
+        file << uint64_t{outpoints.size()};
+        for (auto it{outpoints.begin()}; it != outpoints.end();) {
+            const auto tx_end{std::find_if(it, outpoints.end(), [&](const COutPoint& outpoint) { return outpoint.hash != it->hash; })};
+            file << it->hash;
+            WriteCompactSize(file, tx_end - it);
+            for (; it != tx_end; ++it) {
+                file << VARINT(it->n);
+            }
+        }
+
+        if (!file.Commit()) {
+            (void)file.fclose();
+            throw std::runtime_error("Commit failed");
+        }
+        if (file.fclose() != 0) {
+            throw std::runtime_error(
+                strprintf("Error closing %s: %s", fs::PathToString(file_fspath), SysErrorString(errno)));
+        }
+        if (!RenameOver(dump_path + ".new", dump_path)) {
+            throw std::runtime_error("Rename failed");
+        }
+        LogInfo("Dumped %u UTXO cache outpoints: %.3fs, %d bytes dumped to file\n",
+                outpoints.size(), Ticks<SecondsDouble>(SteadyClock::now() - start), fs::file_size(dump_path));
+    } catch (const std::exception& e) {
+        LogInfo("Failed to dump UTXO cache outpoints: %s. Continuing anyway.\n", e.what());
+        (void)file.fclose();
+        return false;
+    }
+    return true;
+}
+
+bool LoadCoinsCache(Chainstate& chainstate, const fs::path& load_path)
+{
+    if (load_path.empty()) return false;
+
+    AutoFile file{fsbridge::fopen(load_path, "rb")};
+    if (file.IsNull()) {
+        LogInfo("Failed to open UTXO cache file. Continuing anyway.\n");
+        return false;
+    }
+
+    const auto start{SteadyClock::now()};
+    ThreadPool pool{"coinsprefetch"};
+    pool.Start(std::clamp(GetNumCores(), 1, MAX_COINS_PREFETCH_THREADS) - 1);
+
+    std::vector<COutPoint> batch;
+    std::vector<std::optional<Coin>> coins;
+    uint64_t prefetched{0};
+    // Read the coins of batch from the database into the cache. Returns false once the cache is full.
+    const auto prefetch_batch{[&]() EXCLUSIVE_LOCKS_REQUIRED(!::cs_main) {
+        // Holding cs_main keeps the database consistent with the cache while
+        // the coins are read: it is only written by a flush of the cache.
+        LOCK(cs_main);
+        if (chainstate.GetCoinsCacheSizeState() != CoinsCacheSizeState::OK) return false;
+        CCoinsViewCache& tip{chainstate.CoinsTip()};
+        CCoinsViewDB& db{chainstate.CoinsDB()};
+        std::erase_if(batch, [&](const COutPoint& outpoint) { return tip.HaveCoinInCache(outpoint); });
+        coins.assign(batch.size(), std::nullopt);
+        pool.ParallelFor(batch.size(), [&](size_t i) { coins[i] = db.GetCoin(batch[i]); });
+        for (size_t i{0}; i < batch.size(); ++i) {
+            if (!coins[i]) continue;
+            tip.PrefetchCoin(batch[i], std::move(*coins[i]));
+            ++prefetched;
+        }
+        batch.clear();
+        return true;
+    }};
+
+    uint64_t total{0};
+    try {
+        uint64_t version;
+        file >> version;
+        if (version != COINS_CACHE_DUMP_VERSION) return false;
+
+        file >> total;
+        LogInfo("Loading the coins of %u outpoints into the UTXO cache...\n", total);
+        uint64_t read{0};
+        while (read < total) {
+            Txid txid;
+            file >> txid;
+            const uint64_t num_outputs{ReadCompactSize(file)};
+            for (uint64_t i{0}; i < num_outputs && read < total; ++i, ++read) {
+                uint32_t n;
+                file >> VARINT(n);
+                batch.emplace_back(txid, n);
+            }
+            if (batch.size() >= COINS_PREFETCH_BATCH_SIZE || read == total) {
+                if (!prefetch_batch()) {
+                    LogInfo("UTXO cache is full, stopped loading after %u of %u outpoints\n", read, total);
+                    break;
+                }
+            }
+            if (chainstate.m_chainman.m_interrupt) return false;
+        }
+    } catch (const std::exception& e) {
+        LogInfo("Failed to load UTXO cache outpoints: %s. Continuing anyway.\n", e.what());
+        return false;
+    }
+
+    LogInfo("Loaded %u coins into the UTXO cache: %.3fs\n", prefetched, Ticks<SecondsDouble>(SteadyClock::now() - start));
+    return true;
+}
+
+} // namespace node
@@ -0,0 +1,50 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_NODE_COINSCACHE_PERSIST_H
+#define BITCOIN_NODE_COINSCACHE_PERSIST_H
+
+#include <sync.h>
+#include <util/fs.h>
+
+#include <cstddef>
+
+class ArgsManager;
+class Chainstate;
+
+extern RecursiveMutex cs_main;
+
+namespace node {
+
+/**
+ * Default for -persistcoinscache, indicating whether the node should save the
+ * outpoints held in the UTXO cache on shutdown and read their coins back into
+ * the cache on start.
+ */
+static constexpr bool DEFAULT_PERSIST_COINS_CACHE{true};
+
+//! Maximum number of outpoints written to the dump file.
+static constexpr size_t MAX_COINS_CACHE_DUMP_SIZE{4'000'000};
+
+bool ShouldPersistCoinsCache(const ArgsManager& argsman);
+fs::path CoinsCachePath(const ArgsManager& argsman);
+
+/**
+ * Write the outpoints of the unspent coins in the chainstate's UTXO cache to a
+ * file. Only the outpoints are stored; the coins themselves are read back from
+ * the chainstate database on load.
+ */
+bool DumpCoinsCache(Chainstate& chainstate, const fs::path& dump_path) EXCLUSIVE_LOCKS_REQUIRED(!::cs_main);
+
+/**
+ * Read the coins of the outpoints in the file from the chainstate database into
+ * the UTXO cache, several at a time and in parallel. Stops early when the cache
+ * is full or on interrupt. Outpoints that have been spent since the dump are
+ * skipped.
+ */
+bool LoadCoinsCache(Chainstate& chainstate, const fs::path& load_path) EXCLUSIVE_LOCKS_REQUIRED(!::cs_main);
+
+} // namespace node
+
+#endif // BITCOIN_NODE_COINSCACHE_PERSIST_H
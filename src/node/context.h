@@ -82,6 +82,9 @@ struct NodeContext {
     std::unique_ptr<interfaces::Mining> mining;
     interfaces::WalletLoader* wallet_loader{nullptr};
     std::unique_ptr<CScheduler> scheduler;
+    //! Delivers validation interface notifications, apart from the background
+    //! tasks run by scheduler.
+    std::unique_ptr<CScheduler> notification_scheduler;
     std::function<void()> rpc_interruption_point = [] {};
     //! Issues blocking calls about sync status, errors and warnings
     std::unique_ptr<KernelNotifications> notifications;
@@ -93,6 +96,9 @@ struct NodeContext {
     //! Federation extended private key for signet block signing (nullptr on non-signet chains)
     std::unique_ptr<CExtKey> federation_key;
     std::thread background_init_thread;
+    //! Whether the UTXO cache was warmed up from disk, so that shutdown does
+    //! not overwrite the dump with the outpoints of a cold cache.
+    std::atomic<bool> coins_cache_load_tried{false};
 
     //! Declare default constructor and destructor that are not inline, so code
     //! instantiating the NodeContext struct doesn't need to #include class
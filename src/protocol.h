@@ -64,6 +64,17 @@ namespace NetMsgType {
  * block_data as specified in BIP 325 matches the commitment in the PSBT.
  */
 inline constexpr const char* SIGNETPSBT{"signetpsbt"};
+/**
+ * Indicates that a node prefers to receive a signetproof message before a new
+ * block is announced to it. Only used on signet.
+ */
+inline constexpr const char* SENDSIGPROOF{"sendsigproof"};
+/**
+ * The signetproof message contains a block header, its coinbase transaction
+ * and the coinbase's merkle path, so the receiver can check the block's signet
+ * solution before downloading or reconstructing the block.
+ */
+inline constexpr const char* SIGNETPROOF{"signetproof"};
 /**
  * The version message provides information about the transmitting node to the
  * receiving node at the beginning of a connection.
@@ -275,6 +286,8 @@ inline constexpr const char* SENDTXRCNCL{"sendtxrcncl"};
 /** All known message types (see above). Keep this in the same order as the list of messages above. */
 inline const std::array ALL_NET_MESSAGE_TYPES{std::to_array<std::string>({
     NetMsgType::SIGNETPSBT,
+    NetMsgType::SENDSIGPROOF,
+    NetMsgType::SIGNETPROOF,
     NetMsgType::VERSION,
     NetMsgType::VERACK,
     NetMsgType::ADDR,
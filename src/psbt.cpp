@@ -4,15 +4,22 @@
 
 #include <psbt.h>
 
+#include <common/system.h>
 #include <common/types.h>
 #include <node/types.h>
 #include <policy/policy.h>
 #include <script/signingprovider.h>
 #include <util/check.h>
 #include <util/strencodings.h>
+#include <util/threadpool.h>
+
+#include <algorithm>
 
 using common::PSBTError;
 
+/** Maximum number of threads used by SignPSBTInputs, including the calling thread. */
+static constexpr int MAX_PSBT_SIGNING_THREADS{16};
+
 PartiallySignedTransaction::PartiallySignedTransaction(const CMutableTransaction& tx) : tx(tx)
 {
     inputs.resize(tx.vin.size());
@@ -298,7 +305,7 @@ bool PSBTInputSigned(const PSBTInput& input)
     return !input.final_script_sig.empty() || !input.final_script_witness.IsNull();
 }
 
-bool PSBTInputSignedAndVerified(const PartiallySignedTransaction psbt, unsigned int input_index, const PrecomputedTransactionData* txdata)
+bool PSBTInputSignedAndVerified(const PartiallySignedTransaction& psbt, unsigned int input_index, const PrecomputedTransactionData* txdata)
 {
     CTxOut utxo;
     assert(psbt.inputs.size() >= input_index);
@@ -487,6 +494,26 @@ PSBTError SignPSBTInput(const SigningProvider& provider, PartiallySignedTransact
     return sig_complete ? PSBTError::OK : PSBTError::INCOMPLETE;
 }
 
+std::vector<PSBTError> SignPSBTInputs(PartiallySignedTransaction& psbt, std::span<const PSBTInputSigningJob> jobs, const PrecomputedTransactionData* txdata, bool finalize)
+{
+    std::vector<PSBTError> results(jobs.size(), PSBTError::OK);
+    const auto sign_job{[&](size_t i) {
+        const PSBTInputSigningJob& job{jobs[i]};
+        results[i] = SignPSBTInput(*job.provider, psbt, job.index, txdata, job.sighash, /*out_sigdata=*/nullptr, finalize);
+    }};
+
+    const int num_threads{std::min(GetNumCores(), MAX_PSBT_SIGNING_THREADS)};
+    if (jobs.size() < PSBT_PARALLEL_SIGNING_MIN_INPUTS || num_threads <= 1) {
+        for (size_t i = 0; i < jobs.size(); ++i) sign_job(i);
+        return results;
+    }
+
+    ThreadPool pool{"psbtsign"};
+    pool.Start(num_threads - 1);
+    pool.ParallelFor(jobs.size(), sign_job);
+    return results;
+}
+
 void RemoveUnnecessaryTransactions(PartiallySignedTransaction& psbtx)
 {
     // Figure out if any non_witness_utxos should be dropped
@@ -532,9 +559,13 @@ bool FinalizePSBT(PartiallySignedTransaction& psbtx)
     //   script.
     bool complete = true;
     const PrecomputedTransactionData txdata = PrecomputePSBTData(psbtx);
+    std::vector<PSBTInputSigningJob> jobs;
+    jobs.reserve(psbtx.tx->vin.size());
     for (unsigned int i = 0; i < psbtx.tx->vin.size(); ++i) {
-        PSBTInput& input = psbtx.inputs.at(i);
-        complete &= (SignPSBTInput(DUMMY_SIGNING_PROVIDER, psbtx, i, &txdata, input.sighash_type, nullptr, true) == PSBTError::OK);
+        jobs.push_back({i, &DUMMY_SIGNING_PROVIDER, psbtx.inputs.at(i).sighash_type});
+    }
+    for (const PSBTError res : SignPSBTInputs(psbtx, jobs, &txdata, /*finalize=*/true)) {
+        complete &= (res == PSBTError::OK);
     }
 
     return complete;
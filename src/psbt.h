@@ -17,6 +17,7 @@
 #include <streams.h>
 
 #include <optional>
+#include <vector>
 
 namespace node {
 enum class TransactionError;
@@ -1397,7 +1398,7 @@ PrecomputedTransactionData PrecomputePSBTData(const PartiallySignedTransaction&
 bool PSBTInputSigned(const PSBTInput& input);
 
 /** Checks whether a PSBTInput is already signed by doing script verification using final fields. */
-bool PSBTInputSignedAndVerified(const PartiallySignedTransaction psbt, unsigned int input_index, const PrecomputedTransactionData* txdata);
+bool PSBTInputSignedAndVerified(const PartiallySignedTransaction& psbt, unsigned int input_index, const PrecomputedTransactionData* txdata);
 
 /** Signs a PSBTInput, verifying that all provided data matches what is being signed.
  *
@@ -1406,6 +1407,26 @@ bool PSBTInputSignedAndVerified(const PartiallySignedTransaction psbt, unsigned
  **/
 [[nodiscard]] PSBTError SignPSBTInput(const SigningProvider& provider, PartiallySignedTransaction& psbt, int index, const PrecomputedTransactionData* txdata, std::optional<int> sighash = std::nullopt, SignatureData* out_sigdata = nullptr, bool finalize = true);
 
+/** Minimum number of inputs for SignPSBTInputs to spread the signing over several threads. */
+static constexpr size_t PSBT_PARALLEL_SIGNING_MIN_INPUTS{64};
+
+/** A PSBTInput to be signed by SignPSBTInputs, with the arguments SignPSBTInput would take for it. */
+struct PSBTInputSigningJob {
+    unsigned int index;
+    const SigningProvider* provider;
+    std::optional<int> sighash;
+};
+
+/** Signs several PSBTInputs, returning the SignPSBTInput result of every job in order.
+ *
+ * Signing an input only reads the unsigned transaction and txdata, and only modifies
+ * that input, so with at least PSBT_PARALLEL_SIGNING_MIN_INPUTS jobs the inputs are
+ * signed concurrently on worker threads. The job indices must therefore be distinct,
+ * and the signing providers must be safe for concurrent reads. txdata is computed
+ * once by the caller (see PrecomputePSBTData) and shared by all workers.
+ **/
+std::vector<PSBTError> SignPSBTInputs(PartiallySignedTransaction& psbt, std::span<const PSBTInputSigningJob> jobs, const PrecomputedTransactionData* txdata, bool finalize = true);
+
 /**  Reduces the size of the PSBT by dropping unnecessary `non_witness_utxos` (i.e. complete previous transactions) from a psbt when all inputs are segwit v1. */
 void RemoveUnnecessaryTransactions(PartiallySignedTransaction& psbtx);
 
@@ -418,6 +418,37 @@ bool CExtPubKey::Derive(CExtPubKey &out, unsigned int _nChild) const {
     return pubkey.Derive(out.pubkey, out.chaincode, _nChild, chaincode);
 }
 
+bool CExtPubKey::Derive(std::span<const unsigned int> children, std::vector<CExtPubKey>& out) const {
+    if (nDepth == std::numeric_limits<unsigned char>::max()) return false;
+    assert(pubkey.IsValid());
+    assert(pubkey.size() == CPubKey::COMPRESSED_SIZE);
+    for (const unsigned int child : children) assert((child >> 31) == 0);
+    std::vector<unsigned char> hashes(children.size() * 64);
+    BIP32Hash(chaincode, children, *pubkey.begin(), pubkey.begin() + 1, hashes.data());
+    secp256k1_pubkey parent;
+    if (!secp256k1_ec_pubkey_parse(secp256k1_context_static, &parent, pubkey.data(), pubkey.size())) {
+        return false;
+    }
+    const CKeyID id = pubkey.GetID();
+    out.reserve(out.size() + children.size());
+    for (size_t i = 0; i < children.size(); ++i) {
+        secp256k1_pubkey child_pubkey{parent};
+        if (!secp256k1_ec_pubkey_tweak_add(secp256k1_context_static, &child_pubkey, hashes.data() + i * 64)) {
+            return false;
+        }
+        CExtPubKey& child = out.emplace_back();
+        child.nDepth = nDepth + 1;
+        memcpy(child.vchFingerprint, &id, 4);
+        child.nChild = children[i];
+        memcpy(child.chaincode.begin(), hashes.data() + i * 64 + 32, 32);
+        unsigned char pub[CPubKey::COMPRESSED_SIZE];
+        size_t publen = CPubKey::COMPRESSED_SIZE;
+        secp256k1_ec_pubkey_serialize(secp256k1_context_static, pub, &publen, &child_pubkey, SECP256K1_EC_COMPRESSED);
+        child.pubkey.Set(pub, pub + publen);
+    }
+    return true;
+}
+
 /* static */ bool CPubKey::CheckLowS(const std::vector<unsigned char>& vchSig) {
     secp256k1_ecdsa_signature sig;
     if (!ecdsa_signature_parse_der_lax(&sig, vchSig.data(), vchSig.size())) {
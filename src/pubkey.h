@@ -380,6 +380,8 @@ struct CExtPubKey {
     void EncodeWithVersion(unsigned char code[BIP32_EXTKEY_WITH_VERSION_SIZE]) const;
     void DecodeWithVersion(const unsigned char code[BIP32_EXTKEY_WITH_VERSION_SIZE]);
     [[nodiscard]] bool Derive(CExtPubKey& out, unsigned int nChild) const;
+    //! Derive several non-hardened children at once, appending them to out.
+    [[nodiscard]] bool Derive(std::span<const unsigned int> children, std::vector<CExtPubKey>& out) const;
 };
 
 #endif // BITCOIN_PUBKEY_H
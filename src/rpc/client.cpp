@@ -279,6 +279,8 @@ static const CRPCConvertParam vRPCConvertParams[] =
     { "psbtbumpfee", 1, "original_change_index"},
     { "logging", 0, "include" },
     { "logging", 1, "exclude" },
+    { "getperfcounters", 0, "enable" },
+    { "getperfcounters", 1, "reset" },
     { "disconnectnode", 1, "nodeid" },
     { "gethdkeys", 0, "active_only" },
     { "gethdkeys", 0, "options" },
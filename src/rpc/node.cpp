@@ -24,6 +24,7 @@
 #include <univalue.h>
 #include <util/any.h>
 #include <util/check.h>
+#include <util/perfcounters.h>
 #include <util/time.h>
 
 #include <cstdint>
@@ -271,6 +272,87 @@ static RPCHelpMan logging()
     };
 }
 
+static RPCHelpMan getperfcounters()
+{
+    return RPCHelpMan{"getperfcounters",
+            "Returns the timing histograms collected by the built-in performance counters.\n"
+            "Counters are kept per thread and per timed code path (ConnectBlock phases, messages by type, mempool acceptance, "
+            "chainstate flushes, LevelDB reads and HTTP handlers). Collection is off unless started with -perfcounters or enabled here.\n",
+                {
+                    {"enable", RPCArg::Type::BOOL, RPCArg::Optional::OMITTED, "Start (true) or stop (false) collecting counters"},
+                    {"reset", RPCArg::Type::BOOL, RPCArg::Default{false}, "Clear the counters after returning them"},
+                },
+                RPCResult{
+                    RPCResult::Type::OBJ, "", "",
+                    {
+                        {RPCResult::Type::BOOL, "enabled", "whether counters are being collected"},
+                        {RPCResult::Type::ARR, "threads", "",
+                        {
+                            {RPCResult::Type::OBJ, "", "",
+                            {
+                                {RPCResult::Type::STR, "thread", "thread name"},
+                                {RPCResult::Type::ARR, "timers", "",
+                                {
+                                    {RPCResult::Type::OBJ, "", "",
+                                    {
+                                        {RPCResult::Type::STR, "group", "area of the code, e.g. validation, net, leveldb, http"},
+                                        {RPCResult::Type::STR, "name", "timed code path, message type or HTTP prefix"},
+                                        {RPCResult::Type::NUM, "count", "number of recorded durations"},
+                                        {RPCResult::Type::NUM, "total_us", "sum of recorded durations in microseconds"},
+                                        {RPCResult::Type::NUM, "max_us", "longest recorded duration in microseconds"},
+                                        {RPCResult::Type::ARR, "histogram", "entry 0 counts durations below 1us, entry i those of [2^(i-1), 2^i) microseconds, the last entry everything above",
+                                        {
+                                            {RPCResult::Type::NUM, "", "count"},
+                                        }},
+                                    }},
+                                }},
+                            }},
+                        }},
+                    }
+                },
+                RPCExamples{
+                    HelpExampleCli("getperfcounters", "true")
+            + HelpExampleCli("getperfcounters", "null true")
+            + HelpExampleRpc("getperfcounters", "")
+                },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    if (!request.params[0].isNull()) {
+        perf::SetEnabled(request.params[0].get_bool());
+    }
+    const bool reset{request.params[1].isNull() ? false : request.params[1].get_bool()};
+
+    UniValue threads(UniValue::VARR);
+    for (const perf::ThreadStats& thread : perf::Snapshot(reset)) {
+        UniValue timers(UniValue::VARR);
+        for (const perf::TimerStats& timer : thread.timers) {
+            UniValue histogram(UniValue::VARR);
+            for (const uint64_t count : timer.histogram.buckets) {
+                histogram.push_back(count);
+            }
+            UniValue entry(UniValue::VOBJ);
+            entry.pushKV("group", timer.group);
+            entry.pushKV("name", timer.name);
+            entry.pushKV("count", timer.histogram.count);
+            entry.pushKV("total_us", Ticks<std::chrono::microseconds>(timer.histogram.total));
+            entry.pushKV("max_us", Ticks<std::chrono::microseconds>(timer.histogram.max));
+            entry.pushKV("histogram", std::move(histogram));
+            timers.push_back(std::move(entry));
+        }
+        UniValue obj(UniValue::VOBJ);
+        obj.pushKV("thread", thread.thread_name);
+        obj.pushKV("timers", std::move(timers));
+        threads.push_back(std::move(obj));
+    }
+
+    UniValue result(UniValue::VOBJ);
+    result.pushKV("enabled", perf::Enabled());
+    result.pushKV("threads", std::move(threads));
+    return result;
+},
+    };
+}
+
 static RPCHelpMan echo(const std::string& name)
 {
     return RPCHelpMan{
@@ -409,6 +491,7 @@ void RegisterNodeRPCCommands(CRPCTable& t)
     static const CRPCCommand commands[]{
         {"control", &getmemoryinfo},
         {"control", &logging},
+        {"control", &getperfcounters},
         {"util", &getindexinfo},
         {"hidden", &setmocktime},
         {"hidden", &mockscheduler},
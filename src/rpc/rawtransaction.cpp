@@ -229,17 +229,21 @@ PartiallySignedTransaction ProcessPSBT(const std::string& psbt_string, const std
 
     const PrecomputedTransactionData& txdata = PrecomputePSBTData(psbtx);
 
+    std::vector<PSBTInputSigningJob> jobs;
     for (unsigned int i = 0; i < psbtx.tx->vin.size(); ++i) {
         if (PSBTInputSigned(psbtx.inputs.at(i))) {
             continue;
         }
+        jobs.push_back({i, &provider, sighash_type});
+    }
 
-        // Update script/keypath information using descriptor data.
-        // Note that SignPSBTInput does a lot more than just constructing ECDSA signatures.
-        // We only actually care about those if our signing provider doesn't hide private
-        // information, as is the case with `descriptorprocesspsbt`
-        // Only error for mismatching sighash types as it is critical that the sighash to sign with matches the PSBT's
-        if (SignPSBTInput(provider, psbtx, /*index=*/i, &txdata, sighash_type, /*out_sigdata=*/nullptr, finalize) == common::PSBTError::SIGHASH_MISMATCH) {
+    // Update script/keypath information using descriptor data.
+    // Note that SignPSBTInput does a lot more than just constructing ECDSA signatures.
+    // We only actually care about those if our signing provider doesn't hide private
+    // information, as is the case with `descriptorprocesspsbt`
+    // Only error for mismatching sighash types as it is critical that the sighash to sign with matches the PSBT's
+    for (const common::PSBTError res : SignPSBTInputs(psbtx, jobs, &txdata, finalize)) {
+        if (res == common::PSBTError::SIGHASH_MISMATCH) {
             throw JSONRPCPSBTError(common::PSBTError::SIGHASH_MISMATCH);
         }
     }
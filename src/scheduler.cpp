@@ -29,37 +29,48 @@ void CScheduler::serviceQueue()
     // when the thread is waiting or when the user's function
     // is called.
     while (!shouldStop()) {
+        bool running_low{false};
         try {
-            while (!shouldStop() && taskQueue.empty()) {
-                // Wait until there is something to do.
-                newTaskScheduled.wait(lock);
+            // Pick the highest priority task that is due and that this thread
+            // may run, otherwise wait until the next task is due or a new task
+            // is scheduled. If there are multiple threads, the queue can change
+            // while we're waiting (another thread may service the task we were
+            // waiting on), so start over after waking up.
+            const auto now{std::chrono::steady_clock::now()};
+            auto next{taskQueue.end()};
+            for (auto it{taskQueue.begin()}; it != taskQueue.end() && it->first <= now; ++it) {
+                if (!CanRun(it->second.priority)) continue;
+                if (next == taskQueue.end() || it->second.priority < next->second.priority) next = it;
+                if (next->second.priority == Priority::HIGH) break;
             }
-
-            // Wait until either there is a new task, or until
-            // the time of the first item on the queue:
-
-            while (!shouldStop() && !taskQueue.empty()) {
-                std::chrono::steady_clock::time_point timeToWaitFor = taskQueue.begin()->first;
-                if (newTaskScheduled.wait_until(lock, timeToWaitFor) == std::cv_status::timeout) {
-                    break; // Exit loop after timeout, it means we reached the time of the event
+            if (next == taskQueue.end()) {
+                const auto first_pending{taskQueue.upper_bound(now)};
+                if (first_pending == taskQueue.end()) {
+                    newTaskScheduled.wait(lock);
+                } else {
+                    newTaskScheduled.wait_until(lock, first_pending->first);
                 }
-            }
-
-            // If there are multiple threads, the queue can empty while we're waiting (another
-            // thread may service the task we were waiting on).
-            if (shouldStop() || taskQueue.empty())
                 continue;
+            }
 
-            Function f = taskQueue.begin()->second;
-            taskQueue.erase(taskQueue.begin());
+            Task task{std::move(next->second)};
+            taskQueue.erase(next);
+            running_low = task.priority == Priority::LOW;
+            if (running_low) ++m_low_running;
 
             {
                 // Unlock before calling f, so it can reschedule itself or another task
                 // without deadlocking:
                 REVERSE_LOCK(lock, newTaskMutex);
-                f();
+                task.f();
+            }
+            if (running_low) {
+                --m_low_running;
+                // Another thread may be waiting for a LOW task slot.
+                newTaskScheduled.notify_one();
             }
         } catch (...) {
+            if (running_low) --m_low_running;
             --nThreadsServicingQueue;
             throw;
         }
@@ -68,11 +79,11 @@ void CScheduler::serviceQueue()
     newTaskScheduled.notify_one();
 }
 
-void CScheduler::schedule(CScheduler::Function f, std::chrono::steady_clock::time_point t)
+void CScheduler::schedule(CScheduler::Function f, std::chrono::steady_clock::time_point t, Priority priority)
 {
     {
         LOCK(newTaskMutex);
-        taskQueue.insert(std::make_pair(t, f));
+        taskQueue.emplace(t, Task{std::move(f), priority});
     }
     newTaskScheduled.notify_one();
 }
@@ -85,7 +96,7 @@ void CScheduler::MockForward(std::chrono::seconds delta_seconds)
         LOCK(newTaskMutex);
 
         // use temp_queue to maintain updated schedule
-        std::multimap<std::chrono::steady_clock::time_point, Function> temp_queue;
+        std::multimap<std::chrono::steady_clock::time_point, Task> temp_queue;
 
         for (const auto& element : taskQueue) {
             temp_queue.emplace_hint(temp_queue.cend(), element.first - delta_seconds, element.second);
@@ -99,15 +110,15 @@ void CScheduler::MockForward(std::chrono::seconds delta_seconds)
     newTaskScheduled.notify_one();
 }
 
-static void Repeat(CScheduler& s, CScheduler::Function f, std::chrono::milliseconds delta)
+static void Repeat(CScheduler& s, CScheduler::Function f, std::chrono::milliseconds delta, CScheduler::Priority priority)
 {
     f();
-    s.scheduleFromNow([=, &s] { Repeat(s, f, delta); }, delta);
+    s.scheduleFromNow([=, &s] { Repeat(s, f, delta, priority); }, delta, priority);
 }
 
-void CScheduler::scheduleEvery(CScheduler::Function f, std::chrono::milliseconds delta)
+void CScheduler::scheduleEvery(CScheduler::Function f, std::chrono::milliseconds delta, Priority priority)
 {
-    scheduleFromNow([this, f, delta] { Repeat(*this, f, delta); }, delta);
+    scheduleFromNow([this, f, delta, priority] { Repeat(*this, f, delta, priority); }, delta, priority);
 }
 
 size_t CScheduler::getQueueInfo(std::chrono::steady_clock::time_point& first,
@@ -139,7 +150,7 @@ void SerialTaskRunner::MaybeScheduleProcessQueue()
         if (m_are_callbacks_running) return;
         if (m_callbacks_pending.empty()) return;
     }
-    m_scheduler.schedule([this] { this->ProcessQueue(); }, std::chrono::steady_clock::now());
+    m_scheduler.schedule([this] { this->ProcessQueue(); }, std::chrono::steady_clock::now(), m_priority);
 }
 
 void SerialTaskRunner::ProcessQueue()
@@ -18,6 +18,7 @@
 #include <map>
 #include <thread>
 #include <utility>
+#include <vector>
 
 /**
  * Simple class for background tasks that should be run
@@ -35,6 +36,11 @@
  * t->join();
  * delete t;
  * delete s; // Must be done after thread is interrupted/joined.
+ *
+ * Several threads may service the queue. Among the tasks that are due, the one
+ * with the highest Priority runs first. Priority::LOW tasks never take the
+ * last idle thread when more than one thread services the queue, so slow
+ * maintenance jobs cannot hold up time-sensitive work.
  */
 class CScheduler
 {
@@ -43,16 +49,24 @@ public:
     ~CScheduler();
 
     std::thread m_service_thread;
+    //! Additional threads running serviceQueue(), joined by stop() and StopWhenDrained().
+    std::vector<std::thread> m_worker_threads;
 
     typedef std::function<void()> Function;
 
+    enum class Priority {
+        HIGH,   //!< Latency sensitive, e.g. validation interface notifications
+        NORMAL,
+        LOW,    //!< Background maintenance such as periodic dumps to disk
+    };
+
     /** Call func at/after time t */
-    void schedule(Function f, std::chrono::steady_clock::time_point t) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
+    void schedule(Function f, std::chrono::steady_clock::time_point t, Priority priority = Priority::NORMAL) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
 
     /** Call f once after the delta has passed */
-    void scheduleFromNow(Function f, std::chrono::milliseconds delta) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex)
+    void scheduleFromNow(Function f, std::chrono::milliseconds delta, Priority priority = Priority::NORMAL) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex)
     {
-        schedule(std::move(f), std::chrono::steady_clock::now() + delta);
+        schedule(std::move(f), std::chrono::steady_clock::now() + delta, priority);
     }
 
     /**
@@ -61,7 +75,7 @@ public:
      * The timing is not exact: Every time f is finished, it is rescheduled to run again after delta. If you need more
      * accurate scheduling, don't use this method.
      */
-    void scheduleEvery(Function f, std::chrono::milliseconds delta) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
+    void scheduleEvery(Function f, std::chrono::milliseconds delta, Priority priority = Priority::NORMAL) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
 
     /**
      * Mock the scheduler to fast forward in time.
@@ -80,14 +94,14 @@ public:
     {
         WITH_LOCK(newTaskMutex, stopRequested = true);
         newTaskScheduled.notify_all();
-        if (m_service_thread.joinable()) m_service_thread.join();
+        JoinThreads();
     }
     /** Tell any threads running serviceQueue to stop when there is no work left to be done */
     void StopWhenDrained() EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex)
     {
         WITH_LOCK(newTaskMutex, stopWhenEmpty = true);
         newTaskScheduled.notify_all();
-        if (m_service_thread.joinable()) m_service_thread.join();
+        JoinThreads();
     }
 
     /**
@@ -102,13 +116,33 @@ public:
     bool AreThreadsServicingQueue() const EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
 
 private:
+    struct Task {
+        Function f;
+        Priority priority;
+    };
+
     mutable Mutex newTaskMutex;
     std::condition_variable newTaskScheduled;
-    std::multimap<std::chrono::steady_clock::time_point, Function> taskQueue GUARDED_BY(newTaskMutex);
+    std::multimap<std::chrono::steady_clock::time_point, Task> taskQueue GUARDED_BY(newTaskMutex);
     int nThreadsServicingQueue GUARDED_BY(newTaskMutex){0};
+    //! Number of Priority::LOW tasks currently executing
+    int m_low_running GUARDED_BY(newTaskMutex){0};
     bool stopRequested GUARDED_BY(newTaskMutex){false};
     bool stopWhenEmpty GUARDED_BY(newTaskMutex){false};
     bool shouldStop() const EXCLUSIVE_LOCKS_REQUIRED(newTaskMutex) { return stopRequested || (stopWhenEmpty && taskQueue.empty()); }
+    bool CanRun(Priority priority) const EXCLUSIVE_LOCKS_REQUIRED(newTaskMutex)
+    {
+        return priority != Priority::LOW || nThreadsServicingQueue <= 1 || m_low_running < nThreadsServicingQueue - 1;
+    }
+
+    void JoinThreads()
+    {
+        if (m_service_thread.joinable()) m_service_thread.join();
+        for (std::thread& t : m_worker_threads) {
+            if (t.joinable()) t.join();
+        }
+        m_worker_threads.clear();
+    }
 };
 
 /**
@@ -125,6 +159,7 @@ class SerialTaskRunner : public util::TaskRunnerInterface
 {
 private:
     CScheduler& m_scheduler;
+    const CScheduler::Priority m_priority;
 
     Mutex m_callbacks_mutex;
 
@@ -138,7 +173,8 @@ private:
     void ProcessQueue() EXCLUSIVE_LOCKS_REQUIRED(!m_callbacks_mutex);
 
 public:
-    explicit SerialTaskRunner(CScheduler& scheduler LIFETIMEBOUND) : m_scheduler{scheduler} {}
+    explicit SerialTaskRunner(CScheduler& scheduler LIFETIMEBOUND, CScheduler::Priority priority = CScheduler::Priority::NORMAL)
+        : m_scheduler{scheduler}, m_priority{priority} {}
 
     /**
      * Add a callback to be executed. Callbacks are executed serially
@@ -190,6 +190,20 @@ public:
      */
     virtual std::optional<CPubKey> GetPubKey(int pos, const SigningProvider& arg, FlatSigningProvider& out, const DescriptorCache* read_cache = nullptr, DescriptorCache* write_cache = nullptr) const = 0;
 
+    /** Derive the public keys for every position in [begin, end), appending them to pubkeys.
+     *  out must have one entry per position, which receives what GetPubKey would put into out.
+     *  Implementations may share derivation work between the positions.
+     */
+    virtual bool GetPubKeys(int begin, int end, const SigningProvider& arg, std::span<FlatSigningProvider> out, std::vector<CPubKey>& pubkeys, const DescriptorCache* read_cache = nullptr, DescriptorCache* write_cache = nullptr) const
+    {
+        for (int pos = begin; pos < end; ++pos) {
+            std::optional<CPubKey> pubkey = GetPubKey(pos, arg, out[pos - begin], read_cache, write_cache);
+            if (!pubkey) return false;
+            pubkeys.push_back(*pubkey);
+        }
+        return true;
+    }
+
     /** Whether this represent multiple public keys at different positions. */
     virtual bool IsRange() const = 0;
 
@@ -253,6 +267,20 @@ public:
         suborigin.path.insert(suborigin.path.begin(), m_origin.path.begin(), m_origin.path.end());
         return pub;
     }
+    bool GetPubKeys(int begin, int end, const SigningProvider& arg, std::span<FlatSigningProvider> out, std::vector<CPubKey>& pubkeys, const DescriptorCache* read_cache = nullptr, DescriptorCache* write_cache = nullptr) const override
+    {
+        const size_t offset{pubkeys.size()};
+        if (!m_provider->GetPubKeys(begin, end, arg, out, pubkeys, read_cache, write_cache)) return false;
+        for (size_t i = 0; i < out.size(); ++i) {
+            const CPubKey& pub{pubkeys.at(offset + i)};
+            Assert(out[i].pubkeys.contains(pub.GetID()));
+            auto& [pubkey, suborigin] = out[i].origins[pub.GetID()];
+            Assert(pubkey == pub); // m_provider must have a valid origin by this point.
+            std::copy(std::begin(m_origin.fingerprint), std::end(m_origin.fingerprint), suborigin.fingerprint);
+            suborigin.path.insert(suborigin.path.begin(), m_origin.path.begin(), m_origin.path.end());
+        }
+        return true;
+    }
     bool IsRange() const override { return m_provider->IsRange(); }
     size_t GetSize() const override { return m_provider->GetSize(); }
     bool IsBIP32() const override { return m_provider->IsBIP32(); }
@@ -474,6 +502,75 @@ public:
 
         return final_extkey.pubkey;
     }
+    bool GetPubKeys(int begin, int end, const SigningProvider& arg, std::span<FlatSigningProvider> out, std::vector<CPubKey>& pubkeys, const DescriptorCache* read_cache = nullptr, DescriptorCache* write_cache = nullptr) const override
+    {
+        // Expanding from a cache only costs the final derivation step per position already.
+        if (read_cache || !IsRange()) return PubkeyProvider::GetPubKeys(begin, end, arg, out, pubkeys, read_cache, write_cache);
+
+        // Derive the parent of all positions once, instead of walking m_path again for each of them.
+        const bool hardened{IsHardened()};
+        CExtKey parent_xprv;
+        CExtPubKey parent_extkey = m_root_extkey;
+        CExtPubKey last_hardened_extkey;
+        if (hardened) {
+            CExtKey lh_xprv;
+            if (!GetDerivedExtKey(arg, parent_xprv, lh_xprv)) return false;
+            parent_extkey = parent_xprv.Neuter();
+            if (lh_xprv.key.IsValid()) {
+                last_hardened_extkey = lh_xprv.Neuter();
+            }
+        } else {
+            for (auto entry : m_path) {
+                if (!parent_extkey.Derive(parent_extkey, entry)) return false;
+            }
+        }
+
+        KeyOriginInfo info;
+        CKeyID keyid = m_root_extkey.pubkey.GetID();
+        std::copy(keyid.begin(), keyid.begin() + sizeof(info.fingerprint), info.fingerprint);
+        info.path = m_path;
+        info.path.push_back(0);
+
+        // All positions share the parent, so their HMACs can be computed together.
+        std::vector<unsigned int> children;
+        children.reserve(end - begin);
+        for (int pos = begin; pos < end; ++pos) {
+            children.push_back(m_derive == DeriveType::HARDENED ? ((uint32_t)pos) | 0x80000000U : (uint32_t)pos);
+        }
+        std::vector<CExtPubKey> derived;
+        if (m_derive == DeriveType::HARDENED) {
+            std::vector<CExtKey> derived_xprv;
+            if (!parent_xprv.Derive(children, derived_xprv)) return false;
+            derived.reserve(derived_xprv.size());
+            for (const CExtKey& xprv : derived_xprv) derived.push_back(xprv.Neuter());
+        } else {
+            if (!parent_extkey.Derive(children, derived)) return false;
+        }
+
+        for (int pos = begin; pos < end; ++pos) {
+            const uint32_t child = children[pos - begin];
+            const CExtPubKey& final_extkey = derived[pos - begin];
+            info.path.back() = child;
+
+            FlatSigningProvider& pos_out = out[pos - begin];
+            pos_out.origins.emplace(final_extkey.pubkey.GetID(), std::make_pair(final_extkey.pubkey, info));
+            pos_out.pubkeys.emplace(final_extkey.pubkey.GetID(), final_extkey.pubkey);
+            if (write_cache && m_derive == DeriveType::HARDENED) {
+                write_cache->CacheDerivedExtPubKey(m_expr_index, pos, final_extkey);
+            }
+            pubkeys.push_back(final_extkey.pubkey);
+        }
+
+        // Only cache parent if there is any unhardened derivation
+        if (write_cache && m_derive != DeriveType::HARDENED) {
+            write_cache->CacheParentExtPubKey(m_expr_index, parent_extkey);
+            // Cache last hardened xpub if we have it
+            if (last_hardened_extkey.pubkey.IsValid()) {
+                write_cache->CacheLastHardenedExtPubKey(m_expr_index, last_hardened_extkey);
+            }
+        }
+        return true;
+    }
     std::string ToString(StringType type, bool normalized) const
     {
         // If StringType==COMPAT, always use the apostrophe to stay compatible with previous versions
@@ -945,6 +1042,49 @@ public:
         return true;
     }
 
+    // NOLINTNEXTLINE(misc-no-recursion)
+    bool ExpandRangeHelper(int begin, int end, const SigningProvider& arg, const DescriptorCache* read_cache, std::vector<std::vector<CScript>>& output_scripts, std::span<FlatSigningProvider> out, DescriptorCache* write_cache) const
+    {
+        const size_t count = out.size();
+        std::vector<FlatSigningProvider> subproviders(count);
+        std::vector<std::vector<CPubKey>> pubkeys(count);
+
+        // Derive each key for all positions at once, so that it can share work between them.
+        std::vector<CPubKey> range_pubkeys;
+        range_pubkeys.reserve(count);
+        for (const auto& p : m_pubkey_args) {
+            range_pubkeys.clear();
+            if (!p->GetPubKeys(begin, end, arg, subproviders, range_pubkeys, read_cache, write_cache)) return false;
+            for (size_t i = 0; i < count; ++i) {
+                pubkeys[i].push_back(range_pubkeys[i]);
+            }
+        }
+        std::vector<std::vector<CScript>> subscripts(count);
+        for (const auto& subarg : m_subdescriptor_args) {
+            std::vector<std::vector<CScript>> outscripts;
+            if (!subarg->ExpandRangeHelper(begin, end, arg, read_cache, outscripts, subproviders, write_cache)) return false;
+            for (size_t i = 0; i < count; ++i) {
+                assert(outscripts[i].size() == 1);
+                subscripts[i].emplace_back(std::move(outscripts[i][0]));
+            }
+        }
+
+        output_scripts.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            out[i].Merge(std::move(subproviders[i]));
+            output_scripts[i] = MakeScripts(pubkeys[i], std::span{subscripts[i]}, out[i]);
+        }
+        return true;
+    }
+
+    bool ExpandRange(int begin, int end, const SigningProvider& provider, const DescriptorCache* read_cache, std::vector<std::vector<CScript>>& output_scripts, std::vector<FlatSigningProvider>& out, DescriptorCache* write_cache = nullptr) const final
+    {
+        std::vector<FlatSigningProvider> range_out(std::max(end - begin, 0));
+        if (!ExpandRangeHelper(begin, end, read_cache ? DUMMY_SIGNING_PROVIDER : provider, read_cache, output_scripts, range_out, write_cache)) return false;
+        out = std::move(range_out);
+        return true;
+    }
+
     bool Expand(int pos, const SigningProvider& provider, std::vector<CScript>& output_scripts, FlatSigningProvider& out, DescriptorCache* write_cache = nullptr) const final
     {
         return ExpandHelper(pos, provider, nullptr, output_scripts, out, write_cache);
@@ -136,6 +136,22 @@ struct Descriptor {
      */
     virtual bool ExpandFromCache(int pos, const DescriptorCache& read_cache, std::vector<CScript>& output_scripts, FlatSigningProvider& out) const = 0;
 
+    /** Expand a descriptor at every position in [begin, end) in one pass.
+     *
+     * The result is the same as calling Expand (or ExpandFromCache, if read_cache is given) for each
+     * position, but derivation steps shared by all positions, such as the BIP32 path up to the ranged
+     * step, are only computed once.
+     *
+     * @param[in] begin The first position to expand.
+     * @param[in] end One past the last position to expand.
+     * @param[in] provider The provider to query for private keys in case of hardened derivation. Ignored if read_cache is given.
+     * @param[in] read_cache Cached expansion data to expand from instead of the keys in provider, or nullptr.
+     * @param[out] output_scripts The expanded scriptPubKeys, one entry per position.
+     * @param[out] out Scripts and public keys necessary for solving the expanded scriptPubKeys, one entry per position.
+     * @param[out] write_cache Cache data necessary to evaluate the descriptor at these positions without access to private keys.
+     */
+    virtual bool ExpandRange(int begin, int end, const SigningProvider& provider, const DescriptorCache* read_cache, std::vector<std::vector<CScript>>& output_scripts, std::vector<FlatSigningProvider>& out, DescriptorCache* write_cache = nullptr) const = 0;
+
     /** Expand the private key for a descriptor at a specified position, if possible.
      *
      * @param[in] pos The position at which to expand the descriptor. If IsRange() is false, this is ignored.
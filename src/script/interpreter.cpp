@@ -60,6 +60,58 @@ static inline void popstack(std::vector<valtype>& stack)
     stack.pop_back();
 }
 
+namespace {
+/**
+ * Keeps the buffers of elements popped off the stacks during a single EvalScript call,
+ * so that elements pushed later on can reuse them instead of allocating. Stack elements
+ * are small and short-lived (signatures, keys, hashes, numbers), so a handful of
+ * recycled buffers serves nearly all pushes of a script.
+ */
+class StackElementPool
+{
+    //! Number of buffers kept around at most
+    static constexpr size_t MAX_FREE{32};
+
+    std::vector<valtype> m_free;
+
+public:
+    //! Return an empty element, reusing a recycled buffer if there is one
+    valtype Take()
+    {
+        if (m_free.empty()) return {};
+        valtype element{std::move(m_free.back())};
+        m_free.pop_back();
+        element.clear();
+        return element;
+    }
+
+    valtype Copy(std::span<const unsigned char> data)
+    {
+        valtype element{Take()};
+        element.assign(data.begin(), data.end());
+        return element;
+    }
+
+    valtype Num(const CScriptNum& num)
+    {
+        valtype element{Take()};
+        num.getvch(element);
+        return element;
+    }
+
+    //! Pop the top element off stack, keeping its buffer
+    void Pop(std::vector<valtype>& stack)
+    {
+        if (stack.empty())
+            throw std::runtime_error("popstack(): stack empty");
+        if (stack.back().capacity() > 0 && m_free.size() < MAX_FREE) {
+            m_free.push_back(std::move(stack.back()));
+        }
+        stack.pop_back();
+    }
+};
+} // namespace
+
 bool static IsCompressedOrUncompressedPubKey(const valtype &vchPubKey) {
     if (vchPubKey.size() < CPubKey::COMPRESSED_SIZE) {
         //  Non-canonical public key: too short
@@ -343,7 +395,7 @@ static bool EvalChecksigPreTapscript(const valtype& vchSig, const valtype& vchPu
     return true;
 }
 
-static bool EvalChecksigTapscript(const valtype& sig, const valtype& pubkey, ScriptExecutionData& execdata, unsigned int flags, const BaseSignatureChecker& checker, SigVersion sigversion, ScriptError* serror, bool& success)
+static bool EvalChecksigTapscript(std::span<const unsigned char> sig, std::span<const unsigned char> pubkey, ScriptExecutionData& execdata, unsigned int flags, const BaseSignatureChecker& checker, SigVersion sigversion, ScriptError* serror, bool& success)
 {
     assert(sigversion == SigVersion::TAPSCRIPT);
 
@@ -420,6 +472,7 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
     CScript::const_iterator pend = script.end();
     CScript::const_iterator pbegincodehash = script.begin();
     opcodetype opcode;
+    StackElementPool pool;
     valtype vchPushValue;
     ConditionStack vfExec;
     std::vector<valtype> altstack;
@@ -478,7 +531,9 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                 if (fRequireMinimal && !CheckMinimalPush(vchPushValue, opcode)) {
                     return set_error(serror, SCRIPT_ERR_MINIMALDATA);
                 }
-                stack.push_back(vchPushValue);
+                // Hand the buffer over to the stack, the next opcode is read into a recycled one
+                stack.push_back(std::move(vchPushValue));
+                vchPushValue = pool.Take();
             } else if (fExec || (OP_IF <= opcode && opcode <= OP_ENDIF))
             switch (opcode)
             {
@@ -505,7 +560,7 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                 {
                     // ( -- value)
                     CScriptNum bn((int)opcode - (int)(OP_1 - 1));
-                    stack.push_back(bn.getvch());
+                    stack.push_back(pool.Num(bn));
                     // The result of these opcodes should always be the minimal way to push the data
                     // they push, so no need for a CheckMinimalPush here.
                 }
@@ -627,7 +682,7 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                         fValue = CastToBool(vch);
                         if (opcode == OP_NOTIF)
                             fValue = !fValue;
-                        popstack(stack);
+                        pool.Pop(stack);
                     }
                     vfExec.push_back(fValue);
                 }
@@ -657,7 +712,7 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
                     bool fValue = CastToBool(stacktop(-1));
                     if (fValue)
-                        popstack(stack);
+                        pool.Pop(stack);
                     else
                         return set_error(serror, SCRIPT_ERR_VERIFY);
                 }
@@ -677,8 +732,8 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                 {
                     if (stack.size() < 1)
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
-                    altstack.push_back(stacktop(-1));
-                    popstack(stack);
+                    altstack.push_back(std::move(stacktop(-1)));
+                    pool.Pop(stack);
                 }
                 break;
 
@@ -686,8 +741,8 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                 {
                     if (altstack.size() < 1)
                         return set_error(serror, SCRIPT_ERR_INVALID_ALTSTACK_OPERATION);
-                    stack.push_back(altstacktop(-1));
-                    popstack(altstack);
+                    stack.push_back(std::move(altstacktop(-1)));
+                    pool.Pop(altstack);
                 }
                 break;
 
@@ -696,8 +751,8 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     // (x1 x2 -- )
                     if (stack.size() < 2)
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
-                    popstack(stack);
-                    popstack(stack);
+                    pool.Pop(stack);
+                    pool.Pop(stack);
                 }
                 break;
 
@@ -706,10 +761,10 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     // (x1 x2 -- x1 x2 x1 x2)
                     if (stack.size() < 2)
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
-                    valtype vch1 = stacktop(-2);
-                    valtype vch2 = stacktop(-1);
-                    stack.push_back(vch1);
-                    stack.push_back(vch2);
+                    valtype vch1{pool.Copy(stacktop(-2))};
+                    valtype vch2{pool.Copy(stacktop(-1))};
+                    stack.push_back(std::move(vch1));
+                    stack.push_back(std::move(vch2));
                 }
                 break;
 
@@ -718,12 +773,12 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     // (x1 x2 x3 -- x1 x2 x3 x1 x2 x3)
                     if (stack.size() < 3)
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
-                    valtype vch1 = stacktop(-3);
-                    valtype vch2 = stacktop(-2);
-                    valtype vch3 = stacktop(-1);
-                    stack.push_back(vch1);
-                    stack.push_back(vch2);
-                    stack.push_back(vch3);
+                    valtype vch1{pool.Copy(stacktop(-3))};
+                    valtype vch2{pool.Copy(stacktop(-2))};
+                    valtype vch3{pool.Copy(stacktop(-1))};
+                    stack.push_back(std::move(vch1));
+                    stack.push_back(std::move(vch2));
+                    stack.push_back(std::move(vch3));
                 }
                 break;
 
@@ -732,10 +787,10 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     // (x1 x2 x3 x4 -- x1 x2 x3 x4 x1 x2)
                     if (stack.size() < 4)
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
-                    valtype vch1 = stacktop(-4);
-                    valtype vch2 = stacktop(-3);
-                    stack.push_back(vch1);
-                    stack.push_back(vch2);
+                    valtype vch1{pool.Copy(stacktop(-4))};
+                    valtype vch2{pool.Copy(stacktop(-3))};
+                    stack.push_back(std::move(vch1));
+                    stack.push_back(std::move(vch2));
                 }
                 break;
 
@@ -744,11 +799,11 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     // (x1 x2 x3 x4 x5 x6 -- x3 x4 x5 x6 x1 x2)
                     if (stack.size() < 6)
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
-                    valtype vch1 = stacktop(-6);
-                    valtype vch2 = stacktop(-5);
+                    valtype vch1{std::move(stacktop(-6))};
+                    valtype vch2{std::move(stacktop(-5))};
                     stack.erase(stack.end()-6, stack.end()-4);
-                    stack.push_back(vch1);
-                    stack.push_back(vch2);
+                    stack.push_back(std::move(vch1));
+                    stack.push_back(std::move(vch2));
                 }
                 break;
 
@@ -767,9 +822,8 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     // (x - 0 | x x)
                     if (stack.size() < 1)
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
-                    valtype vch = stacktop(-1);
-                    if (CastToBool(vch))
-                        stack.push_back(vch);
+                    if (CastToBool(stacktop(-1)))
+                        stack.push_back(pool.Copy(stacktop(-1)));
                 }
                 break;
 
@@ -777,7 +831,7 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                 {
                     // -- stacksize
                     CScriptNum bn(stack.size());
-                    stack.push_back(bn.getvch());
+                    stack.push_back(pool.Num(bn));
                 }
                 break;
 
@@ -786,7 +840,7 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     // (x -- )
                     if (stack.size() < 1)
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
-                    popstack(stack);
+                    pool.Pop(stack);
                 }
                 break;
 
@@ -795,8 +849,8 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     // (x -- x x)
                     if (stack.size() < 1)
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
-                    valtype vch = stacktop(-1);
-                    stack.push_back(vch);
+                    valtype vch{pool.Copy(stacktop(-1))};
+                    stack.push_back(std::move(vch));
                 }
                 break;
 
@@ -814,8 +868,8 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     // (x1 x2 -- x1 x2 x1)
                     if (stack.size() < 2)
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
-                    valtype vch = stacktop(-2);
-                    stack.push_back(vch);
+                    valtype vch{pool.Copy(stacktop(-2))};
+                    stack.push_back(std::move(vch));
                 }
                 break;
 
@@ -827,13 +881,13 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     if (stack.size() < 2)
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
                     int n = CScriptNum(stacktop(-1), fRequireMinimal).getint();
-                    popstack(stack);
+                    pool.Pop(stack);
                     if (n < 0 || n >= (int)stack.size())
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
-                    valtype vch = stacktop(-n-1);
+                    valtype vch{opcode == OP_ROLL ? std::move(stacktop(-n-1)) : pool.Copy(stacktop(-n-1))};
                     if (opcode == OP_ROLL)
                         stack.erase(stack.end()-n-1);
-                    stack.push_back(vch);
+                    stack.push_back(std::move(vch));
                 }
                 break;
 
@@ -863,8 +917,8 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     // (x1 x2 -- x2 x1 x2)
                     if (stack.size() < 2)
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
-                    valtype vch = stacktop(-1);
-                    stack.insert(stack.end()-2, vch);
+                    valtype vch{pool.Copy(stacktop(-1))};
+                    stack.insert(stack.end()-2, std::move(vch));
                 }
                 break;
 
@@ -875,7 +929,7 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     if (stack.size() < 1)
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
                     CScriptNum bn(stacktop(-1).size());
-                    stack.push_back(bn.getvch());
+                    stack.push_back(pool.Num(bn));
                 }
                 break;
 
@@ -898,13 +952,13 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     // zero bytes after it (numerically, 0x01 == 0x0001 == 0x000001)
                     //if (opcode == OP_NOTEQUAL)
                     //    fEqual = !fEqual;
-                    popstack(stack);
-                    popstack(stack);
-                    stack.push_back(fEqual ? vchTrue : vchFalse);
+                    pool.Pop(stack);
+                    pool.Pop(stack);
+                    stack.push_back(pool.Copy(fEqual ? vchTrue : vchFalse));
                     if (opcode == OP_EQUALVERIFY)
                     {
                         if (fEqual)
-                            popstack(stack);
+                            pool.Pop(stack);
                         else
                             return set_error(serror, SCRIPT_ERR_EQUALVERIFY);
                     }
@@ -936,8 +990,8 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     case OP_0NOTEQUAL:  bn = (bn != bnZero); break;
                     default:            assert(!"invalid opcode"); break;
                     }
-                    popstack(stack);
-                    stack.push_back(bn.getvch());
+                    pool.Pop(stack);
+                    stack.push_back(pool.Num(bn));
                 }
                 break;
 
@@ -984,14 +1038,14 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     case OP_MAX:                 bn = (bn1 > bn2 ? bn1 : bn2); break;
                     default:                     assert(!"invalid opcode"); break;
                     }
-                    popstack(stack);
-                    popstack(stack);
-                    stack.push_back(bn.getvch());
+                    pool.Pop(stack);
+                    pool.Pop(stack);
+                    stack.push_back(pool.Num(bn));
 
                     if (opcode == OP_NUMEQUALVERIFY)
                     {
                         if (CastToBool(stacktop(-1)))
-                            popstack(stack);
+                            pool.Pop(stack);
                         else
                             return set_error(serror, SCRIPT_ERR_NUMEQUALVERIFY);
                     }
@@ -1007,10 +1061,10 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     CScriptNum bn2(stacktop(-2), fRequireMinimal);
                     CScriptNum bn3(stacktop(-1), fRequireMinimal);
                     bool fValue = (bn2 <= bn1 && bn1 < bn3);
-                    popstack(stack);
-                    popstack(stack);
-                    popstack(stack);
-                    stack.push_back(fValue ? vchTrue : vchFalse);
+                    pool.Pop(stack);
+                    pool.Pop(stack);
+                    pool.Pop(stack);
+                    stack.push_back(pool.Copy(fValue ? vchTrue : vchFalse));
                 }
                 break;
 
@@ -1028,7 +1082,8 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                     if (stack.size() < 1)
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
                     valtype& vch = stacktop(-1);
-                    valtype vchHash((opcode == OP_RIPEMD160 || opcode == OP_SHA1 || opcode == OP_HASH160) ? 20 : 32);
+                    valtype vchHash{pool.Take()};
+                    vchHash.resize((opcode == OP_RIPEMD160 || opcode == OP_SHA1 || opcode == OP_HASH160) ? 20 : 32);
                     if (opcode == OP_RIPEMD160)
                         CRIPEMD160().Write(vch.data(), vch.size()).Finalize(vchHash.data());
                     else if (opcode == OP_SHA1)
@@ -1039,8 +1094,8 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                         CHash160().Write(vch).Finalize(vchHash);
                     else if (opcode == OP_HASH256)
                         CHash256().Write(vch).Finalize(vchHash);
-                    popstack(stack);
-                    stack.push_back(vchHash);
+                    pool.Pop(stack);
+                    stack.push_back(std::move(vchHash));
                 }
                 break;
 
@@ -1067,13 +1122,13 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
 
                     bool fSuccess = true;
                     if (!EvalChecksig(vchSig, vchPubKey, pbegincodehash, pend, execdata, flags, checker, sigversion, serror, fSuccess)) return false;
-                    popstack(stack);
-                    popstack(stack);
-                    stack.push_back(fSuccess ? vchTrue : vchFalse);
+                    pool.Pop(stack);
+                    pool.Pop(stack);
+                    stack.push_back(pool.Copy(fSuccess ? vchTrue : vchFalse));
                     if (opcode == OP_CHECKSIGVERIFY)
                     {
                         if (fSuccess)
-                            popstack(stack);
+                            pool.Pop(stack);
                         else
                             return set_error(serror, SCRIPT_ERR_CHECKSIGVERIFY);
                     }
@@ -1094,10 +1149,10 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
 
                     bool success = true;
                     if (!EvalChecksig(sig, pubkey, pbegincodehash, pend, execdata, flags, checker, sigversion, serror, success)) return false;
-                    popstack(stack);
-                    popstack(stack);
-                    popstack(stack);
-                    stack.push_back((num + (success ? 1 : 0)).getvch());
+                    pool.Pop(stack);
+                    pool.Pop(stack);
+                    pool.Pop(stack);
+                    stack.push_back(pool.Num(num + (success ? 1 : 0)));
                 }
                 break;
 
@@ -1186,7 +1241,7 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                             return set_error(serror, SCRIPT_ERR_SIG_NULLFAIL);
                         if (ikey2 > 0)
                             ikey2--;
-                        popstack(stack);
+                        pool.Pop(stack);
                     }
 
                     // A bug causes CHECKMULTISIG to consume one extra argument
@@ -1199,14 +1254,14 @@ bool EvalScript(std::vector<std::vector<unsigned char> >& stack, const CScript&
                         return set_error(serror, SCRIPT_ERR_INVALID_STACK_OPERATION);
                     if ((flags & SCRIPT_VERIFY_NULLDUMMY) && stacktop(-1).size())
                         return set_error(serror, SCRIPT_ERR_SIG_NULLDUMMY);
-                    popstack(stack);
+                    pool.Pop(stack);
 
-                    stack.push_back(fSuccess ? vchTrue : vchFalse);
+                    stack.push_back(pool.Copy(fSuccess ? vchTrue : vchFalse));
 
                     if (opcode == OP_CHECKMULTISIGVERIFY)
                     {
                         if (fSuccess)
-                            popstack(stack);
+                            pool.Pop(stack);
                         else
                             return set_error(serror, SCRIPT_ERR_CHECKMULTISIGVERIFY);
                     }
@@ -1824,10 +1879,67 @@ bool GenericTransactionSignatureChecker<T>::CheckSequence(const CScriptNum& nSeq
 template class GenericTransactionSignatureChecker<CTransaction>;
 template class GenericTransactionSignatureChecker<CMutableTransaction>;
 
-static bool ExecuteWitnessScript(const std::span<const valtype>& stack_span, const CScript& exec_script, unsigned int flags, SigVersion sigversion, const BaseSignatureChecker& checker, ScriptExecutionData& execdata, ScriptError* serror)
+/**
+ * Match the canonical multi_a tapscript shape
+ *   <key_1> OP_CHECKSIG <key_2> OP_CHECKSIGADD ... <key_n> OP_CHECKSIGADD <k> OP_NUMEQUAL
+ * with 32-byte keys and a minimally pushed, positive k. On success, keys holds the
+ * keys (pointing into script) and k is returned.
+ */
+static std::optional<int64_t> MatchMultiA(const CScript& script, std::vector<std::span<const unsigned char>>& keys)
 {
-    std::vector<valtype> stack{stack_span.begin(), stack_span.end()};
+    const std::span<const unsigned char> data{script.data(), script.size()};
+    size_t pos{0};
+    keys.clear();
+    while (data.size() - pos >= 34 && data[pos] == 32 && data[pos + 33] == (keys.empty() ? OP_CHECKSIG : OP_CHECKSIGADD)) {
+        keys.push_back(data.subspan(pos + 1, 32));
+        pos += 34;
+    }
+    if (keys.empty() || data.size() - pos < 2 || data.back() != OP_NUMEQUAL) return std::nullopt;
+
+    const auto k_push{data.subspan(pos, data.size() - pos - 1)};
+    if (k_push.size() == 1 && k_push[0] >= OP_1 && k_push[0] <= OP_16) {
+        return int64_t{k_push[0]} - (OP_1 - 1);
+    }
+    // Larger values must be a direct push of a minimally encoded number
+    if (k_push[0] < 1 || k_push[0] > CScriptNum::nDefaultMaxNumSize || k_push.size() != size_t{k_push[0]} + 1U) return std::nullopt;
+    try {
+        const int64_t k{CScriptNum({k_push.begin() + 1, k_push.end()}, /*fRequireMinimal=*/true).GetInt64()};
+        if (k <= 16) return std::nullopt;
+        return k;
+    } catch (const scriptnum_error&) {
+        return std::nullopt;
+    }
+}
+
+/**
+ * Evaluate a script matched by MatchMultiA against the witness stack in a single loop,
+ * without going through the generic interpreter. This performs exactly the checks of
+ * the generic execution, in the same order, and only differs in not materializing the
+ * intermediate stacks. The caller must make sure the stack holds one element per key.
+ *
+ * A return value of false means the script fails entirely. Otherwise result is set to
+ * whether the number of valid signatures equals k.
+ */
+static bool EvalMultiA(std::span<const valtype> stack, std::span<const std::span<const unsigned char>> keys, int64_t k, unsigned int flags, const BaseSignatureChecker& checker, ScriptExecutionData& execdata, ScriptError* serror, bool& result)
+{
+    assert(stack.size() == keys.size());
+    execdata.m_codeseparator_pos = 0xFFFFFFFFUL;
+    execdata.m_codeseparator_pos_init = true;
 
+    int64_t num_valid{0};
+    for (size_t i = 0; i < keys.size(); ++i) {
+        // The signature for the first key is at the top of the stack
+        const valtype& sig{stack[stack.size() - 1 - i]};
+        bool success{true};
+        if (!EvalChecksigTapscript(sig, keys[i], execdata, flags, checker, SigVersion::TAPSCRIPT, serror, success)) return false;
+        num_valid += success ? 1 : 0;
+    }
+    result = num_valid == k;
+    return set_success(serror);
+}
+
+bool ExecuteWitnessScript(const std::span<const valtype>& stack_span, const CScript& exec_script, unsigned int flags, SigVersion sigversion, const BaseSignatureChecker& checker, ScriptExecutionData& execdata, ScriptError* serror)
+{
     if (sigversion == SigVersion::TAPSCRIPT) {
         // OP_SUCCESSx processing overrides everything, including stack element size limits
         CScript::const_iterator pc = exec_script.begin();
@@ -1847,14 +1959,29 @@ static bool ExecuteWitnessScript(const std::span<const valtype>& stack_span, con
         }
 
         // Tapscript enforces initial stack size limits (altstack is empty here)
-        if (stack.size() > MAX_STACK_SIZE) return set_error(serror, SCRIPT_ERR_STACK_SIZE);
+        if (stack_span.size() > MAX_STACK_SIZE) return set_error(serror, SCRIPT_ERR_STACK_SIZE);
     }
 
     // Disallow stack item size > MAX_SCRIPT_ELEMENT_SIZE in witness stack
-    for (const valtype& elem : stack) {
+    for (const valtype& elem : stack_span) {
         if (elem.size() > MAX_SCRIPT_ELEMENT_SIZE) return set_error(serror, SCRIPT_ERR_PUSH_SIZE);
     }
 
+    if (sigversion == SigVersion::TAPSCRIPT) {
+        // Fast path for multi_a scripts with one stack element per key. Generic execution
+        // would push one element on top of the initial stack at most, which must fit.
+        std::vector<std::span<const unsigned char>> keys;
+        const auto k{MatchMultiA(exec_script, keys)};
+        if (k && keys.size() == stack_span.size() && keys.size() + 1 <= MAX_STACK_SIZE) {
+            bool result{false};
+            if (!EvalMultiA(stack_span, keys, *k, flags, checker, execdata, serror, result)) return false;
+            if (!result) return set_error(serror, SCRIPT_ERR_EVAL_FALSE);
+            return true;
+        }
+    }
+
+    std::vector<valtype> stack{stack_span.begin(), stack_span.end()};
+
     // Run the script interpreter.
     if (!EvalScript(stack, exec_script, flags, checker, sigversion, execdata, serror)) return false;
 
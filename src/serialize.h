@@ -13,6 +13,8 @@
 #include <span.h>
 
 #include <algorithm>
+#include <array>
+#include <cassert>
 #include <concepts>
 #include <cstdint>
 #include <cstring>
@@ -22,6 +24,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -230,6 +233,69 @@ const Out& AsBase(const In& x)
     BASE_SERIALIZE_METHODS(cls)     \
     FORMATTER_METHODS(cls, obj)
 
+/**
+ * Declare that every serialization of cls is exactly `size` bytes long and does
+ * not depend on serialization parameters. GetSerializeSize() then returns the
+ * size without serializing, and (un)serialization goes through a stack buffer so
+ * the underlying stream sees a single write or read per object.
+ *
+ * Only the class itself is covered: a derived class that adds fields does not
+ * inherit the declaration.
+ */
+#define FIXED_SERIALIZE_SIZE(cls, size) \
+    static constexpr size_t SerializedSize(std::type_identity<cls>) { return size; }
+
+template <typename T>
+concept FixedSizeSerializable = requires { { T::SerializedSize(std::type_identity<T>{}) } -> std::same_as<size_t>; };
+
+/** Serialized size of a type declared with FIXED_SERIALIZE_SIZE. */
+template <FixedSizeSerializable T>
+constexpr size_t FixedSerializeSize = T::SerializedSize(std::type_identity<T>{});
+
+/** Stream writing into a buffer that is known to be large enough, see FIXED_SERIALIZE_SIZE. */
+class FixedBufferWriter
+{
+    std::span<std::byte> m_dest;
+    size_t m_pos{0};
+
+public:
+    explicit FixedBufferWriter(std::span<std::byte> dest) : m_dest{dest} {}
+
+    void write(std::span<const std::byte> src)
+    {
+        assert(src.size() <= m_dest.size() - m_pos);
+        std::memcpy(m_dest.data() + m_pos, src.data(), src.size());
+        m_pos += src.size();
+    }
+
+    template <typename T>
+    FixedBufferWriter& operator<<(const T& obj);
+
+    size_t size() const { return m_pos; }
+};
+
+/** Stream reading from a buffer that is known to hold enough data, see FIXED_SERIALIZE_SIZE. */
+class FixedBufferReader
+{
+    std::span<const std::byte> m_src;
+    size_t m_pos{0};
+
+public:
+    explicit FixedBufferReader(std::span<const std::byte> src) : m_src{src} {}
+
+    void read(std::span<std::byte> dst)
+    {
+        assert(dst.size() <= m_src.size() - m_pos);
+        std::memcpy(dst.data(), m_src.data() + m_pos, dst.size());
+        m_pos += dst.size();
+    }
+
+    template <typename T>
+    FixedBufferReader& operator>>(T&& obj);
+
+    size_t size() const { return m_pos; }
+};
+
 // Templates for serializing to anything that looks like a stream,
 // i.e. anything that supports .read(std::span<std::byte>) and .write(std::span<const std::byte>)
 //
@@ -742,7 +808,17 @@ template <typename Stream, typename T>
     requires Serializable<T, Stream>
 void Serialize(Stream& os, const T& a)
 {
-    a.Serialize(os);
+    if constexpr (FixedSizeSerializable<T> && std::is_same_v<Stream, SizeComputer>) {
+        os.seek(FixedSerializeSize<T>);
+    } else if constexpr (FixedSizeSerializable<T> && !std::is_same_v<Stream, FixedBufferWriter>) {
+        std::array<std::byte, FixedSerializeSize<T>> buf;
+        FixedBufferWriter writer{buf};
+        a.Serialize(writer);
+        assert(writer.size() == buf.size());
+        os.write(buf);
+    } else {
+        a.Serialize(os);
+    }
 }
 
 template <class T, class Stream>
@@ -751,7 +827,16 @@ template <typename Stream, typename T>
     requires Unserializable<T, Stream>
 void Unserialize(Stream& is, T&& a)
 {
-    a.Unserialize(is);
+    using U = std::remove_cvref_t<T>;
+    if constexpr (FixedSizeSerializable<U> && !std::is_same_v<Stream, FixedBufferReader>) {
+        std::array<std::byte, FixedSerializeSize<U>> buf;
+        is.read(buf);
+        FixedBufferReader reader{buf};
+        a.Unserialize(reader);
+        assert(reader.size() == buf.size());
+    } else {
+        a.Unserialize(is);
+    }
 }
 
 /** Default formatter. Serializes objects as themselves.
@@ -803,6 +888,9 @@ void Serialize(Stream& os, const prevector<N, T>& v)
     if constexpr (BasicByte<T>) { // Use optimized version for unformatted basic bytes
         WriteCompactSize(os, v.size());
         if (!v.empty()) os.write(MakeByteSpan(v));
+    } else if constexpr (FixedSizeSerializable<T> && std::is_same_v<Stream, SizeComputer>) {
+        WriteCompactSize(os, v.size());
+        os.seek(v.size() * FixedSerializeSize<T>);
     } else {
         Serialize(os, Using<VectorFormatter<DefaultFormatter>>(v));
     }
@@ -1037,6 +1125,20 @@ struct ActionUnserialize {
     }
 };
 
+template <typename T>
+FixedBufferWriter& FixedBufferWriter::operator<<(const T& obj)
+{
+    ::Serialize(*this, obj);
+    return *this;
+}
+
+template <typename T>
+FixedBufferReader& FixedBufferReader::operator>>(T&& obj)
+{
+    ::Unserialize(*this, obj);
+    return *this;
+}
+
 /* ::GetSerializeSize implementations
  *
  * Computing the serialized size of objects is done through a special stream
@@ -1093,7 +1195,11 @@ inline void WriteCompactSize(SizeComputer &s, uint64_t nSize)
 template <typename T>
 size_t GetSerializeSize(const T& t)
 {
-    return (SizeComputer() << t).size();
+    if constexpr (FixedSizeSerializable<T>) {
+        return FixedSerializeSize<T>;
+    } else {
+        return (SizeComputer() << t).size();
+    }
 }
 
 //! Check if type contains a stream by seeing if has a GetStream() method.
@@ -55,18 +55,29 @@ static bool FetchAndClearCommitmentSection(const std::span<const uint8_t> header
     return found_header;
 }
 
-static uint256 ComputeModifiedMerkleRoot(const CMutableTransaction& cb, const CBlock& block)
+SignetSolutionProof MakeSignetSolutionProof(const CBlock& block)
 {
-    std::vector<uint256> leaves;
-    leaves.resize(block.vtx.size());
-    leaves[0] = cb.GetHash().ToUint256();
-    for (size_t s = 1; s < block.vtx.size(); ++s) {
-        leaves[s] = block.vtx[s]->GetHash().ToUint256();
-    }
-    return ComputeMerkleRoot(std::move(leaves));
+    return SignetSolutionProof{
+        .header = block.GetBlockHeader(),
+        .coinbase = block.vtx.at(0),
+        .coinbase_merkle_path = TransactionMerklePath(block, 0),
+    };
+}
+
+bool CheckSignetSolutionProofCommitment(const SignetSolutionProof& proof)
+{
+    if (!proof.coinbase || !proof.coinbase->IsCoinBase()) return false;
+    if (proof.coinbase_merkle_path.size() > MAX_SIGNET_PROOF_PATH_LENGTH) return false;
+    return ComputeMerkleRootFromPath(proof.coinbase->GetHash().ToUint256(), 0, proof.coinbase_merkle_path) == proof.header.hashMerkleRoot;
 }
 
 std::optional<SignetTxs> SignetTxs::Create(const CBlock& block, const CScript& challenge)
+{
+    if (block.vtx.empty()) return std::nullopt; // no coinbase tx in block; invalid
+    return Create(MakeSignetSolutionProof(block), challenge);
+}
+
+std::optional<SignetTxs> SignetTxs::Create(const SignetSolutionProof& proof, const CScript& challenge)
 {
     CMutableTransaction tx_to_spend;
     tx_to_spend.version = 0;
@@ -84,10 +95,10 @@ std::optional<SignetTxs> SignetTxs::Create(const CBlock& block, const CScript& c
     // responses from block coinbase tx
 
     // find and delete signet signature
-    if (block.vtx.empty()) return std::nullopt; // no coinbase tx in block; invalid
-    CMutableTransaction modified_cb(*block.vtx.at(0));
+    if (!proof.coinbase) return std::nullopt; // no coinbase tx in block; invalid
+    CMutableTransaction modified_cb(*proof.coinbase);
 
-    const int cidx = GetWitnessCommitmentIndex(block);
+    const int cidx = GetWitnessCommitmentIndex(*proof.coinbase);
     if (cidx == NO_WITNESS_COMMITMENT) {
         return std::nullopt; // require a witness commitment
     }
@@ -107,20 +118,33 @@ std::optional<SignetTxs> SignetTxs::Create(const CBlock& block, const CScript& c
             return std::nullopt; // parsing error
         }
     }
-    uint256 signet_merkle = ComputeModifiedMerkleRoot(modified_cb, block);
+    // the coinbase is the first leaf, so swapping it in the path gives the modified merkle root
+    uint256 signet_merkle = ComputeMerkleRootFromPath(modified_cb.GetHash().ToUint256(), 0, proof.coinbase_merkle_path);
 
     std::vector<uint8_t> block_data;
     VectorWriter writer{block_data, 0};
-    writer << block.nVersion;
-    writer << block.hashPrevBlock;
+    writer << proof.header.nVersion;
+    writer << proof.header.hashPrevBlock;
     writer << signet_merkle;
-    writer << block.nTime;
+    writer << proof.header.nTime;
     tx_to_spend.vin[0].scriptSig << block_data;
     tx_spending.vin[0].prevout = COutPoint(tx_to_spend.GetHash(), 0);
 
     return SignetTxs{tx_to_spend, tx_spending};
 }
 
+static bool VerifySignetTxs(const SignetTxs& signet_txs)
+{
+    const CScript& scriptSig = signet_txs.m_to_sign.vin[0].scriptSig;
+    const CScriptWitness& witness = signet_txs.m_to_sign.vin[0].scriptWitness;
+
+    PrecomputedTransactionData txdata;
+    txdata.Init(signet_txs.m_to_sign, {signet_txs.m_to_spend.vout[0]});
+    TransactionSignatureChecker sigcheck(&signet_txs.m_to_sign, /* nInIn= */ 0, /* amountIn= */ signet_txs.m_to_spend.vout[0].nValue, txdata, MissingDataBehavior::ASSERT_FAIL);
+
+    return VerifyScript(scriptSig, signet_txs.m_to_spend.vout[0].scriptPubKey, &witness, BLOCK_SCRIPT_VERIFY_FLAGS, sigcheck);
+}
+
 // Signet block solution checker
 bool CheckSignetBlockSolution(const CBlock& block, const Consensus::Params& consensusParams)
 {
@@ -137,15 +161,35 @@ bool CheckSignetBlockSolution(const CBlock& block, const Consensus::Params& cons
         return false;
     }
 
-    const CScript& scriptSig = signet_txs->m_to_sign.vin[0].scriptSig;
-    const CScriptWitness& witness = signet_txs->m_to_sign.vin[0].scriptWitness;
+    if (!VerifySignetTxs(*signet_txs)) {
+        LogDebug(BCLog::VALIDATION, "CheckSignetBlockSolution: Errors in block (block solution invalid)\n");
+        return false;
+    }
+    return true;
+}
 
-    PrecomputedTransactionData txdata;
-    txdata.Init(signet_txs->m_to_sign, {signet_txs->m_to_spend.vout[0]});
-    TransactionSignatureChecker sigcheck(&signet_txs->m_to_sign, /* nInIn= */ 0, /* amountIn= */ signet_txs->m_to_spend.vout[0].nValue, txdata, MissingDataBehavior::ASSERT_FAIL);
+bool CheckSignetSolutionProof(const SignetSolutionProof& proof, const Consensus::Params& consensusParams)
+{
+    if (!CheckSignetSolutionProofCommitment(proof)) {
+        LogDebug(BCLog::VALIDATION, "CheckSignetSolutionProof: Errors in proof (coinbase not committed to by header)\n");
+        return false;
+    }
 
-    if (!VerifyScript(scriptSig, signet_txs->m_to_spend.vout[0].scriptPubKey, &witness, BLOCK_SCRIPT_VERIFY_FLAGS, sigcheck)) {
-        LogDebug(BCLog::VALIDATION, "CheckSignetBlockSolution: Errors in block (block solution invalid)\n");
+    if (proof.header.GetHash() == consensusParams.hashGenesisBlock) {
+        // genesis block solution is always valid
+        return true;
+    }
+
+    const CScript challenge(consensusParams.signet_challenge.begin(), consensusParams.signet_challenge.end());
+    const std::optional<SignetTxs> signet_txs = SignetTxs::Create(proof, challenge);
+
+    if (!signet_txs) {
+        LogDebug(BCLog::VALIDATION, "CheckSignetSolutionProof: Errors in proof (block solution parse failure)\n");
+        return false;
+    }
+
+    if (!VerifySignetTxs(*signet_txs)) {
+        LogDebug(BCLog::VALIDATION, "CheckSignetSolutionProof: Errors in proof (block solution invalid)\n");
         return false;
     }
     return true;
@@ -8,14 +8,53 @@
 #include <consensus/params.h>
 #include <primitives/block.h>
 #include <primitives/transaction.h>
+#include <serialize.h>
+#include <uint256.h>
 
 #include <optional>
+#include <vector>
+
+/** Maximum number of hashes in the coinbase merkle path of a SignetSolutionProof (a block of 2^32 transactions). */
+static constexpr size_t MAX_SIGNET_PROOF_PATH_LENGTH{32};
+
+/**
+ * A block header together with its coinbase transaction and the merkle path
+ * linking the coinbase to the header's merkle root. This is everything needed
+ * to check the block's signet solution without the rest of the block.
+ */
+struct SignetSolutionProof {
+    CBlockHeader header;
+    CTransactionRef coinbase;
+    //! Merkle path of the coinbase, ordered from the deepest (see TransactionMerklePath)
+    std::vector<uint256> coinbase_merkle_path;
+
+    SERIALIZE_METHODS(SignetSolutionProof, obj)
+    {
+        READWRITE(obj.header, TX_WITH_WITNESS(obj.coinbase), obj.coinbase_merkle_path);
+    }
+};
+
+/** Build the signet solution proof of a block. The block must have a coinbase transaction. */
+SignetSolutionProof MakeSignetSolutionProof(const CBlock& block);
+
+/**
+ * Check that the proof's coinbase is a coinbase transaction committed to by
+ * the proof's header. Does not check the signet solution itself.
+ */
+bool CheckSignetSolutionProofCommitment(const SignetSolutionProof& proof);
 
 /**
  * Extract signature and check whether a block has a valid solution
  */
 bool CheckSignetBlockSolution(const CBlock& block, const Consensus::Params& consensusParams);
 
+/**
+ * Check that the proof commits to its header and that the header's block has
+ * a valid solution. A block passing this check still fails
+ * CheckSignetBlockSolution if its transactions do not match the header.
+ */
+bool CheckSignetSolutionProof(const SignetSolutionProof& proof, const Consensus::Params& consensusParams);
+
 /**
  * Generate the signet tx corresponding to the given block
  *
@@ -29,6 +68,7 @@ class SignetTxs {
 
 public:
     static std::optional<SignetTxs> Create(const CBlock& block, const CScript& challenge);
+    static std::optional<SignetTxs> Create(const SignetSolutionProof& proof, const CScript& challenge);
 
     const CTransaction m_to_spend;
     const CTransaction m_to_sign;
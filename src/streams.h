@@ -51,6 +51,9 @@ public:
     template <typename... Args>
     VectorWriter(std::vector<unsigned char>& vchDataIn, size_t nPosIn, Args&&... args) : VectorWriter{vchDataIn, nPosIn}
     {
+        if constexpr ((FixedSizeSerializable<std::remove_cvref_t<Args>> && ...)) {
+            vchData.reserve(nPos + (FixedSerializeSize<std::remove_cvref_t<Args>> + ...));
+        }
         ::SerializeMany(*this, std::forward<Args>(args)...);
     }
     void write(std::span<const std::byte> src)
@@ -8,6 +8,7 @@
 #include <streams.h>
 #include <test/util/logging.h>
 #include <test/util/setup_common.h>
+#include <tinyformat.h>
 #include <util/readwritefile.h>
 
 
@@ -40,4 +41,74 @@ BOOST_AUTO_TEST_CASE(file)
     }
 }
 
+BOOST_AUTO_TEST_CASE(subnet_lookup)
+{
+    SetMockTime(1000s);
+    BanMan banman{m_args.GetDataDirBase() / "banlist_lookup", /*client_interface=*/nullptr, /*default_ban_time=*/100};
+    const auto addr{[](const std::string& str) { return LookupHost(str, /*fAllowLookup=*/false).value(); }};
+    const auto subnet{[](const std::string& str) { return LookupSubNet(str); }};
+
+    banman.Ban(subnet("10.1.0.0/16"));
+    banman.Ban(subnet("2a00:1450::/33"), /*ban_time_offset=*/50);
+    banman.Ban(addr("1.2.3.4"), /*ban_time_offset=*/200);
+    banman.Ban(addr("pg6mmjiyjmcrsslvykfwnntlaru7p5svn6y2ymmju6nubxndf4pscryd.onion"));
+
+    BOOST_CHECK(banman.IsBanned(addr("10.1.255.7")));
+    BOOST_CHECK(!banman.IsBanned(addr("10.2.0.1")));
+    BOOST_CHECK(banman.IsBanned(addr("2a00:1450:7fff::1")));
+    BOOST_CHECK(!banman.IsBanned(addr("2a00:1450:8000::1")));
+    BOOST_CHECK(banman.IsBanned(addr("1.2.3.4")));
+    BOOST_CHECK(!banman.IsBanned(addr("1.2.3.5")));
+    // An IPv4 subnet does not match an IPv6 address that starts with the same bytes.
+    BOOST_CHECK(!banman.IsBanned(addr("0a01::1")));
+    BOOST_CHECK(banman.IsBanned(addr("pg6mmjiyjmcrsslvykfwnntlaru7p5svn6y2ymmju6nubxndf4pscryd.onion")));
+    BOOST_CHECK(banman.IsBanned(subnet("10.1.0.0/16")));
+    BOOST_CHECK(!banman.IsBanned(subnet("10.1.0.0/17")));
+
+    // Bans expire without a sweep, and the lookup agrees with CSubNet::Match().
+    SetMockTime(1075s);
+    BOOST_CHECK(!banman.IsBanned(addr("2a00:1450::1")));
+    BOOST_CHECK(banman.IsBanned(addr("10.1.0.1")));
+    SetMockTime(1150s);
+    BOOST_CHECK(!banman.IsBanned(addr("10.1.0.1")));
+    BOOST_CHECK(banman.IsBanned(addr("1.2.3.4")));
+
+    BOOST_CHECK(banman.Unban(addr("1.2.3.4")));
+    BOOST_CHECK(!banman.IsBanned(addr("1.2.3.4")));
+
+    // Sweeping expired bans removes them from the index, which keeps the
+    // remaining and new bans of the same prefix length.
+    banman.Ban(addr("1.2.3.5"));
+    banman.Ban(subnet("10.3.0.0/16"));
+    banmap_t banmap;
+    banman.GetBanned(banmap);
+    BOOST_CHECK_EQUAL(banmap.size(), 2U);
+    BOOST_CHECK(banman.IsBanned(addr("1.2.3.5")));
+    BOOST_CHECK(banman.IsBanned(addr("10.3.0.1")));
+    BOOST_CHECK(!banman.IsBanned(addr("10.1.0.1")));
+    banman.Ban(subnet("10.1.0.0/16"));
+    BOOST_CHECK(banman.IsBanned(addr("10.1.0.1")));
+    BOOST_CHECK(banman.Unban(subnet("10.3.0.0/16")));
+    BOOST_CHECK(!banman.IsBanned(addr("10.3.0.1")));
+    BOOST_CHECK(banman.IsBanned(addr("10.1.0.1")));
+
+    banman.Ban(subnet("0.0.0.0/0"));
+    BOOST_CHECK(banman.IsBanned(addr("8.8.8.8")));
+    BOOST_CHECK(!banman.IsBanned(addr("2a00:1450::1")));
+    banman.ClearBanned();
+    BOOST_CHECK(!banman.IsBanned(addr("8.8.8.8")));
+}
+
+BOOST_AUTO_TEST_CASE(discouragement)
+{
+    BanMan banman{m_args.GetDataDirBase() / "banlist_discourage", /*client_interface=*/nullptr, /*default_ban_time=*/0};
+    std::vector<CNetAddr> addrs;
+    for (int i{0}; i < 64; ++i) {
+        addrs.push_back(LookupHost(strprintf("11.0.0.%d", i), /*fAllowLookup=*/false).value());
+        banman.Discourage(addrs.back());
+    }
+    for (const CNetAddr& addr : addrs) BOOST_CHECK(banman.IsDiscouraged(addr));
+    BOOST_CHECK(!banman.IsDiscouraged(LookupHost("11.0.1.0", /*fAllowLookup=*/false).value()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -5,12 +5,14 @@
 #include <boost/test/unit_test.hpp>
 
 #include <clientversion.h>
+#include <crypto/sha512.h>
 #include <key.h>
 #include <key_io.h>
 #include <streams.h>
 #include <test/util/setup_common.h>
 #include <util/strencodings.h>
 
+#include <array>
 #include <string>
 #include <vector>
 
@@ -200,6 +202,51 @@ BOOST_AUTO_TEST_CASE(bip32_max_depth) {
     BOOST_CHECK(key_parent.nDepth == 255 && pubkey_parent.nDepth == 255);
     BOOST_CHECK(!key_parent.Derive(key_child, 0));
     BOOST_CHECK(!pubkey_parent.Derive(pubkey_child, 0));
+    std::vector<CExtPubKey> pubkey_children;
+    BOOST_CHECK(!pubkey_parent.Derive(std::array{0U, 1U}, pubkey_children));
+}
+
+BOOST_AUTO_TEST_CASE(bip32_derive_batch)
+{
+    // Batched derivation must match one derivation per child, with
+    // every multi-buffer SHA-512 implementation (1, 4 and 8 lanes).
+    using namespace sha512_implementation;
+    for (const auto use_implementation : {STANDARD, USE_AVX2, USE_AVX512}) {
+        const std::string implementation{SHA512AutoDetect(use_implementation)};
+        for (const TestVector* test : {&test1, &test2, &test3, &test4}) {
+            const CExtPubKey parent{DecodeExtPubKey(test->vDerive[0].pub)};
+            for (const unsigned int count : {1, 2, 3, 4, 5, 8, 9, 17}) {
+                std::vector<unsigned int> children;
+                for (unsigned int i = 0; i < count; ++i) children.push_back(i * 7 + count);
+                // Derive appends to the vector it is given.
+                std::vector<CExtPubKey> batch(1);
+                BOOST_REQUIRE(parent.Derive(children, batch));
+                BOOST_REQUIRE_EQUAL(batch.size(), count + 1);
+                for (unsigned int i = 0; i < count; ++i) {
+                    CExtPubKey expected;
+                    BOOST_CHECK(parent.Derive(expected, children[i]));
+                    BOOST_CHECK_MESSAGE(batch[i + 1] == expected, implementation << " child " << children[i]);
+                }
+
+                // Likewise for hardened private derivation.
+                for (unsigned int& child : children) child |= 0x80000000;
+                const CExtKey parent_key{DecodeExtKey(test->vDerive[0].prv)};
+                std::vector<CExtKey> keys(1);
+                BOOST_REQUIRE(parent_key.Derive(children, keys));
+                BOOST_REQUIRE_EQUAL(keys.size(), count + 1);
+                for (unsigned int i = 0; i < count; ++i) {
+                    CExtKey expected;
+                    BOOST_CHECK(parent_key.Derive(expected, children[i]));
+                    BOOST_CHECK_MESSAGE(keys[i + 1] == expected, implementation << " hardened child " << children[i]);
+                }
+            }
+        }
+        // Test vector 2 derives m/0 from the master key.
+        std::vector<CExtPubKey> batch;
+        BOOST_CHECK(DecodeExtPubKey(test2.vDerive[0].pub).Derive(std::array{0U, 1U, 2U, 3U, 4U}, batch));
+        BOOST_CHECK_EQUAL(EncodeExtPubKey(batch.at(0)), test2.vDerive[1].pub);
+    }
+    SHA512AutoDetect();
 }
 
 BOOST_AUTO_TEST_SUITE_END()
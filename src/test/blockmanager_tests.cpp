@@ -10,9 +10,13 @@
 #include <node/kernel_notifications.h>
 #include <script/solver.h>
 #include <primitives/block.h>
+#include <undo.h>
 #include <util/chaintype.h>
 #include <validation.h>
 
+#include <limits>
+#include <vector>
+
 #include <boost/test/unit_test.hpp>
 #include <test/util/logging.h>
 #include <test/util/setup_common.h>
@@ -21,6 +25,7 @@ using node::STORAGE_HEADER_BYTES;
 using node::BlockManager;
 using node::KernelNotifications;
 using node::MAX_BLOCKFILE_SIZE;
+using node::PrunedBlockPos;
 
 // use BasicTestingSetup here for the data directory configuration, setup, and cleanup
 BOOST_FIXTURE_TEST_SUITE(blockmanager_tests, BasicTestingSetup)
@@ -98,6 +103,112 @@ BOOST_FIXTURE_TEST_CASE(blockmanager_scan_unlink_already_pruned_files, TestChain
     BOOST_CHECK(!blockman.OpenBlockFile(new_pos, true).IsNull());
 }
 
+BOOST_FIXTURE_TEST_CASE(blockmanager_schedule_pruning, TestChain100Setup)
+{
+    // Cap last block file size, and mine new block in a new block file.
+    const auto& chainman = Assert(m_node.chainman);
+    auto& blockman = chainman->m_blockman;
+    const CBlockIndex* old_tip{WITH_LOCK(chainman->GetMutex(), return chainman->ActiveChain().Tip())};
+    WITH_LOCK(chainman->GetMutex(), blockman.GetBlockFileInfo(old_tip->GetBlockPos().nFile)->nSize = MAX_BLOCKFILE_SIZE);
+    CreateAndProcessBlock({}, GetScriptForRawPubKey(coinbaseKey.GetPubKey()));
+
+    int file_number;
+    PrunedBlockPos punched;
+    {
+        LOCK(chainman->GetMutex());
+        file_number = old_tip->GetBlockPos().nFile;
+        blockman.PruneOneBlockFile(file_number);
+        // Forget the data of the new tip too, while its file is kept.
+        CBlockIndex& new_tip{*chainman->ActiveChain().Tip()};
+        punched = {new_tip.nFile, new_tip.nDataPos, new_tip.nUndoPos};
+        BOOST_CHECK_NE(punched.file, file_number);
+        new_tip.nStatus &= ~(BLOCK_HAVE_DATA | BLOCK_HAVE_UNDO);
+    }
+    const uint64_t usage{blockman.CalculateCurrentUsage()};
+    BOOST_CHECK(!blockman.OpenBlockFile({file_number, 0}, true).IsNull());
+
+    blockman.SchedulePruning({file_number}, {punched});
+    blockman.WaitForPruning();
+    BOOST_CHECK(blockman.OpenBlockFile({file_number, 0}, true).IsNull());
+    // The kept file stays, smaller if the file system supports punching holes.
+    BOOST_CHECK(!blockman.OpenBlockFile({punched.file, 0}, true).IsNull());
+    BOOST_CHECK(blockman.CalculateCurrentUsage() <= usage);
+
+    // Nothing left to do.
+    blockman.WaitForPruning();
+}
+
+BOOST_FIXTURE_TEST_CASE(blockmanager_prune_blocks_in_kept_files, TestChain100Setup)
+{
+    const auto& chainman = Assert(m_node.chainman);
+    auto& blockman = chainman->m_blockman;
+    LOCK(chainman->GetMutex());
+    const Chainstate& chainstate{chainman->ActiveChainstate()};
+    const CChain& chain{chainstate.m_chain};
+
+    // The size freed by a block is read from the storage headers of its block and undo data.
+    const auto stored_bytes{[&](const CBlockIndex& index) {
+        CBlock block;
+        CBlockUndo undo;
+        BOOST_REQUIRE(blockman.ReadBlock(block, index));
+        BOOST_REQUIRE(blockman.ReadBlockUndo(undo, index));
+        return STORAGE_HEADER_BYTES + GetSerializeSize(TX_WITH_WITNESS(block)) +
+               STORAGE_HEADER_BYTES + GetSerializeSize(undo) + uint256::size();
+    }};
+    const uint64_t block_10_bytes{stored_bytes(*chain[10])};
+    const unsigned int block_10_pos{chain[10]->GetBlockPos().nPos};
+
+    // The lowest block of the range is pruned first, and pruning stops once enough bytes are freed.
+    std::vector<PrunedBlockPos> blocks;
+    BOOST_CHECK_EQUAL(blockman.PruneBlocksInKeptFiles(blocks, chainstate, /*min_height=*/10, /*max_height=*/20, /*bytes_to_free=*/1), block_10_bytes);
+    BOOST_REQUIRE_EQUAL(blocks.size(), 1U);
+    BOOST_CHECK_EQUAL(blocks[0].data_pos, block_10_pos);
+    BOOST_CHECK(!(chain[10]->nStatus & BLOCK_HAVE_DATA));
+    BOOST_CHECK(chain[11]->nStatus & BLOCK_HAVE_DATA);
+
+    // Blocks without data are skipped, and blocks outside the range are kept.
+    chain[12]->nStatus &= ~(BLOCK_HAVE_DATA | BLOCK_HAVE_UNDO);
+    uint64_t expected{0};
+    std::vector<unsigned int> expected_pos;
+    for (int height : {11, 13, 14, 15, 16, 17, 18, 19, 20}) {
+        expected += stored_bytes(*chain[height]);
+        expected_pos.push_back(chain[height]->GetBlockPos().nPos);
+    }
+    blocks.clear();
+    BOOST_CHECK_EQUAL(blockman.PruneBlocksInKeptFiles(blocks, chainstate, 10, 20, std::numeric_limits<uint64_t>::max()), expected);
+    BOOST_REQUIRE_EQUAL(blocks.size(), expected_pos.size());
+    for (size_t i{0}; i < blocks.size(); ++i) {
+        BOOST_CHECK_EQUAL(blocks[i].data_pos, expected_pos[i]);
+        BOOST_CHECK_NE(blocks[i].undo_pos, 0U);
+    }
+    BOOST_CHECK(chain[9]->nStatus & BLOCK_HAVE_DATA);
+    BOOST_CHECK(chain[21]->nStatus & BLOCK_HAVE_DATA);
+
+    // Heights that were looked at already are not walked again.
+    blocks.clear();
+    BOOST_CHECK_EQUAL(blockman.PruneBlocksInKeptFiles(blocks, chainstate, 10, 20, std::numeric_limits<uint64_t>::max()), 0U);
+    BOOST_CHECK(blocks.empty());
+
+    // Punch the pruned blocks out of the file, which is kept. The bytes freed
+    // are persisted with the file info when the block index is written.
+    BOOST_REQUIRE(blockman.WriteBlockIndexDB());
+    const uint64_t usage{blockman.CalculateCurrentUsage()};
+    const uint64_t block_21_bytes{stored_bytes(*chain[21])};
+    const int block_21_file{chain[21]->GetBlockPos().nFile};
+    blocks.clear();
+    blockman.PruneBlocksInKeptFiles(blocks, chainstate, 21, 21, 1);
+    blockman.SchedulePruning({}, blocks);
+    blockman.WaitForPruning();
+    const uint64_t freed{usage - blockman.CalculateCurrentUsage()};
+    // Nothing is freed where the file system does not support punching holes.
+    BOOST_CHECK(freed == 0 || freed == block_21_bytes);
+    BOOST_REQUIRE(blockman.WriteBlockIndexDB());
+    CBlockFileInfo info;
+    BOOST_REQUIRE(blockman.m_block_tree_db->ReadBlockFileInfo(block_21_file, info));
+    BOOST_CHECK_EQUAL(info.nPunchedBytes, freed);
+    BOOST_CHECK_EQUAL(blockman.CalculateCurrentUsage(), usage - freed);
+}
+
 BOOST_FIXTURE_TEST_CASE(blockmanager_block_data_availability, TestChain100Setup)
 {
     // The goal of the function is to return the first not pruned block in the range [upper_block, lower_block].
@@ -0,0 +1,102 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/cache_governor.h>
+#include <test/util/setup_common.h>
+#include <util/byte_units.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <string>
+
+using node::CgroupMemory;
+using node::CoinsCacheObservation;
+using node::NextCoinsCacheBudget;
+using node::ReadCgroupMemory;
+
+namespace {
+void WriteFile(const fs::path& path, const std::string& contents)
+{
+    fs::create_directories(path.parent_path());
+    std::ofstream{path} << contents;
+}
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(cache_governor_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(read_cgroup_v2)
+{
+    const fs::path dir{m_path_root / "cgroup_v2"};
+    BOOST_CHECK(!ReadCgroupMemory(dir));
+
+    WriteFile(dir / "memory.current", "1000000\n");
+    WriteFile(dir / "memory.stat", "anon 600000\ninactive_file 250000\nactive_file 10\n");
+    WriteFile(dir / "memory.max", "max\n");
+    WriteFile(dir / "memory.pressure", "some avg10=12.50 avg60=3.00 avg300=1.00 total=123\nfull avg10=1.00 avg60=0.00 avg300=0.00 total=4\n");
+    auto memory{ReadCgroupMemory(dir)};
+    BOOST_REQUIRE(memory);
+    BOOST_CHECK_EQUAL(memory->usage, 750000U);
+    BOOST_CHECK(!memory->limit);
+    BOOST_CHECK(memory->pressure == 12.5);
+
+    WriteFile(dir / "memory.max", "4000000\n");
+    memory = ReadCgroupMemory(dir);
+    BOOST_REQUIRE(memory);
+    BOOST_CHECK(memory->limit == 4000000U);
+}
+
+BOOST_AUTO_TEST_CASE(read_cgroup_v1)
+{
+    const fs::path dir{m_path_root / "cgroup_v1"};
+    WriteFile(dir / "memory" / "memory.usage_in_bytes", "500\n");
+    WriteFile(dir / "memory" / "memory.limit_in_bytes", "9223372036854771712\n");
+    auto memory{ReadCgroupMemory(dir)};
+    BOOST_REQUIRE(memory);
+    BOOST_CHECK_EQUAL(memory->usage, 500U);
+    BOOST_CHECK(!memory->limit);
+    BOOST_CHECK(!memory->pressure);
+
+    WriteFile(dir / "memory" / "memory.limit_in_bytes", "2000\n");
+    BOOST_CHECK(ReadCgroupMemory(dir)->limit == 2000U);
+}
+
+BOOST_AUTO_TEST_CASE(next_budget)
+{
+    const size_t configured{400_MiB};
+    const auto cgroup{[](uint64_t usage, std::optional<uint64_t> limit, std::optional<double> pressure = {}) {
+        return CgroupMemory{.limit = limit, .usage = usage, .pressure = pressure};
+    }};
+
+    // Without cgroup information the budget stays at, or returns to, the configured size.
+    BOOST_CHECK_EQUAL(NextCoinsCacheBudget(configured, {.budget = configured, .cgroup = {}}), configured);
+    BOOST_CHECK_EQUAL(NextCoinsCacheBudget(configured, {.budget = 200_MiB, .cgroup = {}}), 250_MiB);
+    BOOST_CHECK_EQUAL(NextCoinsCacheBudget(configured, {.budget = 800_MiB, .cgroup = {}}), configured);
+
+    // Memory pressure shrinks the budget, but not below a quarter of the configured size.
+    BOOST_CHECK_EQUAL(NextCoinsCacheBudget(configured, {.budget = configured, .cgroup = cgroup(0, std::nullopt, 20.0)}), 300_MiB);
+    BOOST_CHECK_EQUAL(NextCoinsCacheBudget(configured, {.budget = 120_MiB, .cgroup = cgroup(0, std::nullopt, 20.0)}), 100_MiB);
+    // Being close to the limit shrinks by the usage above the target.
+    BOOST_CHECK_EQUAL(NextCoinsCacheBudget(configured, {.budget = 1000_MiB, .cgroup = cgroup(1950_MiB, 2000_MiB)}), 650_MiB);
+
+    // A full cache that misses often grows into free memory.
+    const CoinsCacheObservation missing{.budget = configured, .usage = configured, .hits = 90, .misses = 10, .cgroup = cgroup(1000_MiB, 4000_MiB)};
+    BOOST_CHECK_EQUAL(NextCoinsCacheBudget(configured, missing), 500_MiB);
+    CoinsCacheObservation hitting{missing};
+    hitting.hits = 1000;
+    hitting.misses = 1;
+    BOOST_CHECK_EQUAL(NextCoinsCacheBudget(configured, hitting), configured);
+    CoinsCacheObservation not_full{missing};
+    not_full.usage = 100_MiB;
+    BOOST_CHECK_EQUAL(NextCoinsCacheBudget(configured, not_full), configured);
+    // Growth is limited to half of the room left below the target.
+    CoinsCacheObservation little_room{missing};
+    little_room.cgroup = cgroup(3180_MiB, 4000_MiB);
+    BOOST_CHECK_EQUAL(NextCoinsCacheBudget(configured, little_room), 410_MiB);
+    // Between the target and the shrink threshold, the budget is held.
+    little_room.cgroup = cgroup(3300_MiB, 4000_MiB);
+    BOOST_CHECK_EQUAL(NextCoinsCacheBudget(configured, little_room), configured);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
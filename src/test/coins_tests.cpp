@@ -1085,4 +1085,37 @@ BOOST_AUTO_TEST_CASE(coins_resource_is_used)
     PoolResourceTester::CheckAllDataAccountedFor(resource);
 }
 
+BOOST_AUTO_TEST_CASE(ccoins_prefetch)
+{
+    CCoinsViewDB base{{.path = "test", .cache_bytes = 1 << 23, .memory_only = true}, {}};
+    const COutPoint prefetched{Txid::FromUint256(m_rng.rand256()), 0};
+    const COutPoint modified{Txid::FromUint256(m_rng.rand256()), 1};
+    const Coin coin{CTxOut{100, CScript{} << OP_TRUE}, /*nHeightIn=*/1, /*fCoinBaseIn=*/false};
+    {
+        CCoinsViewCache cache{&base};
+        cache.SetBestBlock(m_rng.rand256());
+        cache.AddCoin(prefetched, Coin{coin}, /*possible_overwrite=*/false);
+        cache.AddCoin(modified, Coin{coin}, /*possible_overwrite=*/false);
+        BOOST_CHECK(cache.Flush());
+    }
+
+    CCoinsViewCache cache{&base};
+    cache.SetBestBlock(m_rng.rand256());
+    cache.SpendCoin(modified);
+    BOOST_CHECK_EQUAL(cache.GetCachedOutPoints(/*max_count=*/10).size(), 0U);
+
+    cache.PrefetchCoin(prefetched, *base.GetCoin(prefetched));
+    // An entry that is already cached, here a spent one, is kept.
+    cache.PrefetchCoin(modified, *base.GetCoin(modified));
+    BOOST_CHECK(cache.HaveCoinInCache(prefetched));
+    BOOST_CHECK(!cache.HaveCoinInCache(modified));
+    BOOST_CHECK(cache.GetCachedOutPoints(/*max_count=*/10) == std::vector{prefetched});
+    BOOST_CHECK(cache.GetCachedOutPoints(/*max_count=*/0).empty());
+
+    // Flushing writes the spend and leaves the prefetched coin in place.
+    BOOST_CHECK(cache.Flush());
+    BOOST_CHECK(base.GetCoin(prefetched));
+    BOOST_CHECK(!base.GetCoin(modified));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
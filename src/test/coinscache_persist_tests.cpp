@@ -0,0 +1,152 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <coins.h>
+#include <node/coinscache_persist.h>
+#include <primitives/transaction.h>
+#include <serialize.h>
+#include <streams.h>
+#include <sync.h>
+#include <test/util/setup_common.h>
+#include <util/fs.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <vector>
+
+using node::DumpCoinsCache;
+using node::LoadCoinsCache;
+
+namespace {
+struct CoinsCachePersistSetup : public TestChain100Setup {
+    // Leave no mempool headroom in the coins cache budget, so that the tests
+    // control when the cache counts as full.
+    CoinsCachePersistSetup() : TestChain100Setup{ChainType::REGTEST, {.extra_args = {"-maxmempool=0", "-limitdescendantsize=0"}}} {}
+
+    std::vector<COutPoint> CoinbaseOutPoints() const
+    {
+        std::vector<COutPoint> outpoints;
+        for (const auto& tx : m_coinbase_txns) outpoints.emplace_back(tx->GetHash(), 0);
+        return outpoints;
+    }
+
+    //! Write the cache to disk, which empties it.
+    void FlushCoinsCache()
+    {
+        LOCK(::cs_main);
+        m_node.chainman->ActiveChainstate().ForceFlushStateToDisk();
+    }
+
+    size_t CountCached(const std::vector<COutPoint>& outpoints)
+    {
+        LOCK(::cs_main);
+        const CCoinsViewCache& tip{m_node.chainman->ActiveChainstate().CoinsTip()};
+        size_t cached{0};
+        for (const auto& outpoint : outpoints) cached += tip.HaveCoinInCache(outpoint);
+        return cached;
+    }
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(coinscache_persist_tests, CoinsCachePersistSetup)
+
+BOOST_AUTO_TEST_CASE(dump_and_load)
+{
+    Chainstate& chainstate{m_node.chainman->ActiveChainstate()};
+    const fs::path path{m_args.GetDataDirNet() / "coinscache.dat"};
+    const auto outpoints{CoinbaseOutPoints()};
+
+    FlushCoinsCache();
+    BOOST_REQUIRE_EQUAL(CountCached(outpoints), 0U);
+    {
+        LOCK(::cs_main);
+        for (const auto& outpoint : outpoints) BOOST_REQUIRE(!chainstate.CoinsTip().AccessCoin(outpoint).IsSpent());
+    }
+    BOOST_REQUIRE_EQUAL(CountCached(outpoints), outpoints.size());
+    BOOST_REQUIRE(DumpCoinsCache(chainstate, path));
+
+    // The coins are read back from the database into the empty cache.
+    FlushCoinsCache();
+    BOOST_REQUIRE_EQUAL(CountCached(outpoints), 0U);
+    BOOST_CHECK(LoadCoinsCache(chainstate, path));
+    BOOST_CHECK_EQUAL(CountCached(outpoints), outpoints.size());
+    {
+        LOCK(::cs_main);
+        for (const auto& tx : m_coinbase_txns) {
+            BOOST_CHECK(chainstate.CoinsTip().AccessCoin(COutPoint{tx->GetHash(), 0}).out == tx->vout[0]);
+        }
+    }
+
+    // Outpoints that are no longer unspent are skipped.
+    const COutPoint unknown{Txid::FromUint256(m_rng.rand256()), 0};
+    {
+        AutoFile file{fsbridge::fopen(path, "wb")};
+        file << uint64_t{1} << uint64_t{2};
+        file << unknown.hash;
+        WriteCompactSize(file, 1);
+        file << VARINT(unknown.n);
+        file << outpoints[0].hash;
+        WriteCompactSize(file, 1);
+        file << VARINT(outpoints[0].n);
+        BOOST_REQUIRE_EQUAL(file.fclose(), 0);
+    }
+    FlushCoinsCache();
+    BOOST_CHECK(LoadCoinsCache(chainstate, path));
+    BOOST_CHECK_EQUAL(CountCached({outpoints[0]}), 1U);
+    BOOST_CHECK_EQUAL(CountCached({unknown}), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(load_failures)
+{
+    Chainstate& chainstate{m_node.chainman->ActiveChainstate()};
+    const fs::path path{m_args.GetDataDirNet() / "coinscache.dat"};
+    const auto outpoints{CoinbaseOutPoints()};
+
+    FlushCoinsCache();
+    BOOST_CHECK(!LoadCoinsCache(chainstate, path));
+    BOOST_CHECK(!LoadCoinsCache(chainstate, {}));
+
+    {
+        LOCK(::cs_main);
+        for (const auto& outpoint : outpoints) chainstate.CoinsTip().AccessCoin(outpoint);
+    }
+    BOOST_REQUIRE(DumpCoinsCache(chainstate, path));
+    std::vector<std::byte> contents;
+    {
+        AutoFile file{fsbridge::fopen(path, "rb")};
+        contents.resize(fs::file_size(path));
+        file.read(contents);
+    }
+    const auto write_file{[&](std::span<const std::byte> data) {
+        AutoFile file{fsbridge::fopen(path, "wb")};
+        file.write(data);
+        BOOST_REQUIRE_EQUAL(file.fclose(), 0);
+    }};
+
+    // A file of another version is ignored.
+    std::vector<std::byte> other_version{contents};
+    other_version[0] = std::byte{2};
+    write_file(other_version);
+    FlushCoinsCache();
+    BOOST_CHECK(!LoadCoinsCache(chainstate, path));
+    BOOST_CHECK_EQUAL(CountCached(outpoints), 0U);
+
+    // A truncated file fails to load.
+    write_file(std::span{contents}.first(contents.size() / 2));
+    BOOST_CHECK(!LoadCoinsCache(chainstate, path));
+
+    // Loading stops once the cache is full.
+    write_file(contents);
+    const size_t cache_size{chainstate.m_coinstip_cache_size_bytes};
+    chainstate.m_coinstip_cache_size_bytes = 1;
+    BOOST_CHECK(LoadCoinsCache(chainstate, path));
+    BOOST_CHECK_EQUAL(CountCached(outpoints), 0U);
+    chainstate.m_coinstip_cache_size_bytes = cache_size;
+    BOOST_CHECK(LoadCoinsCache(chainstate, path));
+    BOOST_CHECK_EQUAL(CountCached(outpoints), outpoints.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
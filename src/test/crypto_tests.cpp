@@ -587,6 +587,65 @@ BOOST_AUTO_TEST_CASE(hmac_sha512_testvectors) {
                    "fb29795e79f2ef27f68cb1e16d76178c307a67beaad9456fac5fdffeadb16e2c");
 }
 
+BOOST_AUTO_TEST_CASE(sha512_multi)
+{
+    // Compare FinalizeMulti with one scalar hash per input, for every
+    // multi-buffer implementation (1, 4 and 8 lanes) and for batches that
+    // leave lanes unused or need more than one pass.
+    using namespace sha512_implementation;
+    for (const auto use_implementation : {STANDARD, USE_AVX2, USE_AVX512}) {
+        const std::string implementation{SHA512AutoDetect(use_implementation)};
+        for (const size_t count : {1, 2, 3, 4, 5, 8, 9, 17}) {
+            // Equal lengths, as in BIP32 derivation, and mixed lengths that
+            // span different numbers of blocks.
+            for (const bool same_length : {true, false}) {
+                const auto prefix{m_rng.randbytes(m_rng.randrange(300))};
+                std::vector<std::vector<unsigned char>> data;
+                for (size_t i = 0; i < count; ++i) {
+                    data.push_back(m_rng.randbytes(same_length ? 37 : m_rng.randrange(300)));
+                }
+                const std::vector<std::span<const unsigned char>> inputs(data.begin(), data.end());
+                std::vector<unsigned char> out(count * CSHA512::OUTPUT_SIZE);
+                unsigned char expected[CSHA512::OUTPUT_SIZE];
+
+                CSHA512 sha;
+                sha.Write(prefix.data(), prefix.size());
+                sha.FinalizeMulti(inputs, out.data());
+                for (size_t i = 0; i < count; ++i) {
+                    CSHA512{sha}.Write(data[i].data(), data[i].size()).Finalize(expected);
+                    BOOST_CHECK_MESSAGE(std::equal(std::begin(expected), std::end(expected), out.begin() + i * CSHA512::OUTPUT_SIZE),
+                                        implementation << " sha512 input " << i << " of " << count);
+                }
+
+                CHMAC_SHA512 hmac{prefix.data(), prefix.size()};
+                hmac.Write(prefix.data(), prefix.size() / 2);
+                hmac.FinalizeMulti(inputs, out.data());
+                for (size_t i = 0; i < count; ++i) {
+                    CHMAC_SHA512{hmac}.Write(data[i].data(), data[i].size()).Finalize(expected);
+                    BOOST_CHECK_MESSAGE(std::equal(std::begin(expected), std::end(expected), out.begin() + i * CHMAC_SHA512::OUTPUT_SIZE),
+                                        implementation << " hmac input " << i << " of " << count);
+                }
+            }
+        }
+
+        // Test case 2 of RFC 4231, with the message split between the written
+        // data and the input.
+        const auto key{"4a656665"_hex_u8};
+        const auto msg{"7768617420646f2079612077616e7420666f72206e6f7468696e673f"_hex_u8};
+        CHMAC_SHA512 hmac{key.data(), key.size()};
+        hmac.Write(msg.data(), 10);
+        const std::vector<std::span<const unsigned char>> inputs(5, std::span{msg}.subspan(10));
+        std::vector<unsigned char> out(inputs.size() * CHMAC_SHA512::OUTPUT_SIZE);
+        hmac.FinalizeMulti(inputs, out.data());
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            BOOST_CHECK_EQUAL(HexStr(std::span{out}.subspan(i * CHMAC_SHA512::OUTPUT_SIZE, CHMAC_SHA512::OUTPUT_SIZE)),
+                              "164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea250554"
+                              "9758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737");
+        }
+    }
+    SHA512AutoDetect();
+}
+
 BOOST_AUTO_TEST_CASE(aes_testvectors) {
     // AES test vectors from FIPS 197.
     TestAES256("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f", "00112233445566778899aabbccddeeff", "8ea2b7ca516745bfeafc49904b496089");
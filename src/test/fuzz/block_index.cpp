@@ -27,7 +27,8 @@ bool operator==(const CBlockFileInfo& a, const CBlockFileInfo& b)
         a.nHeightFirst == b.nHeightFirst &&
         a.nHeightLast == b.nHeightLast &&
         a.nTimeFirst == b.nTimeFirst &&
-        a.nTimeLast == b.nTimeLast;
+        a.nTimeLast == b.nTimeLast &&
+        a.nPunchedBytes == b.nPunchedBytes;
 }
 
 CBlockHeader ConsumeBlockHeader(FuzzedDataProvider& provider)
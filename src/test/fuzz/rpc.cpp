@@ -144,6 +144,7 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "getnodeaddresses",
     "getorphantxs",
     "getpeerinfo",
+    "getperfcounters",
     "getprioritisedtransactions",
     "getrawaddrman",
     "getrawmempool",
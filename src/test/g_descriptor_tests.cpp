@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 BOOST_FIXTURE_TEST_SUITE(g_descriptor_tests, BasicTestingSetup)
 
@@ -175,6 +176,49 @@ BOOST_AUTO_TEST_CASE(descriptor_checksum_optional)
     BOOST_CHECK(!descs.empty());
 }
 
+BOOST_AUTO_TEST_CASE(descriptor_expand_range)
+{
+    // ExpandRange must produce what Expand and ExpandFromCache produce position by position
+    const std::string xprv = "xprv9s21ZrQH143K2LE7W4Xf3jATf9jECxSb7wj91ZnmY4qEJrS66Qru9RFqq8xbkgT32ya6HqYJweFdJUEDf5Q6JFV7jMiUws7kQfe6Tv4RbfN";
+    const std::string xpub = "xpub661MyMwAqRbcFW31YEwpkMuc5THy2PSt5bDMsktWQcFF8syAmRUapSCGu8ED9W6oDMSgv6Zz8idoc4a6mr8BDzTJY47LJhkJ8UB7WEGuduB";
+    const std::vector<std::string> desc_strs = {
+        "wpkh(" + xprv + "/84h/1h/0h/0/*)",
+        "tr(" + xprv + "/86h/1h/0h/1/*h)",
+        "wsh(multi(1,[d34db33f/48h]" + xpub + "/0/*," + xprv + "/1h/*h))",
+        "tr(" + xpub + ",multi_a(2," + xpub + "/0/*," + xprv + "/2h/1/*))",
+    };
+    constexpr int begin{5}, end{15};
+
+    for (const auto& desc_str : desc_strs) {
+        FlatSigningProvider keys;
+        std::string error;
+        auto descs = Parse(desc_str, keys, error, /*require_checksum=*/false);
+        BOOST_REQUIRE_MESSAGE(descs.size() == 1, error);
+        const auto& desc = descs.front();
+
+        std::vector<std::vector<CScript>> range_scripts, cached_scripts;
+        std::vector<FlatSigningProvider> range_out, cached_out;
+        DescriptorCache range_cache;
+        BOOST_REQUIRE(desc->ExpandRange(begin, end, keys, /*read_cache=*/nullptr, range_scripts, range_out, &range_cache));
+        BOOST_REQUIRE(desc->ExpandRange(begin, end, keys, &range_cache, cached_scripts, cached_out));
+        BOOST_REQUIRE_EQUAL(range_scripts.size(), size_t{end - begin});
+        BOOST_REQUIRE_EQUAL(range_out.size(), size_t{end - begin});
+        BOOST_REQUIRE_EQUAL(cached_scripts.size(), size_t{end - begin});
+
+        for (int pos = begin; pos < end; ++pos) {
+            std::vector<CScript> scripts;
+            FlatSigningProvider out;
+            BOOST_REQUIRE(desc->Expand(pos, keys, scripts, out));
+            BOOST_CHECK(scripts == range_scripts[pos - begin]);
+            BOOST_CHECK(scripts == cached_scripts[pos - begin]);
+            BOOST_CHECK(out.pubkeys == range_out[pos - begin].pubkeys);
+            BOOST_CHECK(out.origins == range_out[pos - begin].origins);
+            BOOST_CHECK(out.scripts == range_out[pos - begin].scripts);
+            BOOST_CHECK(out.pubkeys == cached_out[pos - begin].pubkeys);
+        }
+    }
+}
+
 BOOST_FIXTURE_TEST_CASE(g_descriptor_null_by_default, BasicTestingSetup)
 {
     // When no descriptor is configured, g_descriptor is nullptr
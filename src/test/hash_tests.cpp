@@ -11,6 +11,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <vector>
+
 BOOST_FIXTURE_TEST_SUITE(hash_tests, BasicTestingSetup)
 
 BOOST_AUTO_TEST_CASE(murmurhash3)
@@ -148,4 +150,27 @@ BOOST_AUTO_TEST_CASE(siphash)
     }
 }
 
+BOOST_AUTO_TEST_CASE(siphash_multi)
+{
+    BOOST_CHECK(SipHash_SelfTest());
+
+    // Check consistency between SipHashUint256Multi and SipHashUint256, for
+    // every count around the 4-value groups.
+    for (size_t count = 0; count <= 13; ++count) {
+        const uint64_t k0{m_rng.rand64()};
+        const uint64_t k1{m_rng.rand64()};
+        std::vector<uint256> vals(count);
+        std::vector<const uint256*> ptrs;
+        for (auto& val : vals) {
+            val = m_rng.rand256();
+            ptrs.push_back(&val);
+        }
+        std::vector<uint64_t> out(count);
+        SipHashUint256Multi(k0, k1, ptrs, out.data());
+        for (size_t i = 0; i < count; ++i) {
+            BOOST_CHECK_EQUAL(out[i], SipHashUint256(k0, k1, vals[i]));
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,205 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kernel/bitcoinkernel.h>
+
+#include <consensus/amount.h>
+#include <consensus/merkle.h>
+#include <crypto/sha256.h>
+#include <kernel/chainparams.h>
+#include <pow.h>
+#include <primitives/block.h>
+#include <primitives/transaction.h>
+#include <script/script.h>
+#include <streams.h>
+#include <uint256.h>
+
+#define BOOST_TEST_MODULE Bitcoin Kernel Test Suite
+#include <boost/test/included/unit_test.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+template <typename T, void (*Destroy)(T*)>
+struct Deleter {
+    void operator()(T* ptr) const { Destroy(ptr); }
+};
+using Context = std::unique_ptr<btck_Context, Deleter<btck_Context, btck_context_destroy>>;
+using ChainstateManager = std::unique_ptr<btck_ChainstateManager, Deleter<btck_ChainstateManager, btck_chainstate_manager_destroy>>;
+using Block = std::unique_ptr<btck_Block, Deleter<btck_Block, btck_block_destroy>>;
+using Transaction = std::unique_ptr<btck_Transaction, Deleter<btck_Transaction, btck_transaction_destroy>>;
+using TransactionOutput = std::unique_ptr<btck_TransactionOutput, Deleter<btck_TransactionOutput, btck_transaction_output_destroy>>;
+using TxData = std::unique_ptr<btck_PrecomputedTransactionData, Deleter<btck_PrecomputedTransactionData, btck_precomputed_transaction_data_destroy>>;
+
+struct TestDirectory {
+    std::filesystem::path path;
+    TestDirectory()
+        : path{std::filesystem::temp_directory_path() / ("test_kernel_" + std::to_string(std::random_device{}()))}
+    {
+        std::filesystem::create_directories(path);
+    }
+    ~TestDirectory() { std::filesystem::remove_all(path); }
+};
+
+//! Mine a regtest block with only a coinbase transaction on top of prev.
+std::vector<std::byte> MineBlock(const CChainParams& params, const uint256& prev, int height)
+{
+    CMutableTransaction coinbase;
+    coinbase.vin.resize(1);
+    coinbase.vin[0].scriptSig = CScript() << height << OP_0;
+    coinbase.vout.emplace_back(50 * COIN, CScript() << OP_TRUE);
+
+    CBlock block;
+    block.nVersion = 4;
+    block.hashPrevBlock = prev;
+    block.nTime = params.GenesisBlock().nTime + height * 600;
+    block.nBits = params.GenesisBlock().nBits;
+    block.vtx.push_back(MakeTransactionRef(std::move(coinbase)));
+    block.hashMerkleRoot = BlockMerkleRoot(block);
+    while (!CheckProofOfWork(block.GetHash(), block.nBits, params.GetConsensus())) ++block.nNonce;
+
+    DataStream stream{};
+    stream << TX_WITH_WITNESS(block);
+    return {stream.begin(), stream.end()};
+}
+
+//! Transaction with one input per entry of inputs, each with the given scriptSig and witness stack.
+Transaction SpendingTransaction(const std::vector<std::pair<CScript, std::vector<std::vector<unsigned char>>>>& inputs)
+{
+    CMutableTransaction mtx;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        mtx.vin.emplace_back(COutPoint{Txid::FromUint256(uint256::ONE), uint32_t(i)}, inputs[i].first);
+        mtx.vin.back().scriptWitness.stack = inputs[i].second;
+    }
+    mtx.vout.emplace_back(1 * COIN, CScript() << OP_TRUE);
+    DataStream stream{};
+    stream << TX_WITH_WITNESS(mtx);
+    return Transaction{btck_transaction_create(stream.data(), stream.size())};
+}
+//! Keep the kernel's log messages out of the test output, and print them
+//! when the test fails.
+struct KernelLogSetup {
+    KernelLogSetup()
+    {
+        btck_logging_set_callback([](void*, const char* message, size_t message_len) {
+            BOOST_TEST_MESSAGE(std::string(message, message_len));
+        }, nullptr);
+    }
+};
+} // namespace
+
+BOOST_TEST_GLOBAL_FIXTURE(KernelLogSetup);
+
+BOOST_AUTO_TEST_CASE(chainstate_manager_process_blocks)
+{
+    TestDirectory dir;
+    Context context{btck_context_create(btck_ChainType_REGTEST, /*script_threads=*/2)};
+    BOOST_REQUIRE(context);
+    const auto params{CChainParams::RegTest({})};
+    const std::string datadir{dir.path.string()};
+
+    std::vector<std::vector<std::byte>> raw_blocks;
+    {
+        ChainstateManager chainman{btck_chainstate_manager_create(context.get(), datadir.data(), datadir.size(), /*dbcache_bytes=*/0, /*worker_threads=*/1)};
+        BOOST_REQUIRE(chainman);
+        BOOST_CHECK_EQUAL(btck_chainstate_manager_get_tip_height(chainman.get()), 0);
+
+        uint256 prev{params->GenesisBlock().GetHash()};
+        for (int height = 1; height <= 5; ++height) {
+            raw_blocks.push_back(MineBlock(*params, prev, height));
+            Block block{btck_block_create(raw_blocks.back().data(), raw_blocks.back().size())};
+            BOOST_REQUIRE(block);
+            BOOST_CHECK_EQUAL(btck_block_count_transactions(block.get()), 1U);
+            int new_block{0};
+            BOOST_CHECK_EQUAL(btck_chainstate_manager_process_block(chainman.get(), block.get(), &new_block), 1);
+            BOOST_CHECK_EQUAL(new_block, 1);
+            btck_block_get_hash(block.get(), prev.begin());
+        }
+        BOOST_CHECK_EQUAL(btck_chainstate_manager_get_tip_height(chainman.get()), 5);
+
+        // Processing a block again is accepted, but it is not new.
+        Block block{btck_block_create(raw_blocks.back().data(), raw_blocks.back().size())};
+        int new_block{1};
+        BOOST_CHECK_EQUAL(btck_chainstate_manager_process_block(chainman.get(), block.get(), &new_block), 1);
+        BOOST_CHECK_EQUAL(new_block, 0);
+
+        // Trailing data is rejected.
+        std::vector<std::byte> trailing{raw_blocks.back()};
+        trailing.push_back(std::byte{0});
+        BOOST_CHECK(!btck_block_create(trailing.data(), trailing.size()));
+    }
+
+    // The chainstate is flushed on destruction and loaded again.
+    ChainstateManager chainman{btck_chainstate_manager_create(context.get(), datadir.data(), datadir.size(), /*dbcache_bytes=*/0, /*worker_threads=*/0)};
+    BOOST_REQUIRE(chainman);
+    BOOST_CHECK_EQUAL(btck_chainstate_manager_get_tip_height(chainman.get()), 5);
+    BOOST_CHECK_EQUAL(btck_chainstate_manager_import_blocks(chainman.get(), nullptr, nullptr, 0), 0);
+    BOOST_CHECK_EQUAL(btck_chainstate_manager_get_tip_height(chainman.get()), 5);
+}
+
+BOOST_AUTO_TEST_CASE(script_verify_batch)
+{
+    Context context{btck_context_create(btck_ChainType_REGTEST, /*script_threads=*/3)};
+    BOOST_REQUIRE(context);
+
+    // Spend outputs that need no signature: a bare OP_TRUE, and P2WSH outputs
+    // whose witness scripts leave true or false on the stack.
+    const CScript script_true{CScript() << OP_TRUE};
+    const CScript script_false{CScript() << OP_FALSE};
+    const auto p2wsh{[](const CScript& script) {
+        uint256 hash;
+        CSHA256().Write(script.data(), script.size()).Finalize(hash.begin());
+        return CScript() << OP_0 << std::vector<unsigned char>(hash.begin(), hash.end());
+    }};
+    const std::vector<CScript> spent_scripts{script_true, p2wsh(script_true), p2wsh(script_false)};
+    Transaction tx{SpendingTransaction({
+        {CScript{}, {}},
+        {CScript{}, {{script_true.begin(), script_true.end()}}},
+        {CScript{}, {{script_false.begin(), script_false.end()}}},
+    })};
+    BOOST_REQUIRE(tx);
+    BOOST_REQUIRE_EQUAL(btck_transaction_count_inputs(tx.get()), 3U);
+
+    std::vector<TransactionOutput> outputs;
+    std::vector<const btck_TransactionOutput*> output_ptrs;
+    for (const CScript& script : spent_scripts) {
+        outputs.emplace_back(btck_transaction_output_create(script.data(), script.size(), 2 * COIN));
+        output_ptrs.push_back(outputs.back().get());
+    }
+    BOOST_CHECK(!btck_precomputed_transaction_data_create(tx.get(), output_ptrs.data(), 2));
+    TxData txdata{btck_precomputed_transaction_data_create(tx.get(), output_ptrs.data(), output_ptrs.size())};
+    BOOST_REQUIRE(txdata);
+
+    const unsigned int flags{btck_ScriptFlags_ALL};
+    btck_ScriptVerifyStatus status;
+    BOOST_CHECK_EQUAL(btck_script_verify(txdata.get(), 0, flags, &status), 1);
+    BOOST_CHECK_EQUAL(status, btck_ScriptVerifyStatus_OK);
+    BOOST_CHECK_EQUAL(btck_script_verify(txdata.get(), 2, flags, &status), 0);
+    BOOST_CHECK_EQUAL(status, btck_ScriptVerifyStatus_ERROR_INVALID_SCRIPT);
+    BOOST_CHECK_EQUAL(btck_script_verify(txdata.get(), 3, flags, &status), 0);
+    BOOST_CHECK_EQUAL(status, btck_ScriptVerifyStatus_ERROR_TX_INPUT_INDEX);
+    BOOST_CHECK_EQUAL(btck_script_verify(txdata.get(), 1, btck_ScriptFlags_WITNESS, &status), 0);
+    BOOST_CHECK_EQUAL(status, btck_ScriptVerifyStatus_ERROR_INVALID_FLAGS_COMBINATION);
+
+    // A batch larger than the number of threads, with the invalid input in
+    // the middle.
+    std::vector<btck_ScriptVerifyJob> jobs;
+    for (int i = 0; i < 50; ++i) {
+        jobs.push_back({txdata.get(), i == 25 ? 2U : unsigned(i % 2), flags});
+    }
+    std::vector<int> results(jobs.size(), -1);
+    BOOST_CHECK_EQUAL(btck_script_verify_batch(context.get(), jobs.data(), jobs.size(), results.data()), 0);
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        BOOST_CHECK_EQUAL(results[i], i == 25 ? 0 : 1);
+    }
+
+    jobs.erase(jobs.begin() + 25);
+    BOOST_CHECK_EQUAL(btck_script_verify_batch(context.get(), jobs.data(), jobs.size(), nullptr), 1);
+    BOOST_CHECK_EQUAL(btck_script_verify_batch(context.get(), nullptr, 0, nullptr), 1);
+}
@@ -484,4 +484,30 @@ BOOST_FIXTURE_TEST_CASE(logging_filesize_rate_limit, LogSetup)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(logging_async_writer, LogSetup)
+{
+    LogInstance().DisconnectTestLogger();
+    LogInstance().m_async_policy = BCLog::AsyncLogPolicy::BLOCK;
+    // A tiny queue makes callers wait on the writer thread repeatedly.
+    LogInstance().m_max_async_queue = 100;
+    BOOST_REQUIRE(LogInstance().StartLogging());
+
+    constexpr int num_lines{1000};
+    for (int i = 0; i < num_lines; ++i) {
+        LogInfo("async line %d", i);
+    }
+    LogInstance().StopAsyncWriter();
+    LogInstance().m_async_policy = BCLog::AsyncLogPolicy::OFF;
+    LogInstance().m_max_async_queue = BCLog::DEFAULT_MAX_ASYNC_LOG_QUEUE;
+
+    std::vector<std::string> async_lines;
+    for (const std::string& line : ReadDebugLogLines()) {
+        if (line.starts_with("async line ")) async_lines.push_back(line);
+    }
+    BOOST_REQUIRE_EQUAL(async_lines.size(), size_t{num_lines});
+    for (int i = 0; i < num_lines; ++i) {
+        BOOST_CHECK_EQUAL(async_lines[i], strprintf("async line %d", i));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
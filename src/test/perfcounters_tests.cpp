@@ -0,0 +1,61 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <util/perfcounters.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_SUITE(perfcounters_tests)
+
+BOOST_AUTO_TEST_CASE(perfcounters_histogram)
+{
+    perf::Histogram histogram;
+    histogram.Add(500ns);
+    histogram.Add(1us);
+    histogram.Add(3us);
+    histogram.Add(3us);
+    histogram.Add(24h);
+    BOOST_CHECK_EQUAL(histogram.count, 5U);
+    BOOST_CHECK(histogram.total == 24h + 7500ns);
+    BOOST_CHECK(histogram.max == 24h);
+    BOOST_CHECK_EQUAL(histogram.buckets[0], 1U);
+    BOOST_CHECK_EQUAL(histogram.buckets[1], 1U);
+    BOOST_CHECK_EQUAL(histogram.buckets[2], 2U);
+    BOOST_CHECK_EQUAL(histogram.buckets[perf::NUM_BUCKETS - 1], 1U);
+}
+
+BOOST_AUTO_TEST_CASE(perfcounters_scoped_timer)
+{
+    perf::Snapshot(/*reset=*/true);
+    perf::SetEnabled(false);
+    { perf::ScopedTimer timer{"test", "disabled"}; }
+    BOOST_CHECK(perf::Snapshot(/*reset=*/false).empty());
+
+    perf::SetEnabled(true);
+    { perf::ScopedTimer timer{"test", "enabled"}; }
+    std::thread{[] {
+        perf::ScopedTimer first{"test", "enabled"};
+        perf::ScopedTimer second{"test", "enabled"};
+    }}.join();
+    perf::SetEnabled(false);
+
+    const auto threads{perf::Snapshot(/*reset=*/true)};
+    BOOST_REQUIRE_EQUAL(threads.size(), 2U);
+    uint64_t total{0};
+    for (const auto& thread : threads) {
+        BOOST_REQUIRE_EQUAL(thread.timers.size(), 1U);
+        BOOST_CHECK_EQUAL(thread.timers[0].group, "test");
+        BOOST_CHECK_EQUAL(thread.timers[0].name, "enabled");
+        total += thread.timers[0].histogram.count;
+    }
+    BOOST_CHECK_EQUAL(total, 3U);
+    BOOST_CHECK(perf::Snapshot(/*reset=*/false).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
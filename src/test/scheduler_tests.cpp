@@ -8,7 +8,10 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
+#include <future>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -212,4 +215,49 @@ BOOST_AUTO_TEST_CASE(mockforward)
     BOOST_CHECK(delta > 2*60 && delta < 3*60);
 }
 
+BOOST_AUTO_TEST_CASE(priority_order)
+{
+    CScheduler scheduler;
+    std::vector<int> order;
+    const auto now{std::chrono::steady_clock::now()};
+    scheduler.schedule([&order] { order.push_back(3); }, now, CScheduler::Priority::LOW);
+    scheduler.schedule([&order] { order.push_back(2); }, now, CScheduler::Priority::NORMAL);
+    scheduler.schedule([&order] { order.push_back(1); }, now, CScheduler::Priority::HIGH);
+    // Not due yet, so it must not run before the due LOW task.
+    scheduler.scheduleFromNow([&order] { order.push_back(4); }, std::chrono::milliseconds{50}, CScheduler::Priority::HIGH);
+
+    scheduler.m_service_thread = std::thread([&] { scheduler.serviceQueue(); });
+    scheduler.StopWhenDrained();
+    BOOST_CHECK((order == std::vector<int>{1, 2, 3, 4}));
+}
+
+BOOST_AUTO_TEST_CASE(low_priority_keeps_thread_free)
+{
+    CScheduler scheduler;
+    std::promise<void> release;
+    std::shared_future<void> released{release.get_future()};
+    std::atomic<int> low_running{0};
+    std::atomic<int> max_low_running{0};
+    std::atomic<bool> high_ran_during_low{false};
+
+    const auto low_task{[&] {
+        max_low_running = std::max(max_low_running.load(), ++low_running);
+        released.wait_for(std::chrono::seconds{10});
+        --low_running;
+    }};
+    scheduler.schedule(low_task, std::chrono::steady_clock::now(), CScheduler::Priority::LOW);
+    scheduler.schedule(low_task, std::chrono::steady_clock::now(), CScheduler::Priority::LOW);
+
+    scheduler.m_service_thread = std::thread([&] { scheduler.serviceQueue(); });
+    scheduler.m_worker_threads.emplace_back([&] { scheduler.serviceQueue(); });
+    scheduler.scheduleFromNow([&] {
+        high_ran_during_low = low_running > 0;
+        release.set_value();
+    }, std::chrono::milliseconds{20}, CScheduler::Priority::HIGH);
+    scheduler.StopWhenDrained();
+
+    BOOST_CHECK(high_ran_during_low);
+    BOOST_CHECK_EQUAL(max_low_running, 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1688,6 +1688,149 @@ BOOST_AUTO_TEST_CASE(bip341_keypath_test_vectors)
     }
 }
 
+BOOST_AUTO_TEST_CASE(multi_a_fast_path)
+{
+    using valtype = std::vector<unsigned char>;
+    constexpr unsigned int flags{SCRIPT_VERIFY_P2SH | SCRIPT_VERIFY_WITNESS | SCRIPT_VERIFY_TAPROOT | SCRIPT_VERIFY_MINIMALDATA | SCRIPT_VERIFY_NULLFAIL | SCRIPT_VERIFY_DISCOURAGE_OP_SUCCESS};
+
+    std::vector<CKey> keys;
+    for (int i = 0; i < 20; ++i) keys.push_back(GenerateRandomKey());
+
+    CMutableTransaction tx;
+    tx.vin.emplace_back(COutPoint{Txid::FromUint256(m_rng.rand256()), 0});
+    tx.vout.emplace_back(1000, CScript() << OP_TRUE);
+    PrecomputedTransactionData txdata;
+    txdata.Init(tx, {CTxOut{2000, CScript() << OP_1 << std::vector<unsigned char>(32, 1)}}, /*force=*/true);
+    const MutableTransactionSignatureChecker checker{&tx, 0, 2000, txdata, MissingDataBehavior::FAIL};
+
+    // <key_0> OP_CHECKSIG <key_1> OP_CHECKSIGADD ... <key_n-1> OP_CHECKSIGADD, without the threshold.
+    const auto keys_script{[&](size_t n) {
+        CScript script;
+        for (size_t i = 0; i < n; ++i) script << ToByteVector(XOnlyPubKey{keys[i].GetPubKey()}) << (i == 0 ? OP_CHECKSIG : OP_CHECKSIGADD);
+        return script;
+    }};
+    const auto multi_a{[&](size_t n, int64_t k) {
+        CScript script{keys_script(n)};
+        script << k << OP_NUMEQUAL;
+        return script;
+    }};
+    const auto script_execdata{[](const CScript& script) {
+        ScriptExecutionData execdata;
+        execdata.m_annex_init = true;
+        execdata.m_annex_present = false;
+        execdata.m_tapleaf_hash_init = true;
+        execdata.m_tapleaf_hash = ComputeTapleafHash(TAPROOT_LEAF_TAPSCRIPT, script);
+        execdata.m_codeseparator_pos_init = true;
+        execdata.m_codeseparator_pos = 0xFFFFFFFFUL;
+        return execdata;
+    }};
+    // Witness stack with signatures by the given keys, and empty signatures for the others.
+    const auto sign{[&](const CScript& script, size_t n, const std::vector<size_t>& signers) {
+        ScriptExecutionData execdata{script_execdata(script)};
+        uint256 hash;
+        BOOST_REQUIRE(SignatureHashSchnorr(hash, execdata, tx, 0, SIGHASH_DEFAULT, SigVersion::TAPSCRIPT, txdata, MissingDataBehavior::FAIL));
+        std::vector<valtype> stack(n);
+        for (size_t i : signers) {
+            // The signature for the first key is at the top of the stack
+            valtype& sig{stack[n - 1 - i]};
+            sig.resize(64);
+            BOOST_REQUIRE(keys[i].SignSchnorr(hash, sig, nullptr, m_rng.rand256()));
+        }
+        return stack;
+    }};
+    // Run the script through ExecuteWitnessScript, which takes the multi_a fast path for
+    // canonical scripts, and through the generic interpreter, and check that both agree.
+    const auto check{[&](const CScript& script, const std::vector<valtype>& stack, ScriptError expected, int64_t weight = 10'000) {
+        ScriptExecutionData execdata{script_execdata(script)};
+        execdata.m_validation_weight_left_init = true;
+        execdata.m_validation_weight_left = weight;
+
+        ScriptExecutionData fast_execdata{execdata};
+        ScriptError fast_err;
+        const bool fast{ExecuteWitnessScript(stack, script, flags, SigVersion::TAPSCRIPT, checker, fast_execdata, &fast_err)};
+
+        ScriptExecutionData generic_execdata{execdata};
+        ScriptError generic_err;
+        std::vector<valtype> generic_stack{stack};
+        bool generic{EvalScript(generic_stack, script, flags, checker, SigVersion::TAPSCRIPT, generic_execdata, &generic_err)};
+        if (generic && generic_stack.size() != 1) {
+            generic = false;
+            generic_err = SCRIPT_ERR_CLEANSTACK;
+        } else if (generic && generic_stack.back().empty()) {
+            generic = false;
+            generic_err = SCRIPT_ERR_EVAL_FALSE;
+        }
+
+        BOOST_CHECK_EQUAL(fast, generic);
+        BOOST_CHECK_EQUAL(ScriptErrorString(fast_err), ScriptErrorString(generic_err));
+        BOOST_CHECK_EQUAL(ScriptErrorString(fast_err), ScriptErrorString(expected));
+        BOOST_CHECK_EQUAL(fast, expected == SCRIPT_ERR_OK);
+        if (fast && generic) BOOST_CHECK_EQUAL(fast_execdata.m_validation_weight_left, generic_execdata.m_validation_weight_left);
+        return fast_execdata.m_validation_weight_left;
+    }};
+
+    // Valid spends, with k pushed as OP_k and, above 16, as a number.
+    check(multi_a(1, 1), sign(multi_a(1, 1), 1, {0}), SCRIPT_ERR_OK);
+    check(multi_a(3, 2), sign(multi_a(3, 2), 3, {0, 2}), SCRIPT_ERR_OK);
+    check(multi_a(3, 3), sign(multi_a(3, 3), 3, {0, 1, 2}), SCRIPT_ERR_OK);
+    {
+        const std::vector<size_t> signers{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 18};
+        check(multi_a(20, 18), sign(multi_a(20, 18), 20, signers), SCRIPT_ERR_OK);
+        check(multi_a(20, 17), sign(multi_a(20, 17), 20, signers), SCRIPT_ERR_EVAL_FALSE);
+    }
+
+    // The number of valid signatures must equal k exactly.
+    check(multi_a(3, 2), sign(multi_a(3, 2), 3, {0, 1, 2}), SCRIPT_ERR_EVAL_FALSE);
+    check(multi_a(3, 3), sign(multi_a(3, 3), 3, {1, 2}), SCRIPT_ERR_EVAL_FALSE);
+    check(multi_a(3, 1), sign(multi_a(3, 1), 3, {}), SCRIPT_ERR_EVAL_FALSE);
+
+    // A k that is not minimally encoded is left to the generic interpreter.
+    {
+        CScript direct_push{keys_script(3)};
+        direct_push << valtype{2} << OP_NUMEQUAL;
+        check(direct_push, sign(direct_push, 3, {0, 1}), SCRIPT_ERR_MINIMALDATA);
+        CScript padded{keys_script(3)};
+        padded << valtype{2, 0} << OP_NUMEQUAL;
+        check(padded, sign(padded, 3, {0, 1}), SCRIPT_ERR_UNKNOWN_ERROR);
+        CScript zero{keys_script(3)};
+        zero << OP_0 << OP_NUMEQUAL;
+        check(zero, sign(zero, 3, {}), SCRIPT_ERR_OK);
+    }
+
+    // Signatures that are not empty must be valid.
+    {
+        const CScript script{multi_a(3, 2)};
+        auto stack{sign(script, 3, {0, 2})};
+        stack[0][0] ^= 1;
+        check(script, stack, SCRIPT_ERR_SCHNORR_SIG);
+        stack = sign(script, 3, {0, 2});
+        stack[2].pop_back();
+        check(script, stack, SCRIPT_ERR_SCHNORR_SIG_SIZE);
+        stack = sign(script, 3, {0, 2});
+        stack[2].push_back(SIGHASH_DEFAULT);
+        check(script, stack, SCRIPT_ERR_SCHNORR_SIG_HASHTYPE);
+    }
+
+    // A stack that does not hold one element per key is left to the generic interpreter.
+    {
+        const CScript script{multi_a(3, 2)};
+        auto stack{sign(script, 3, {0, 1})};
+        stack.insert(stack.begin(), valtype{});
+        check(script, stack, SCRIPT_ERR_CLEANSTACK);
+        stack = sign(script, 3, {0, 1});
+        stack.erase(stack.begin());
+        check(script, stack, SCRIPT_ERR_INVALID_STACK_OPERATION);
+    }
+
+    // Each valid signature consumes validation weight.
+    {
+        const CScript script{multi_a(3, 3)};
+        const auto stack{sign(script, 3, {0, 1, 2})};
+        BOOST_CHECK_EQUAL(check(script, stack, SCRIPT_ERR_OK, 3 * VALIDATION_WEIGHT_PER_SIGOP_PASSED), 0);
+        check(script, stack, SCRIPT_ERR_TAPSCRIPT_VALIDATION_WEIGHT, 3 * VALIDATION_WEIGHT_PER_SIGOP_PASSED - 1);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(compute_tapbranch)
 {
     constexpr uint256 hash1{"8ad69ec7cf41c2a4001fd1f738bf1e505ce2277acdcaa63fe4765192497f47a7"};
@@ -3,13 +3,17 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <hash.h>
+#include <primitives/block.h>
+#include <primitives/transaction.h>
 #include <serialize.h>
 #include <streams.h>
 #include <test/util/setup_common.h>
 #include <util/strencodings.h>
 
 #include <cstdint>
+#include <ios>
 #include <string>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
@@ -496,4 +500,57 @@ BOOST_AUTO_TEST_CASE(with_params_derived)
                                     "0f\x02XY");
 }
 
+BOOST_AUTO_TEST_CASE(fixed_size)
+{
+    static_assert(FixedSerializeSize<COutPoint> == 36);
+    static_assert(FixedSerializeSize<CBlockHeader> == 80);
+    static_assert(!FixedSizeSerializable<CBlock>);
+
+    const COutPoint outpoint{Txid::FromUint256(m_rng.rand256()), m_rng.rand32()};
+    CBlockHeader header;
+    header.nVersion = m_rng.rand32();
+    header.hashPrevBlock = m_rng.rand256();
+    header.hashMerkleRoot = m_rng.rand256();
+    header.nTime = m_rng.rand32();
+    header.nBits = m_rng.rand32();
+    header.nNonce = m_rng.rand32();
+
+    // The buffered encoding is identical to serializing the fields one by one.
+    DataStream fields{};
+    fields << outpoint.hash << outpoint.n;
+    fields << header.nVersion << header.hashPrevBlock << header.hashMerkleRoot << header.nTime << header.nBits << header.nNonce;
+    DataStream ss{};
+    ss << outpoint << header;
+    BOOST_CHECK_EQUAL(HexStr(ss), HexStr(fields));
+    BOOST_CHECK_EQUAL(GetSerializeSize(outpoint), 36U);
+    BOOST_CHECK_EQUAL(GetSerializeSize(header), 80U);
+
+    COutPoint outpoint2;
+    CBlockHeader header2;
+    ss >> outpoint2 >> header2;
+    BOOST_CHECK(ss.empty());
+    BOOST_CHECK(outpoint2 == outpoint);
+    BOOST_CHECK_EQUAL(header2.GetHash(), header.GetHash());
+
+    // Vectors of fixed-size objects, including their size computation.
+    const std::vector<COutPoint> outpoints(300, outpoint);
+    ss << outpoints;
+    BOOST_CHECK_EQUAL(ss.size(), GetSerializeSize(outpoints));
+    BOOST_CHECK_EQUAL(GetSerializeSize(outpoints), 3U + 300 * 36);
+    std::vector<COutPoint> outpoints2;
+    ss >> outpoints2;
+    BOOST_CHECK(outpoints2 == outpoints);
+
+    // A derived class that adds fields is not treated as fixed size.
+    CBlock block{header};
+    block.vtx.push_back(MakeTransactionRef(CMutableTransaction{}));
+    BOOST_CHECK_EQUAL(GetSerializeSize(TX_WITH_WITNESS(block)), 80U + 1 + GetSerializeSize(TX_WITH_WITNESS(*block.vtx[0])));
+
+    // A truncated object fails like any other short read.
+    DataStream truncated{};
+    truncated << outpoint;
+    truncated.resize(35);
+    BOOST_CHECK_THROW(truncated >> outpoint2, std::ios_base::failure);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,68 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <util/threadpool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(threadpool_tests)
+
+BOOST_AUTO_TEST_CASE(threadpool_submit)
+{
+    ThreadPool pool{"test"};
+    pool.Start(3);
+    BOOST_CHECK_EQUAL(pool.WorkerCount(), 3U);
+
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 100; ++i) {
+        futures.push_back(pool.Submit([i] { return i * i; }));
+    }
+    for (int i = 0; i < 100; ++i) {
+        BOOST_CHECK_EQUAL(futures[i].get(), i * i);
+    }
+
+    // Exceptions are handed to whoever waits on the task.
+    auto failing{pool.Submit([]() -> int { throw std::runtime_error("task failed"); })};
+    BOOST_CHECK_THROW(failing.get(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(threadpool_stop_drains_queue)
+{
+    std::atomic<int> done{0};
+    std::vector<std::future<void>> futures;
+    {
+        ThreadPool pool{"test"};
+        pool.Start(2);
+        for (int i = 0; i < 50; ++i) {
+            futures.push_back(pool.Submit([&done] { ++done; }));
+        }
+        pool.Stop();
+        BOOST_CHECK_EQUAL(pool.WorkerCount(), 0U);
+    }
+    BOOST_CHECK_EQUAL(done, 50);
+    for (auto& future : futures) future.get();
+}
+
+BOOST_AUTO_TEST_CASE(threadpool_parallel_for)
+{
+    ThreadPool pool{"test"};
+    // Without workers everything runs on the calling thread.
+    for (const int workers : {0, 1, 4}) {
+        pool.Start(workers);
+        for (const size_t count : {0, 1, 3, 5, 1000}) {
+            std::vector<int> hits(count, 0);
+            pool.ParallelFor(count, [&](size_t i) { ++hits[i]; });
+            for (const int h : hits) BOOST_CHECK_EQUAL(h, 1);
+        }
+        BOOST_CHECK_THROW(pool.ParallelFor(100, [](size_t i) { if (i == 77) throw std::runtime_error("fail"); }), std::runtime_error);
+        pool.Stop();
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -756,4 +756,46 @@ BOOST_AUTO_TEST_CASE(TxRequestTest)
     }
 }
 
+BOOST_AUTO_TEST_CASE(compaction)
+{
+    // Track many announcements, and then forget most of them so that the tracker compacts its storage while
+    // some announcements are CANDIDATE_BEST, REQUESTED and waiting in the timer wheel.
+    TxRequestTracker txrequest;
+    std::vector<uint256> txhashes;
+    for (int i = 0; i < 3000; ++i) {
+        txhashes.push_back(m_rng.rand256());
+        for (NodeId peer = 0; peer < 2; ++peer) {
+            txrequest.ReceivedInv(peer, GenTxid{Txid::FromUint256(txhashes.back())}, /*preferred=*/peer == 0, std::chrono::seconds{i % 2});
+        }
+    }
+    BOOST_CHECK_EQUAL(txrequest.Size(), 6000U);
+    BOOST_CHECK_EQUAL(txrequest.GetRequestable(0, std::chrono::microseconds{1}).size(), 1500U);
+    for (int i = 0; i < 3000; i += 4) {
+        txrequest.RequestedTx(0, txhashes[i], std::chrono::seconds{10});
+    }
+    for (int i = 0; i < 3000; ++i) {
+        if (i % 8 >= 2) txrequest.ForgetTxHash(txhashes[i]);
+    }
+    txrequest.SanityCheck();
+    BOOST_CHECK_EQUAL(txrequest.Size(), 1500U);
+
+    // The remaining announcements still behave as before the compaction.
+    BOOST_CHECK_EQUAL(txrequest.CountInFlight(0), 375U);
+    const auto requestable{txrequest.GetRequestable(0, std::chrono::seconds{2})};
+    BOOST_CHECK_EQUAL(requestable.size(), 375U);
+    for (const GenTxid& gtxid : requestable) {
+        const auto it{std::ranges::find(txhashes, gtxid.ToUint256())};
+        BOOST_REQUIRE(it != txhashes.end());
+        BOOST_CHECK_EQUAL((it - txhashes.begin()) % 8, 1);
+    }
+    std::vector<std::pair<NodeId, GenTxid>> expired;
+    BOOST_CHECK_EQUAL(txrequest.GetRequestable(1, std::chrono::seconds{11}, &expired).size(), 375U);
+    BOOST_CHECK_EQUAL(expired.size(), 375U);
+    txrequest.SanityCheck();
+    txrequest.DisconnectedPeer(0);
+    txrequest.DisconnectedPeer(1);
+    txrequest.SanityCheck();
+    BOOST_CHECK_EQUAL(txrequest.Size(), 0U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
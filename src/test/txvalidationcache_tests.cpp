@@ -3,7 +3,9 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <consensus/validation.h>
+#include <core_memusage.h>
 #include <key.h>
+#include <memusage.h>
 #include <random.h>
 #include <script/sigcache.h>
 #include <script/sign.h>
@@ -109,6 +111,44 @@ BOOST_FIXTURE_TEST_CASE(tx_mempool_block_doublespend, Dersig100Setup)
     BOOST_CHECK_EQUAL(m_node.mempool->size(), 0U);
 }
 
+BOOST_FIXTURE_TEST_CASE(mempool_precomputed_txdata, TestChain100Setup)
+{
+    // A transaction accepted to the mempool keeps the data computed for its
+    // script checks, accounts for it in its memory usage, and block
+    // validation checks its scripts against that same data.
+    CScript scriptPubKey = CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG;
+    const CMutableTransaction tx{CreateValidMempoolTransaction(m_coinbase_txns[0], /*input_vout=*/0, /*input_height=*/1, coinbaseKey, scriptPubKey)};
+
+    std::shared_ptr<PrecomputedTransactionData> txdata;
+    {
+        LOCK(m_node.mempool->cs);
+        const auto entry{m_node.mempool->GetIter(CTransaction{tx}.GetWitnessHash())};
+        BOOST_REQUIRE(entry);
+        txdata = (*entry)->GetPrecomputedTxData();
+        BOOST_REQUIRE(txdata);
+        BOOST_CHECK(txdata->m_spent_outputs_ready);
+        BOOST_CHECK_EQUAL(txdata->m_spent_outputs.size(), tx.vin.size());
+        BOOST_CHECK(txdata->m_spent_outputs[0] == m_coinbase_txns[0]->vout[0]);
+
+        size_t txdata_usage{memusage::DynamicUsage(txdata) + memusage::DynamicUsage(txdata->m_spent_outputs)};
+        for (const CTxOut& out : txdata->m_spent_outputs) txdata_usage += RecursiveDynamicUsage(out);
+        BOOST_CHECK_EQUAL((*entry)->DynamicMemoryUsage(), RecursiveDynamicUsage((*entry)->GetSharedTx()) + txdata_usage);
+    }
+
+    // Forget that the scripts were executed, and make the shared data disagree
+    // with the chain: the block is now rejected, because ConnectBlock used it.
+    const CTxOut spent_output{txdata->m_spent_outputs[0]};
+    WITH_LOCK(cs_main, m_node.chainman->m_validation_cache.m_script_execution_cache.setup_bytes(1 << 20));
+    txdata->m_spent_outputs[0].scriptPubKey = CScript() << OP_FALSE;
+    CBlock block{CreateAndProcessBlock({tx}, scriptPubKey)};
+    BOOST_CHECK(WITH_LOCK(cs_main, return m_node.chainman->ActiveChain().Tip()->GetBlockHash()) != block.GetHash());
+
+    txdata->m_spent_outputs[0] = spent_output;
+    block = CreateAndProcessBlock({tx}, CScript() << OP_TRUE);
+    BOOST_CHECK(WITH_LOCK(cs_main, return m_node.chainman->ActiveChain().Tip()->GetBlockHash()) == block.GetHash());
+    BOOST_CHECK_EQUAL(m_node.mempool->size(), 0U);
+}
+
 // Run CheckInputScripts (using CoinsTip()) on the given transaction, for all script
 // flags.  Test that CheckInputScripts passes for all flags that don't overlap with
 // the failing_flags argument, but otherwise fails.
@@ -265,6 +265,7 @@ ChainTestingSetup::ChainTestingSetup(const ChainType chainType, TestOpts opts)
             .chainparams = chainparams,
             .datadir = m_args.GetDataDirNet(),
             .check_block_index = 1,
+            .check_block_index_incremental = m_node.args->GetBoolArg("-checkblockindexincremental", kernel::DEFAULT_CHECK_BLOCK_INDEX_INCREMENTAL),
             .notifications = *m_node.notifications,
             .signals = m_node.validation_signals.get(),
             // Use no worker threads while fuzzing to avoid non-determinism
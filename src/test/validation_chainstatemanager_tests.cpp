@@ -792,6 +792,47 @@ util::Result<Options> SetOptsFromArgs(ArgsManager& args_man, Options opts,
     return opts;
 }
 
+//! Test chain with -checkblockindexincremental, so that every block index
+//! check while building and changing it is incremental.
+struct IncrementalCheckBlockIndexSetup : TestChain100Setup {
+    IncrementalCheckBlockIndexSetup() : TestChain100Setup{ChainType::REGTEST, {.extra_args = {"-checkblockindexincremental"}}} {}
+};
+
+BOOST_FIXTURE_TEST_CASE(chainstatemanager_check_changed_block_index, IncrementalCheckBlockIndexSetup)
+{
+    ChainstateManager& chainman{*Assert(m_node.chainman)};
+    BOOST_CHECK(chainman.m_options.check_block_index_incremental);
+    Chainstate& chainstate{WITH_LOCK(::cs_main, return chainman.ActiveChainstate())};
+    mineBlocks(5);
+    chainman.CheckChangedBlockIndex();
+
+    // Entries written out by a flush are no longer dirty, and are tracked
+    // until the next check.
+    {
+        LOCK(::cs_main);
+        BOOST_CHECK(chainman.m_blockman.GetUncheckedBlockIndex().empty());
+        chainstate.ForceFlushStateToDisk();
+        BOOST_CHECK(chainman.m_blockman.GetUncheckedBlockIndex().contains(chainman.ActiveTip()));
+    }
+    chainman.CheckChangedBlockIndex();
+    BOOST_CHECK(WITH_LOCK(::cs_main, return chainman.m_blockman.GetUncheckedBlockIndex().empty()));
+
+    // Invalidating a block changes it and its descendants, which are then checked without walking the tree.
+    CBlockIndex* block{WITH_LOCK(::cs_main, return chainman.ActiveChain()[chainman.ActiveChain().Height() - 2])};
+    BlockValidationState state;
+    BOOST_CHECK(chainstate.InvalidateBlock(state, block));
+    chainman.CheckChangedBlockIndex();
+
+    {
+        LOCK(::cs_main);
+        chainstate.ResetBlockFailureFlags(block);
+        chainman.RecalculateBestHeader();
+    }
+    BOOST_CHECK(chainstate.ActivateBestChain(state));
+    chainman.CheckChangedBlockIndex();
+    chainman.CheckFullBlockIndex();
+}
+
 BOOST_FIXTURE_TEST_CASE(chainstatemanager_args, BasicTestingSetup)
 {
     //! Try to apply the provided args to a ChainstateManager::Options
@@ -834,6 +875,11 @@ BOOST_FIXTURE_TEST_CASE(chainstatemanager_args, BasicTestingSetup)
 
     BOOST_CHECK(!get_opts({"-minimumchainwork=xyz"}));                                                               // invalid hex characters
     BOOST_CHECK(!get_opts({"-minimumchainwork=01234567890123456789012345678901234567890123456789012345678901234"})); // > 64 hex chars
+
+    // test -checkblockindexincremental
+    BOOST_CHECK(!get_valid_opts({}).check_block_index_incremental);
+    BOOST_CHECK(get_valid_opts({"-checkblockindexincremental"}).check_block_index_incremental);
+    BOOST_CHECK(!get_valid_opts({"-nocheckblockindexincremental"}).check_block_index_incremental);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
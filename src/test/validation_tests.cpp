@@ -9,6 +9,7 @@
 #include <hash.h>
 #include <net.h>
 #include <signet.h>
+#include <streams.h>
 #include <uint256.h>
 #include <util/chaintype.h>
 #include <validation.h>
@@ -127,6 +128,68 @@ BOOST_AUTO_TEST_CASE(signet_parse_tests)
     BOOST_CHECK(!CheckSignetBlockSolution(block, signet_params->GetConsensus()));
 }
 
+BOOST_AUTO_TEST_CASE(signet_proof_tests)
+{
+    ArgsManager signet_argsman;
+    signet_argsman.ForceSetArg("-signetchallenge", "51"); // set challenge to OP_TRUE
+    const auto signet_params = CreateChainParams(signet_argsman, ChainType::SIGNET);
+    const Consensus::Params& consensus{signet_params->GetConsensus()};
+
+    std::vector<uint8_t> witness_commitment_section_141{0xaa, 0x21, 0xa9, 0xed};
+    for (int i = 0; i < 32; ++i) {
+        witness_commitment_section_141.push_back(0xff);
+    }
+    std::vector<uint8_t> witness_commitment_section_325{0xec, 0xc7, 0xda, 0xa2, 0x01, 0x51, 0x00};
+
+    CMutableTransaction cb;
+    cb.vin.emplace_back(COutPoint{}, CScript{} << OP_0);
+    cb.vout.emplace_back(0, CScript{} << OP_RETURN << witness_commitment_section_141 << witness_commitment_section_325);
+    CBlock block;
+    block.vtx.push_back(MakeTransactionRef(cb));
+    for (uint32_t i = 0; i < 4; ++i) {
+        CMutableTransaction tx;
+        tx.vin.emplace_back(COutPoint{Txid::FromUint256(uint256::ONE), i});
+        tx.vout.emplace_back(0, CScript{});
+        block.vtx.push_back(MakeTransactionRef(tx));
+    }
+    block.hashMerkleRoot = BlockMerkleRoot(block);
+
+    // valid solution, the proof agrees with the full block
+    SignetSolutionProof proof{MakeSignetSolutionProof(block)};
+    BOOST_CHECK(CheckSignetSolutionProofCommitment(proof));
+    BOOST_CHECK(CheckSignetBlockSolution(block, consensus));
+    BOOST_CHECK(CheckSignetSolutionProof(proof, consensus));
+    BOOST_CHECK(SignetTxs::Create(proof, CScript{OP_TRUE})->m_to_spend == SignetTxs::Create(block, CScript{OP_TRUE})->m_to_spend);
+
+    // serialization roundtrip
+    DataStream stream{};
+    stream << proof;
+    SignetSolutionProof proof2;
+    stream >> proof2;
+    BOOST_CHECK(proof2.header.GetHash() == proof.header.GetHash());
+    BOOST_CHECK(proof2.coinbase->GetWitnessHash() == proof.coinbase->GetWitnessHash());
+    BOOST_CHECK(proof2.coinbase_merkle_path == proof.coinbase_merkle_path);
+    BOOST_CHECK(CheckSignetSolutionProof(proof2, consensus));
+
+    // the proof must commit to the header
+    proof2.coinbase_merkle_path.back() = uint256::ONE;
+    BOOST_CHECK(!CheckSignetSolutionProofCommitment(proof2));
+    BOOST_CHECK(!CheckSignetSolutionProof(proof2, consensus));
+    proof2 = proof;
+    proof2.coinbase = block.vtx.at(1);
+    BOOST_CHECK(!CheckSignetSolutionProofCommitment(proof2));
+
+    // invalid solution, rejected from the proof alone
+    witness_commitment_section_325.pop_back();
+    cb.vout.at(0).scriptPubKey = CScript{} << OP_RETURN << witness_commitment_section_141 << witness_commitment_section_325;
+    block.vtx.at(0) = MakeTransactionRef(cb);
+    block.hashMerkleRoot = BlockMerkleRoot(block);
+    proof = MakeSignetSolutionProof(block);
+    BOOST_CHECK(CheckSignetSolutionProofCommitment(proof));
+    BOOST_CHECK(!CheckSignetBlockSolution(block, consensus));
+    BOOST_CHECK(!CheckSignetSolutionProof(proof, consensus));
+}
+
 //! Test retrieval of valid assumeutxo values.
 BOOST_AUTO_TEST_CASE(test_assumeutxo)
 {
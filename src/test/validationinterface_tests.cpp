@@ -12,7 +12,11 @@
 #include <validationinterface.h>
 
 #include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
 #include <memory>
+#include <thread>
 
 BOOST_FIXTURE_TEST_SUITE(validationinterface_tests, ChainTestingSetup)
 
@@ -100,4 +104,81 @@ BOOST_AUTO_TEST_CASE(unregister_all_during_call)
     BOOST_CHECK(destroyed);
 }
 
+struct TestSubscriberFlushed final : public CValidationInterface {
+    explicit TestSubscriberFlushed(std::function<void()> on_flushed) : m_on_flushed{std::move(on_flushed)} {}
+    void ChainStateFlushed(ChainstateRole, const CBlockLocator&) override { m_on_flushed(); }
+    std::function<void()> m_on_flushed;
+};
+
+BOOST_AUTO_TEST_CASE(per_subscriber_queues)
+{
+    CScheduler scheduler;
+    scheduler.m_service_thread = std::thread([&] { scheduler.serviceQueue(); });
+    scheduler.m_worker_threads.emplace_back([&] { scheduler.serviceQueue(); });
+    ValidationSignals signals{std::make_unique<SerialTaskRunner>(scheduler),
+                              [&] { return std::make_unique<SerialTaskRunner>(scheduler); }};
+
+    std::promise<void> release;
+    std::shared_future<void> released{release.get_future()};
+    int slow_calls{0};
+    auto slow{std::make_shared<TestSubscriberFlushed>([&] {
+        released.wait();
+        ++slow_calls;
+    })};
+    std::promise<void> fast_done;
+    int fast_calls{0};
+    auto fast{std::make_shared<TestSubscriberFlushed>([&] {
+        if (++fast_calls == 3) fast_done.set_value();
+    })};
+    signals.RegisterSharedValidationInterface(slow);
+    signals.RegisterSharedValidationInterface(fast);
+
+    for (int i = 0; i < 3; ++i) signals.ChainStateFlushed(ChainstateRole::NORMAL, CBlockLocator{});
+
+    // The fast subscriber receives every event while the slow one is still
+    // stuck on the first.
+    BOOST_CHECK(fast_done.get_future().wait_for(std::chrono::seconds{10}) == std::future_status::ready);
+    BOOST_CHECK_EQUAL(signals.CallbacksPending(), 2U);
+
+    release.set_value();
+    signals.SyncWithValidationInterfaceQueue();
+    BOOST_CHECK_EQUAL(slow_calls, 3);
+    BOOST_CHECK_EQUAL(signals.CallbacksPending(), 0U);
+
+    signals.UnregisterAllValidationInterfaces();
+    scheduler.stop();
+}
+
+// Regression test to ensure events queued for a subscriber are not delivered
+// once it is unregistered, as it may be destroyed before they run. At
+// shutdown, the scheduler is stopped with events still queued, PeerManager is
+// destroyed, and the remaining events are flushed afterwards.
+BOOST_AUTO_TEST_CASE(unregister_with_queued_events)
+{
+    CScheduler scheduler;
+    ValidationSignals signals{std::make_unique<SerialTaskRunner>(scheduler),
+                              [&] { return std::make_unique<SerialTaskRunner>(scheduler); }};
+
+    int kept_calls{0};
+    TestSubscriberFlushed kept{[&] { ++kept_calls; }};
+    int dropped_calls{0};
+    auto dropped{std::make_unique<TestSubscriberFlushed>([&] { ++dropped_calls; })};
+    signals.RegisterValidationInterface(&kept);
+    signals.RegisterValidationInterface(dropped.get());
+
+    // No thread services the scheduler, so the event stays queued for both.
+    signals.ChainStateFlushed(ChainstateRole::NORMAL, CBlockLocator{});
+    BOOST_CHECK_EQUAL(signals.CallbacksPending(), 2U);
+
+    signals.UnregisterValidationInterface(dropped.get());
+    dropped.reset();
+
+    signals.FlushBackgroundCallbacks();
+    BOOST_CHECK_EQUAL(kept_calls, 1);
+    BOOST_CHECK_EQUAL(dropped_calls, 0);
+    BOOST_CHECK_EQUAL(signals.CallbacksPending(), 0U);
+
+    signals.UnregisterAllValidationInterfaces();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -10,16 +10,18 @@
 #include <random.h>
 #include <uint256.h>
 
-#include <boost/multi_index/indexed_by.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/sequenced_index.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index_container.hpp>
-#include <boost/tuple/tuple.hpp>
+#include <util/hasher.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <cassert>
 
@@ -28,7 +30,7 @@ namespace {
 /** The various states a (txhash,peer) pair can be in.
  *
  * Note that CANDIDATE is split up into 3 substates (DELAYED, BEST, READY), allowing more efficient implementation.
- * Also note that the sorting order of ByTxHashView relies on the specific order of values in this enum.
+ * Also note that the order of GetCandidatePeers results relies on the specific order of values in this enum.
  *
  * Expected behaviour is:
  *   - When first announced by a peer, the state is CANDIDATE_DELAYED until reqtime is reached.
@@ -57,22 +59,44 @@ enum class State : uint8_t {
 //! Type alias for sequence numbers.
 using SequenceNumber = uint64_t;
 
+//! Type alias for priorities.
+using Priority = uint64_t;
+
+//! Index into the announcement or txhash arrays.
+using Slot = uint32_t;
+
+//! Marks the absence of a slot.
+constexpr Slot NO_SLOT{std::numeric_limits<Slot>::max()};
+
 /** An announcement. This is the data we track for each txid or wtxid that is announced to us by each peer. */
 struct Announcement {
     /** Txid or wtxid that was announced. */
-    const GenTxid m_gtxid;
+    GenTxid m_gtxid;
     /** For CANDIDATE_{DELAYED,BEST,READY} the reqtime; for REQUESTED the expiry. */
     std::chrono::microseconds m_time;
     /** What peer the request was from. */
-    const NodeId m_peer;
+    NodeId m_peer;
+    /** The priority of this announcement, see PriorityComputer. */
+    Priority m_priority;
     /** What sequence number this announcement has. */
-    const SequenceNumber m_sequence : 59;
+    SequenceNumber m_sequence : 59;
     /** Whether the request is preferred. */
-    const bool m_preferred : 1;
+    bool m_preferred : 1;
     /** What state this announcement is in. */
     State m_state : 3 {State::CANDIDATE_DELAYED};
     State GetState() const { return m_state; }
-    void SetState(State state) { m_state = state; }
+
+    /** Slot of the announced txhash, or NO_SLOT if this announcement slot is unused. */
+    Slot m_tx{NO_SLOT};
+    /** Position in the txhash's list of announcements. */
+    uint32_t m_tx_pos{0};
+    /** Position in the peer's list of announcements. */
+    uint32_t m_peer_pos{0};
+    /** Timer wheel bucket, if IsWaiting(). */
+    uint32_t m_bucket{0};
+    /** Position in the timer wheel bucket if IsWaiting(), or in the peer's list of CANDIDATE_BEST announcements if
+     *  CANDIDATE_BEST. */
+    uint32_t m_aux_pos{0};
 
     /** Whether this announcement is selected. There can be at most 1 selected peer per txhash. */
     bool IsSelected() const
@@ -94,13 +118,11 @@ struct Announcement {
 
     /** Construct a new announcement from scratch, initially in CANDIDATE_DELAYED state. */
     Announcement(const GenTxid& gtxid, NodeId peer, bool preferred, std::chrono::microseconds reqtime,
-                 SequenceNumber sequence)
-        : m_gtxid(gtxid), m_time(reqtime), m_peer(peer), m_sequence(sequence), m_preferred(preferred) {}
+                 SequenceNumber sequence, Priority priority)
+        : m_gtxid(gtxid), m_time(reqtime), m_peer(peer), m_priority(priority), m_sequence(sequence),
+          m_preferred(preferred) {}
 };
 
-//! Type alias for priorities.
-using Priority = uint64_t;
-
 /** A functor with embedded salt that computes priority of an announcement.
  *
  * Higher priorities are selected first.
@@ -124,112 +146,24 @@ public:
     }
 };
 
-// Definitions for the 3 indexes used in the main data structure.
-//
-// Each index has a By* type to identify it, a By*View data type to represent the view of announcement it is sorted
-// by, and an By*ViewExtractor type to convert an announcement into the By*View type.
-// See https://www.boost.org/doc/libs/1_58_0/libs/multi_index/doc/reference/key_extraction.html#key_extractors
-// for more information about the key extraction concept.
-
-// The ByPeer index is sorted by (peer, state == CANDIDATE_BEST, txhash)
-//
-// Uses:
-// * Looking up existing announcements by peer/txhash, by checking both (peer, false, txhash) and
-//   (peer, true, txhash).
-// * Finding all CANDIDATE_BEST announcements for a given peer in GetRequestable.
-struct ByPeer {};
-using ByPeerView = std::tuple<NodeId, bool, const uint256&>;
-struct ByPeerViewExtractor
-{
-    using result_type = ByPeerView;
-    result_type operator()(const Announcement& ann) const
-    {
-        return ByPeerView{ann.m_peer, ann.GetState() == State::CANDIDATE_BEST, ann.m_gtxid.ToUint256()};
-    }
-};
-
-// The ByTxHash index is sorted by (txhash, state, priority).
-//
-// Note: priority == 0 whenever state != CANDIDATE_READY.
-//
-// Uses:
-// * Deleting all announcements with a given txhash in ForgetTxHash.
-// * Finding the best CANDIDATE_READY to convert to CANDIDATE_BEST, when no other CANDIDATE_READY or REQUESTED
-//   announcement exists for that txhash.
-// * Determining when no more non-COMPLETED announcements for a given txhash exist, so the COMPLETED ones can be
-//   deleted.
-struct ByTxHash {};
-using ByTxHashView = std::tuple<const uint256&, State, Priority>;
-class ByTxHashViewExtractor {
-    const PriorityComputer& m_computer;
-public:
-    explicit ByTxHashViewExtractor(const PriorityComputer& computer) : m_computer(computer) {}
-    using result_type = ByTxHashView;
-    result_type operator()(const Announcement& ann) const
-    {
-        const Priority prio = (ann.GetState() == State::CANDIDATE_READY) ? m_computer(ann) : 0;
-        return ByTxHashView{ann.m_gtxid.ToUint256(), ann.GetState(), prio};
-    }
-};
-
-enum class WaitState {
-    //! Used for announcements that need efficient testing of "is their timestamp in the future?".
-    FUTURE_EVENT,
-    //! Used for announcements whose timestamp is not relevant.
-    NO_EVENT,
-    //! Used for announcements that need efficient testing of "is their timestamp in the past?".
-    PAST_EVENT,
+/** The announcements for one txhash. Slots are reused once a txhash is forgotten. */
+struct TxHashEntry {
+    uint256 m_txhash;
+    //! All announcements for this txhash, in no particular order.
+    std::vector<Slot> m_anns;
+    //! The CANDIDATE_BEST or REQUESTED announcement, if any.
+    Slot m_selected{NO_SLOT};
+    //! Number of announcements that are not COMPLETED.
+    uint32_t m_non_completed{0};
 };
 
-WaitState GetWaitState(const Announcement& ann)
-{
-    if (ann.IsWaiting()) return WaitState::FUTURE_EVENT;
-    if (ann.IsSelectable()) return WaitState::PAST_EVENT;
-    return WaitState::NO_EVENT;
-}
-
-// The ByTime index is sorted by (wait_state, time).
-//
-// All announcements with a timestamp in the future can be found by iterating the index forward from the beginning.
-// All announcements with a timestamp in the past can be found by iterating the index backwards from the end.
-//
-// Uses:
-// * Finding CANDIDATE_DELAYED announcements whose reqtime has passed, and REQUESTED announcements whose expiry has
-//   passed.
-// * Finding CANDIDATE_READY/BEST announcements whose reqtime is in the future (when the clock time went backwards).
-struct ByTime {};
-using ByTimeView = std::pair<WaitState, std::chrono::microseconds>;
-struct ByTimeViewExtractor
-{
-    using result_type = ByTimeView;
-    result_type operator()(const Announcement& ann) const
-    {
-        return ByTimeView{GetWaitState(ann), ann.m_time};
-    }
-};
-
-struct Announcement_Indices final : boost::multi_index::indexed_by<
-    boost::multi_index::ordered_unique<boost::multi_index::tag<ByPeer>, ByPeerViewExtractor>,
-    boost::multi_index::ordered_non_unique<boost::multi_index::tag<ByTxHash>, ByTxHashViewExtractor>,
-    boost::multi_index::ordered_non_unique<boost::multi_index::tag<ByTime>, ByTimeViewExtractor>
->
-{};
-
-/** Data type for the main data structure (Announcement objects with ByPeer/ByTxHash/ByTime indexes). */
-using Index = boost::multi_index_container<
-    Announcement,
-    Announcement_Indices
->;
-
-/** Helper type to simplify syntax of iterator types. */
-template<typename Tag>
-using Iter = typename Index::index<Tag>::type::iterator;
-
-/** Per-peer statistics object. */
+/** Per-peer statistics object, and the peer's announcements. */
 struct PeerInfo {
     size_t m_total = 0; //!< Total number of announcements for this peer.
     size_t m_completed = 0; //!< Number of COMPLETED announcements for this peer.
     size_t m_requested = 0; //!< Number of REQUESTED announcements for this peer.
+    std::vector<Slot> m_anns; //!< All announcements of this peer, in no particular order.
+    std::vector<Slot> m_best; //!< The CANDIDATE_BEST announcements of this peer, in no particular order.
 };
 
 /** Per-txhash statistics object. Only used for sanity checking. */
@@ -258,11 +192,12 @@ bool operator==(const PeerInfo& a, const PeerInfo& b)
            std::tie(b.m_total, b.m_completed, b.m_requested);
 };
 
-/** (Re)compute the PeerInfo map from the index. Only used for sanity checking. */
-std::unordered_map<NodeId, PeerInfo> RecomputePeerInfo(const Index& index)
+/** (Re)compute the PeerInfo map from the announcements. Only used for sanity checking. */
+std::unordered_map<NodeId, PeerInfo> RecomputePeerInfo(const std::vector<Announcement>& anns)
 {
     std::unordered_map<NodeId, PeerInfo> ret;
-    for (const Announcement& ann : index) {
+    for (const Announcement& ann : anns) {
+        if (ann.m_tx == NO_SLOT) continue;
         PeerInfo& info = ret[ann.m_peer];
         ++info.m_total;
         info.m_requested += (ann.GetState() == State::REQUESTED);
@@ -272,10 +207,11 @@ std::unordered_map<NodeId, PeerInfo> RecomputePeerInfo(const Index& index)
 }
 
 /** Compute the TxHashInfo map. Only used for sanity checking. */
-std::map<uint256, TxHashInfo> ComputeTxHashInfo(const Index& index, const PriorityComputer& computer)
+std::map<uint256, TxHashInfo> ComputeTxHashInfo(const std::vector<Announcement>& anns, const PriorityComputer& computer)
 {
     std::map<uint256, TxHashInfo> ret;
-    for (const Announcement& ann : index) {
+    for (const Announcement& ann : anns) {
+        if (ann.m_tx == NO_SLOT) continue;
         TxHashInfo& info = ret[ann.m_gtxid.ToUint256()];
         // Classify how many announcements of each state we have for this txhash.
         info.m_candidate_delayed += (ann.GetState() == State::CANDIDATE_DELAYED);
@@ -295,9 +231,40 @@ std::map<uint256, TxHashInfo> ComputeTxHashInfo(const Index& index, const Priori
     return ret;
 }
 
+/** Remove the element at pos from an unordered list of slots, updating the position stored for the element that
+ *  takes its place. */
+template <typename PosOf>
+void SwapRemove(std::vector<Slot>& list, uint32_t pos, PosOf pos_of)
+{
+    if (pos + 1 != list.size()) {
+        list[pos] = list.back();
+        pos_of(list[pos]) = pos;
+    }
+    list.pop_back();
+}
+
+/** The timer wheel has TIMER_WHEEL_SIZE buckets, each covering 2^TIMER_WHEEL_SHIFT microseconds (~65ms), so one
+ *  turn spans ~67s, which covers the usual reqtime delays and request expiry. Announcements further in the future
+ *  stay in their bucket for more than one turn. */
+constexpr int TIMER_WHEEL_SHIFT{16};
+constexpr size_t TIMER_WHEEL_SIZE{1024};
+
+int64_t TimerTick(std::chrono::microseconds time) { return time.count() >> TIMER_WHEEL_SHIFT; }
+
+/** The announcement array is compacted once it has at least COMPACT_MIN_SLOTS slots, of which at most a quarter are
+ *  used. */
+constexpr size_t COMPACT_MIN_SLOTS{1024};
+
 }  // namespace
 
-/** Actual implementation for TxRequestTracker's data structure. */
+/** Actual implementation for TxRequestTracker's data structure.
+ *
+ * Announcements live in a flat array, and refer to their txhash by slot in a second flat array, which a hash map
+ * from txhash to slot interns. Each txhash and each peer keep an unordered list of their announcements, and every
+ * announcement stores its position in those lists, so that all updates are O(1) apart from scanning the (few)
+ * announcements of a single txhash. IsWaiting() announcements are additionally kept in a timer wheel, keyed by
+ * their m_time.
+ */
 class TxRequestTracker::Impl {
     //! The current sequence number. Increases for every announcement. This is used to sort txhashes returned by
     //! GetRequestable in announcement order.
@@ -306,21 +273,36 @@ class TxRequestTracker::Impl {
     //! This tracker's priority computer.
     const PriorityComputer m_computer;
 
-    //! This tracker's main data structure. See SanityCheck() for the invariants that apply to it.
-    Index m_index;
+    //! All announcements. Entries with m_tx == NO_SLOT are unused, and listed in m_free_anns.
+    std::vector<Announcement> m_anns;
+    std::vector<Slot> m_free_anns;
+
+    //! The txhashes with at least one announcement. Unused entries are listed in m_free_txs.
+    std::vector<TxHashEntry> m_txs;
+    std::vector<Slot> m_free_txs;
+    std::unordered_map<uint256, Slot, SaltedUint256Hasher> m_tx_slots;
 
     //! Map with this tracker's per-peer statistics.
     std::unordered_map<NodeId, PeerInfo> m_peerinfo;
 
+    //! Buckets of IsWaiting() announcements, see TIMER_WHEEL_SIZE. Announcements with a time at or before the tick
+    //! m_wheel_cursor are kept in the cursor's bucket.
+    std::vector<std::vector<Slot>> m_wheel = std::vector<std::vector<Slot>>(TIMER_WHEEL_SIZE);
+    int64_t m_wheel_cursor{0};
+
+    //! The time passed to the last SetTimePoint() call. No CANDIDATE_READY or CANDIDATE_BEST announcement has a
+    //! later m_time.
+    std::optional<std::chrono::microseconds> m_last_now;
+
 public:
     void SanityCheck() const
     {
-        // Recompute m_peerdata from m_index. This verifies the data in it as it should just be caching statistics
-        // on m_index. It also verifies the invariant that no PeerInfo announcements with m_total==0 exist.
-        assert(m_peerinfo == RecomputePeerInfo(m_index));
+        // Recompute m_peerdata from m_anns. This verifies the data in it as it should just be caching statistics
+        // on m_anns. It also verifies the invariant that no PeerInfo announcements with m_total==0 exist.
+        assert(m_peerinfo == RecomputePeerInfo(m_anns));
 
-        // Calculate per-txhash statistics from m_index, and validate invariants.
-        for (auto& item : ComputeTxHashInfo(m_index, m_computer)) {
+        // Calculate per-txhash statistics from m_anns, and validate invariants.
+        for (auto& item : ComputeTxHashInfo(m_anns, m_computer)) {
             TxHashInfo& info = item.second;
 
             // Cannot have only COMPLETED peer (txhash should have been forgotten already)
@@ -345,11 +327,48 @@ public:
             std::sort(info.m_peers.begin(), info.m_peers.end());
             assert(std::adjacent_find(info.m_peers.begin(), info.m_peers.end()) == info.m_peers.end());
         }
+
+        // Check that the lists and positions kept for every announcement are consistent.
+        size_t waiting{0};
+        for (Slot idx = 0; idx < m_anns.size(); ++idx) {
+            const Announcement& ann = m_anns[idx];
+            if (ann.m_tx == NO_SLOT) continue;
+            const TxHashEntry& tx = m_txs[ann.m_tx];
+            assert(tx.m_txhash == ann.m_gtxid.ToUint256());
+            assert(m_tx_slots.at(tx.m_txhash) == ann.m_tx);
+            assert(tx.m_anns.at(ann.m_tx_pos) == idx);
+            assert(ann.IsSelected() == (tx.m_selected == idx));
+            assert(ann.m_priority == m_computer(ann));
+            const PeerInfo& peer = m_peerinfo.at(ann.m_peer);
+            assert(peer.m_anns.at(ann.m_peer_pos) == idx);
+            if (ann.GetState() == State::CANDIDATE_BEST) assert(peer.m_best.at(ann.m_aux_pos) == idx);
+            if (ann.IsWaiting()) {
+                assert(m_wheel.at(ann.m_bucket).at(ann.m_aux_pos) == idx);
+                ++waiting;
+            }
+        }
+        size_t wheel_size{0};
+        for (const auto& bucket : m_wheel) wheel_size += bucket.size();
+        assert(wheel_size == waiting);
+        for (const TxHashEntry& tx : m_txs) {
+            if (tx.m_anns.empty()) continue;
+            assert(tx.m_non_completed == size_t(std::count_if(tx.m_anns.begin(), tx.m_anns.end(), [&](Slot idx) {
+                return m_anns[idx].GetState() != State::COMPLETED;
+            })));
+        }
+        size_t total{0};
+        for (const auto& [peer, info] : m_peerinfo) {
+            assert(info.m_anns.size() == info.m_total);
+            total += info.m_total;
+        }
+        assert(total == m_anns.size() - m_free_anns.size());
+        assert(m_tx_slots.size() == m_txs.size() - m_free_txs.size());
     }
 
     void PostGetRequestableSanityCheck(std::chrono::microseconds now) const
     {
-        for (const Announcement& ann : m_index) {
+        for (const Announcement& ann : m_anns) {
+            if (ann.m_tx == NO_SLOT) continue;
             if (ann.IsWaiting()) {
                 // REQUESTED and CANDIDATE_DELAYED must have a time in the future (they should have been converted
                 // to COMPLETED/CANDIDATE_READY respectively).
@@ -363,116 +382,217 @@ public:
     }
 
 private:
-    //! Wrapper around Index::...::erase that keeps m_peerinfo up to date.
-    template<typename Tag>
-    Iter<Tag> Erase(Iter<Tag> it)
+    void WheelInsert(Slot idx)
+    {
+        Announcement& ann = m_anns[idx];
+        ann.m_bucket = std::max(TimerTick(ann.m_time), m_wheel_cursor) & (TIMER_WHEEL_SIZE - 1);
+        ann.m_aux_pos = m_wheel[ann.m_bucket].size();
+        m_wheel[ann.m_bucket].push_back(idx);
+    }
+
+    void WheelRemove(Slot idx)
     {
-        auto peerit = m_peerinfo.find(it->m_peer);
-        peerit->second.m_completed -= it->GetState() == State::COMPLETED;
-        peerit->second.m_requested -= it->GetState() == State::REQUESTED;
+        const Announcement& ann = m_anns[idx];
+        SwapRemove(m_wheel[ann.m_bucket], ann.m_aux_pos, [&](Slot s) -> uint32_t& { return m_anns[s].m_aux_pos; });
+    }
+
+    //! Put every waiting announcement back in the right bucket, after m_wheel_cursor moved backwards.
+    void WheelRebuild()
+    {
+        for (auto& bucket : m_wheel) bucket.clear();
+        for (Slot idx = 0; idx < m_anns.size(); ++idx) {
+            if (m_anns[idx].m_tx != NO_SLOT && m_anns[idx].IsWaiting()) WheelInsert(idx);
+        }
+    }
+
+    //! Change the state (and optionally m_time) of an announcement, keeping m_peerinfo, the txhash entry, the
+    //! peer's CANDIDATE_BEST list and the timer wheel up to date.
+    void Modify(Slot idx, State new_state, std::optional<std::chrono::microseconds> new_time = std::nullopt)
+    {
+        Announcement& ann = m_anns[idx];
+        PeerInfo& peer = m_peerinfo.find(ann.m_peer)->second;
+        TxHashEntry& tx = m_txs[ann.m_tx];
+
+        if (ann.IsWaiting()) WheelRemove(idx);
+        if (ann.GetState() == State::CANDIDATE_BEST) {
+            SwapRemove(peer.m_best, ann.m_aux_pos, [&](Slot s) -> uint32_t& { return m_anns[s].m_aux_pos; });
+        }
+        if (ann.IsSelected() && tx.m_selected == idx) tx.m_selected = NO_SLOT;
+        peer.m_completed -= ann.GetState() == State::COMPLETED;
+        peer.m_requested -= ann.GetState() == State::REQUESTED;
+        tx.m_non_completed -= ann.GetState() != State::COMPLETED;
+
+        ann.m_state = new_state;
+        if (new_time) ann.m_time = *new_time;
+
+        peer.m_completed += ann.GetState() == State::COMPLETED;
+        peer.m_requested += ann.GetState() == State::REQUESTED;
+        tx.m_non_completed += ann.GetState() != State::COMPLETED;
+        if (ann.IsSelected()) tx.m_selected = idx;
+        if (ann.GetState() == State::CANDIDATE_BEST) {
+            ann.m_aux_pos = peer.m_best.size();
+            peer.m_best.push_back(idx);
+        }
+        if (ann.IsWaiting()) WheelInsert(idx);
+    }
+
+    //! Delete an announcement, keeping all other data structures up to date.
+    void Erase(Slot idx)
+    {
+        Announcement& ann = m_anns[idx];
+        auto peerit = m_peerinfo.find(ann.m_peer);
+        TxHashEntry& tx = m_txs[ann.m_tx];
+
+        if (ann.IsWaiting()) WheelRemove(idx);
+        if (ann.GetState() == State::CANDIDATE_BEST) {
+            SwapRemove(peerit->second.m_best, ann.m_aux_pos, [&](Slot s) -> uint32_t& { return m_anns[s].m_aux_pos; });
+        }
+        if (tx.m_selected == idx) tx.m_selected = NO_SLOT;
+        tx.m_non_completed -= ann.GetState() != State::COMPLETED;
+        SwapRemove(tx.m_anns, ann.m_tx_pos, [&](Slot s) -> uint32_t& { return m_anns[s].m_tx_pos; });
+        if (tx.m_anns.empty()) {
+            m_tx_slots.erase(tx.m_txhash);
+            m_free_txs.push_back(ann.m_tx);
+        }
+
+        peerit->second.m_completed -= ann.GetState() == State::COMPLETED;
+        peerit->second.m_requested -= ann.GetState() == State::REQUESTED;
+        SwapRemove(peerit->second.m_anns, ann.m_peer_pos, [&](Slot s) -> uint32_t& { return m_anns[s].m_peer_pos; });
         if (--peerit->second.m_total == 0) m_peerinfo.erase(peerit);
-        return m_index.get<Tag>().erase(it);
+
+        ann.m_tx = NO_SLOT;
+        m_free_anns.push_back(idx);
+    }
+
+    //! Release the memory of unused slots once they make up most of the arrays, by moving all announcements and
+    //! txhashes to the front and renumbering the slot lists. Positions within the lists are unchanged. At least
+    //! three quarters of the slots were freed since the previous compaction, so this is amortized O(1) per
+    //! deleted announcement. Slots are invalidated, so this must only run at the end of a public operation.
+    void MaybeCompact()
+    {
+        if (m_anns.size() < COMPACT_MIN_SLOTS || Size() * 4 > m_anns.size()) return;
+
+        std::vector<Slot> ann_map(m_anns.size(), NO_SLOT);
+        std::vector<Announcement> anns;
+        anns.reserve(Size());
+        for (Slot idx = 0; idx < m_anns.size(); ++idx) {
+            if (m_anns[idx].m_tx == NO_SLOT) continue;
+            ann_map[idx] = anns.size();
+            anns.push_back(std::move(m_anns[idx]));
+        }
+        std::vector<Slot> tx_map(m_txs.size(), NO_SLOT);
+        std::vector<TxHashEntry> txs;
+        txs.reserve(m_tx_slots.size());
+        for (Slot tx = 0; tx < m_txs.size(); ++tx) {
+            if (m_txs[tx].m_anns.empty()) continue;
+            tx_map[tx] = txs.size();
+            txs.push_back(std::move(m_txs[tx]));
+        }
+
+        const auto remap = [&](std::vector<Slot>& list) {
+            for (Slot& idx : list) idx = ann_map[idx];
+            list.shrink_to_fit();
+        };
+        for (Announcement& ann : anns) ann.m_tx = tx_map[ann.m_tx];
+        for (TxHashEntry& tx : txs) {
+            remap(tx.m_anns);
+            if (tx.m_selected != NO_SLOT) tx.m_selected = ann_map[tx.m_selected];
+        }
+        for (auto& [_, tx] : m_tx_slots) tx = tx_map[tx];
+        m_tx_slots.rehash(0);
+        for (auto& [_, info] : m_peerinfo) {
+            remap(info.m_anns);
+            remap(info.m_best);
+        }
+        for (auto& bucket : m_wheel) remap(bucket);
+
+        m_anns = std::move(anns);
+        m_free_anns = {};
+        m_txs = std::move(txs);
+        m_free_txs = {};
     }
 
-    //! Wrapper around Index::...::modify that keeps m_peerinfo up to date.
-    template<typename Tag, typename Modifier>
-    void Modify(Iter<Tag> it, Modifier modifier)
+    //! Delete all announcements for the txhash in the given slot.
+    void EraseTxHash(Slot tx)
     {
-        auto peerit = m_peerinfo.find(it->m_peer);
-        peerit->second.m_completed -= it->GetState() == State::COMPLETED;
-        peerit->second.m_requested -= it->GetState() == State::REQUESTED;
-        m_index.get<Tag>().modify(it, std::move(modifier));
-        peerit->second.m_completed += it->GetState() == State::COMPLETED;
-        peerit->second.m_requested += it->GetState() == State::REQUESTED;
+        // Erasing the last announcement frees the slot, so iterate over a copy.
+        const std::vector<Slot> anns{m_txs[tx].m_anns};
+        for (Slot idx : anns) Erase(idx);
+    }
+
+    //! Find the announcement for a (peer, txhash) combination, or NO_SLOT.
+    Slot Find(NodeId peer, const uint256& txhash) const
+    {
+        auto it = m_tx_slots.find(txhash);
+        if (it == m_tx_slots.end()) return NO_SLOT;
+        for (Slot idx : m_txs[it->second].m_anns) {
+            if (m_anns[idx].m_peer == peer) return idx;
+        }
+        return NO_SLOT;
+    }
+
+    //! The CANDIDATE_READY announcement with the highest priority for a txhash, or NO_SLOT.
+    Slot BestReady(const TxHashEntry& tx) const
+    {
+        Slot best{NO_SLOT};
+        for (Slot idx : tx.m_anns) {
+            if (m_anns[idx].GetState() != State::CANDIDATE_READY) continue;
+            if (best == NO_SLOT || m_anns[idx].m_priority > m_anns[best].m_priority) best = idx;
+        }
+        return best;
     }
 
     //! Convert a CANDIDATE_DELAYED announcement into a CANDIDATE_READY. If this makes it the new best
     //! CANDIDATE_READY (and no REQUESTED exists) and better than the CANDIDATE_BEST (if any), it becomes the new
     //! CANDIDATE_BEST.
-    void PromoteCandidateReady(Iter<ByTxHash> it)
+    void PromoteCandidateReady(Slot idx)
     {
-        assert(it != m_index.get<ByTxHash>().end());
-        assert(it->GetState() == State::CANDIDATE_DELAYED);
-        // Convert CANDIDATE_DELAYED to CANDIDATE_READY first.
-        Modify<ByTxHash>(it, [](Announcement& ann){ ann.SetState(State::CANDIDATE_READY); });
-        // The following code relies on the fact that the ByTxHash is sorted by txhash, and then by state (first
-        // _DELAYED, then _READY, then _BEST/REQUESTED). Within the _READY announcements, the best one (highest
-        // priority) comes last. Thus, if an existing _BEST exists for the same txhash that this announcement may
-        // be preferred over, it must immediately follow the newly created _READY.
-        auto it_next = std::next(it);
-        if (it_next == m_index.get<ByTxHash>().end() || it_next->m_gtxid.ToUint256() != it->m_gtxid.ToUint256() ||
-            it_next->GetState() == State::COMPLETED) {
-            // This is the new best CANDIDATE_READY, and there is no IsSelected() announcement for this txhash
-            // already.
-            Modify<ByTxHash>(it, [](Announcement& ann){ ann.SetState(State::CANDIDATE_BEST); });
-        } else if (it_next->GetState() == State::CANDIDATE_BEST) {
-            Priority priority_old = m_computer(*it_next);
-            Priority priority_new = m_computer(*it);
-            if (priority_new > priority_old) {
-                // There is a CANDIDATE_BEST announcement already, but this one is better.
-                Modify<ByTxHash>(it_next, [](Announcement& ann){ ann.SetState(State::CANDIDATE_READY); });
-                Modify<ByTxHash>(it, [](Announcement& ann){ ann.SetState(State::CANDIDATE_BEST); });
-            }
+        assert(m_anns[idx].GetState() == State::CANDIDATE_DELAYED);
+        const Slot selected = m_txs[m_anns[idx].m_tx].m_selected;
+        if (selected == NO_SLOT) {
+            // There is no IsSelected() announcement for this txhash, so (by the invariants) no other
+            // CANDIDATE_READY either. This is the new best.
+            Modify(idx, State::CANDIDATE_BEST);
+        } else if (m_anns[selected].GetState() == State::CANDIDATE_BEST &&
+                   m_anns[idx].m_priority > m_anns[selected].m_priority) {
+            // There is a CANDIDATE_BEST announcement already, but this one is better.
+            Modify(selected, State::CANDIDATE_READY);
+            Modify(idx, State::CANDIDATE_BEST);
+        } else {
+            Modify(idx, State::CANDIDATE_READY);
         }
     }
 
     //! Change the state of an announcement to something non-IsSelected(). If it was IsSelected(), the next best
     //! announcement will be marked CANDIDATE_BEST.
-    void ChangeAndReselect(Iter<ByTxHash> it, State new_state)
+    void ChangeAndReselect(Slot idx, State new_state)
     {
         assert(new_state == State::COMPLETED || new_state == State::CANDIDATE_DELAYED);
-        assert(it != m_index.get<ByTxHash>().end());
-        if (it->IsSelected() && it != m_index.get<ByTxHash>().begin()) {
-            auto it_prev = std::prev(it);
-            // The next best CANDIDATE_READY, if any, immediately precedes the REQUESTED or CANDIDATE_BEST
-            // announcement in the ByTxHash index.
-            if (it_prev->m_gtxid.ToUint256() == it->m_gtxid.ToUint256() && it_prev->GetState() == State::CANDIDATE_READY) {
-                // If one such CANDIDATE_READY exists (for this txhash), convert it to CANDIDATE_BEST.
-                Modify<ByTxHash>(it_prev, [](Announcement& ann){ ann.SetState(State::CANDIDATE_BEST); });
-            }
+        if (m_anns[idx].IsSelected()) {
+            // If a CANDIDATE_READY exists for this txhash, convert the best one to CANDIDATE_BEST.
+            const Slot next = BestReady(m_txs[m_anns[idx].m_tx]);
+            if (next != NO_SLOT) Modify(next, State::CANDIDATE_BEST);
         }
-        Modify<ByTxHash>(it, [new_state](Announcement& ann){ ann.SetState(new_state); });
-    }
-
-    //! Check if 'it' is the only announcement for a given txhash that isn't COMPLETED.
-    bool IsOnlyNonCompleted(Iter<ByTxHash> it)
-    {
-        assert(it != m_index.get<ByTxHash>().end());
-        assert(it->GetState() != State::COMPLETED); // Not allowed to call this on COMPLETED announcements.
-
-        // This announcement has a predecessor that belongs to the same txhash. Due to ordering, and the
-        // fact that 'it' is not COMPLETED, its predecessor cannot be COMPLETED here.
-        if (it != m_index.get<ByTxHash>().begin() && std::prev(it)->m_gtxid.ToUint256() == it->m_gtxid.ToUint256()) return false;
-
-        // This announcement has a successor that belongs to the same txhash, and is not COMPLETED.
-        if (std::next(it) != m_index.get<ByTxHash>().end() && std::next(it)->m_gtxid.ToUint256() == it->m_gtxid.ToUint256() &&
-            std::next(it)->GetState() != State::COMPLETED) return false;
-
-        return true;
+        Modify(idx, new_state);
     }
 
     /** Convert any announcement to a COMPLETED one. If there are no non-COMPLETED announcements left for this
      *  txhash, they are deleted. If this was a REQUESTED announcement, and there are other CANDIDATEs left, the
      *  best one is made CANDIDATE_BEST. Returns whether the announcement still exists. */
-    bool MakeCompleted(Iter<ByTxHash> it)
+    bool MakeCompleted(Slot idx)
     {
-        assert(it != m_index.get<ByTxHash>().end());
-
         // Nothing to be done if it's already COMPLETED.
-        if (it->GetState() == State::COMPLETED) return true;
+        if (m_anns[idx].GetState() == State::COMPLETED) return true;
 
-        if (IsOnlyNonCompleted(it)) {
+        if (m_txs[m_anns[idx].m_tx].m_non_completed == 1) {
             // This is the last non-COMPLETED announcement for this txhash. Delete all.
-            uint256 txhash = it->m_gtxid.ToUint256();
-            do {
-                it = Erase<ByTxHash>(it);
-            } while (it != m_index.get<ByTxHash>().end() && it->m_gtxid.ToUint256() == txhash);
+            EraseTxHash(m_anns[idx].m_tx);
             return false;
         }
 
         // Mark the announcement COMPLETED, and select the next best announcement (the first CANDIDATE_READY) if
         // needed.
-        ChangeAndReselect(it, State::COMPLETED);
+        ChangeAndReselect(idx, State::COMPLETED);
 
         return true;
     }
@@ -485,111 +605,143 @@ private:
     {
         if (expired) expired->clear();
 
-        // Iterate over all CANDIDATE_DELAYED and REQUESTED from old to new, as long as they're in the past,
-        // and convert them to CANDIDATE_READY and COMPLETED respectively.
-        while (!m_index.empty()) {
-            auto it = m_index.get<ByTime>().begin();
-            if (it->GetState() == State::CANDIDATE_DELAYED && it->m_time <= now) {
-                PromoteCandidateReady(m_index.project<ByTxHash>(it));
-            } else if (it->GetState() == State::REQUESTED && it->m_time <= now) {
-                if (expired) expired->emplace_back(it->m_peer, it->m_gtxid);
-                MakeCompleted(m_index.project<ByTxHash>(it));
+        const int64_t now_tick = TimerTick(now);
+        const bool backwards = !m_last_now || now < *m_last_now;
+        if (backwards) {
+            m_wheel_cursor = now_tick;
+            WheelRebuild();
+        }
+
+        // Collect all CANDIDATE_DELAYED and REQUESTED in the past from the buckets the cursor moves over. Every
+        // waiting announcement with a tick at or before now_tick is in one of them.
+        std::vector<Slot> due;
+        for (int64_t tick = m_wheel_cursor; tick <= now_tick && uint64_t(tick - m_wheel_cursor) < TIMER_WHEEL_SIZE; ++tick) {
+            for (Slot idx : m_wheel[tick & (TIMER_WHEEL_SIZE - 1)]) {
+                if (m_anns[idx].m_time <= now) due.push_back(idx);
+            }
+        }
+        m_wheel_cursor = now_tick;
+
+        // Convert them to CANDIDATE_READY and COMPLETED respectively, from old to new. None of them can be deleted
+        // by processing another, as a txhash's announcements are only deleted once none is non-COMPLETED.
+        std::sort(due.begin(), due.end(), [&](Slot a, Slot b) {
+            if (m_anns[a].m_time != m_anns[b].m_time) return m_anns[a].m_time < m_anns[b].m_time;
+            return m_anns[a].m_sequence < m_anns[b].m_sequence;
+        });
+        for (Slot idx : due) {
+            if (m_anns[idx].GetState() == State::CANDIDATE_DELAYED) {
+                PromoteCandidateReady(idx);
             } else {
-                break;
+                if (expired) expired->emplace_back(m_anns[idx].m_peer, m_anns[idx].m_gtxid);
+                MakeCompleted(idx);
             }
         }
 
-        while (!m_index.empty()) {
+        if (backwards) {
             // If time went backwards, we may need to demote CANDIDATE_BEST and CANDIDATE_READY announcements back
             // to CANDIDATE_DELAYED. This is an unusual edge case, and unlikely to matter in production. However,
             // it makes it much easier to specify and test TxRequestTracker::Impl's behaviour.
-            auto it = std::prev(m_index.get<ByTime>().end());
-            if (it->IsSelectable() && it->m_time > now) {
-                ChangeAndReselect(m_index.project<ByTxHash>(it), State::CANDIDATE_DELAYED);
-            } else {
-                break;
+            for (Slot idx = 0; idx < m_anns.size(); ++idx) {
+                if (m_anns[idx].m_tx != NO_SLOT && m_anns[idx].IsSelectable() && m_anns[idx].m_time > now) {
+                    ChangeAndReselect(idx, State::CANDIDATE_DELAYED);
+                }
             }
         }
+        m_last_now = now;
     }
 
 public:
     explicit Impl(bool deterministic) :
-        m_computer(deterministic),
-        // Explicitly initialize m_index as we need to pass a reference to m_computer to ByTxHashViewExtractor.
-        m_index(boost::make_tuple(
-            boost::make_tuple(ByPeerViewExtractor(), std::less<ByPeerView>()),
-            boost::make_tuple(ByTxHashViewExtractor(m_computer), std::less<ByTxHashView>()),
-            boost::make_tuple(ByTimeViewExtractor(), std::less<ByTimeView>())
-        )) {}
-
-    // Disable copying and assigning (a default copy won't work due the stateful ByTxHashViewExtractor).
+        m_computer(deterministic) {}
+
+    // Disable copying and assigning (the slot lists refer to positions in this object's arrays).
     Impl(const Impl&) = delete;
     Impl& operator=(const Impl&) = delete;
 
     void DisconnectedPeer(NodeId peer)
     {
-        auto& index = m_index.get<ByPeer>();
-        auto it = index.lower_bound(ByPeerView{peer, false, uint256::ZERO});
-        while (it != index.end() && it->m_peer == peer) {
-            // Check what to continue with after this iteration. 'it' will be deleted in what follows, so we need to
-            // decide what to continue with afterwards. There are a number of cases to consider:
-            // - std::next(it) is end() or belongs to a different peer. In that case, this is the last iteration
-            //   of the loop (denote this by setting it_next to end()).
-            // - 'it' is not the only non-COMPLETED announcement for its txhash. This means it will be deleted, but
-            //   no other Announcement objects will be modified. Continue with std::next(it) if it belongs to the
-            //   same peer, but decide this ahead of time (as 'it' may change position in what follows).
-            // - 'it' is the only non-COMPLETED announcement for its txhash. This means it will be deleted along
-            //   with all other announcements for the same txhash - which may include std::next(it). However, other
-            //   than 'it', no announcements for the same peer can be affected (due to (peer, txhash) uniqueness).
-            //   In other words, the situation where std::next(it) is deleted can only occur if std::next(it)
-            //   belongs to a different peer but the same txhash as 'it'. This is covered by the first bulletpoint
-            //   already, and we'll have set it_next to end().
-            auto it_next = (std::next(it) == index.end() || std::next(it)->m_peer != peer) ? index.end() :
-                std::next(it);
+        // Each iteration deletes the peer's last announcement. Making it COMPLETED may delete other announcements
+        // for the same txhash, but due to (peer, txhash) uniqueness none of this peer's.
+        while (true) {
+            auto it = m_peerinfo.find(peer);
+            if (it == m_peerinfo.end()) break;
+            const Slot idx = it->second.m_anns.back();
             // If the announcement isn't already COMPLETED, first make it COMPLETED (which will mark other
             // CANDIDATEs as CANDIDATE_BEST, or delete all of a txhash's announcements if no non-COMPLETED ones are
             // left).
-            if (MakeCompleted(m_index.project<ByTxHash>(it))) {
+            if (MakeCompleted(idx)) {
                 // Then actually delete the announcement (unless it was already deleted by MakeCompleted).
-                Erase<ByPeer>(it);
+                Erase(idx);
             }
-            it = it_next;
         }
+        MaybeCompact();
     }
 
     void ForgetTxHash(const uint256& txhash)
     {
-        auto it = m_index.get<ByTxHash>().lower_bound(ByTxHashView{txhash, State::CANDIDATE_DELAYED, 0});
-        while (it != m_index.get<ByTxHash>().end() && it->m_gtxid.ToUint256() == txhash) {
-            it = Erase<ByTxHash>(it);
-        }
+        auto it = m_tx_slots.find(txhash);
+        if (it != m_tx_slots.end()) EraseTxHash(it->second);
+        MaybeCompact();
     }
 
     void GetCandidatePeers(const uint256& txhash, std::vector<NodeId>& result_peers) const
     {
-        auto it = m_index.get<ByTxHash>().lower_bound(ByTxHashView{txhash, State::CANDIDATE_DELAYED, 0});
-        while (it != m_index.get<ByTxHash>().end() && it->m_gtxid.ToUint256() == txhash && it->GetState() != State::COMPLETED) {
-            result_peers.push_back(it->m_peer);
-            ++it;
+        auto it = m_tx_slots.find(txhash);
+        if (it == m_tx_slots.end()) return;
+        // Report the peers ordered by (state, priority of CANDIDATE_READY ones).
+        std::vector<std::tuple<State, Priority, NodeId>> candidates;
+        for (Slot idx : m_txs[it->second].m_anns) {
+            const Announcement& ann = m_anns[idx];
+            if (ann.GetState() == State::COMPLETED) continue;
+            candidates.emplace_back(ann.GetState(), ann.GetState() == State::CANDIDATE_READY ? ann.m_priority : 0, ann.m_peer);
         }
+        std::sort(candidates.begin(), candidates.end());
+        for (const auto& candidate : candidates) result_peers.push_back(std::get<NodeId>(candidate));
     }
 
     void ReceivedInv(NodeId peer, const GenTxid& gtxid, bool preferred,
                      std::chrono::microseconds reqtime)
     {
-        // Bail out if we already have a CANDIDATE_BEST announcement for this (txhash, peer) combination. The case
-        // where there is a non-CANDIDATE_BEST announcement already will be caught by the uniqueness property of the
-        // ByPeer index when we try to emplace the new object below.
-        if (m_index.get<ByPeer>().count(ByPeerView{peer, true, gtxid.ToUint256()})) return;
-
-        // Try creating the announcement with CANDIDATE_DELAYED state (which will fail due to the uniqueness
-        // of the ByPeer index if a non-CANDIDATE_BEST announcement already exists with the same txhash and peer).
-        // Bail out in that case.
-        auto ret = m_index.get<ByPeer>().emplace(gtxid, peer, preferred, reqtime, m_current_sequence);
-        if (!ret.second) return;
+        const uint256& txhash = gtxid.ToUint256();
+        // Bail out if we already have an announcement for this (txhash, peer) combination.
+        if (Find(peer, txhash) != NO_SLOT) return;
+
+        // Intern the txhash.
+        auto [tx_it, inserted] = m_tx_slots.try_emplace(txhash, NO_SLOT);
+        if (inserted) {
+            if (m_free_txs.empty()) {
+                tx_it->second = m_txs.size();
+                m_txs.emplace_back();
+            } else {
+                tx_it->second = m_free_txs.back();
+                m_free_txs.pop_back();
+            }
+            m_txs[tx_it->second].m_txhash = txhash;
+        }
+        TxHashEntry& tx = m_txs[tx_it->second];
+
+        // Create the announcement with CANDIDATE_DELAYED state.
+        Announcement ann{gtxid, peer, preferred, reqtime, m_current_sequence, m_computer(txhash, peer, preferred)};
+        Slot idx;
+        if (m_free_anns.empty()) {
+            idx = m_anns.size();
+            m_anns.push_back(std::move(ann));
+        } else {
+            idx = m_free_anns.back();
+            m_free_anns.pop_back();
+            m_anns[idx] = std::move(ann);
+        }
+        PeerInfo& info = m_peerinfo[peer];
+        m_anns[idx].m_tx = tx_it->second;
+        m_anns[idx].m_tx_pos = tx.m_anns.size();
+        m_anns[idx].m_peer_pos = info.m_anns.size();
+        tx.m_anns.push_back(idx);
+        ++tx.m_non_completed;
+        info.m_anns.push_back(idx);
+        WheelInsert(idx);
 
         // Update accounting metadata.
-        ++m_peerinfo[peer].m_total;
+        ++info.m_total;
         ++m_current_sequence;
     }
 
@@ -599,15 +751,14 @@ public:
     {
         // Move time.
         SetTimePoint(now, expired);
+        MaybeCompact();
 
         // Find all CANDIDATE_BEST announcements for this peer.
+        auto it = m_peerinfo.find(peer);
+        if (it == m_peerinfo.end()) return {};
         std::vector<const Announcement*> selected;
-        auto it_peer = m_index.get<ByPeer>().lower_bound(ByPeerView{peer, true, uint256::ZERO});
-        while (it_peer != m_index.get<ByPeer>().end() && it_peer->m_peer == peer &&
-            it_peer->GetState() == State::CANDIDATE_BEST) {
-            selected.emplace_back(&*it_peer);
-            ++it_peer;
-        }
+        selected.reserve(it->second.m_best.size());
+        for (Slot idx : it->second.m_best) selected.emplace_back(&m_anns[idx]);
 
         // Sort by sequence number.
         std::sort(selected.begin(), selected.end(), [](const Announcement* a, const Announcement* b) {
@@ -625,16 +776,15 @@ public:
 
     void RequestedTx(NodeId peer, const uint256& txhash, std::chrono::microseconds expiry)
     {
-        auto it = m_index.get<ByPeer>().find(ByPeerView{peer, true, txhash});
-        if (it == m_index.get<ByPeer>().end()) {
+        const Slot idx = Find(peer, txhash);
+        if (idx == NO_SLOT) return;
+        if (m_anns[idx].GetState() != State::CANDIDATE_BEST) {
             // There is no CANDIDATE_BEST announcement, look for a _READY or _DELAYED instead. If the caller only
             // ever invokes RequestedTx with the values returned by GetRequestable, and no other non-const functions
             // other than ForgetTxHash and GetRequestable in between, this branch will never execute (as txhashes
             // returned by GetRequestable always correspond to CANDIDATE_BEST announcements).
 
-            it = m_index.get<ByPeer>().find(ByPeerView{peer, false, txhash});
-            if (it == m_index.get<ByPeer>().end() || (it->GetState() != State::CANDIDATE_DELAYED &&
-                                                      it->GetState() != State::CANDIDATE_READY)) {
+            if (m_anns[idx].GetState() != State::CANDIDATE_DELAYED && m_anns[idx].GetState() != State::CANDIDATE_READY) {
                 // There is no CANDIDATE announcement tracked for this peer, so we have nothing to do. Either this
                 // txhash wasn't tracked at all (and the caller should have called ReceivedInv), or it was already
                 // requested and/or completed for other reasons and this is just a superfluous RequestedTx call.
@@ -644,38 +794,32 @@ public:
             // Look for an existing CANDIDATE_BEST or REQUESTED with the same txhash. We only need to do this if the
             // found announcement had a different state than CANDIDATE_BEST. If it did, invariants guarantee that no
             // other CANDIDATE_BEST or REQUESTED can exist.
-            auto it_old = m_index.get<ByTxHash>().lower_bound(ByTxHashView{txhash, State::CANDIDATE_BEST, 0});
-            if (it_old != m_index.get<ByTxHash>().end() && it_old->m_gtxid.ToUint256() == txhash) {
-                if (it_old->GetState() == State::CANDIDATE_BEST) {
+            const Slot old = m_txs[m_anns[idx].m_tx].m_selected;
+            if (old != NO_SLOT) {
+                if (m_anns[old].GetState() == State::CANDIDATE_BEST) {
                     // The data structure's invariants require that there can be at most one CANDIDATE_BEST or one
                     // REQUESTED announcement per txhash (but not both simultaneously), so we have to convert any
                     // existing CANDIDATE_BEST to another CANDIDATE_* when constructing another REQUESTED.
                     // It doesn't matter whether we pick CANDIDATE_READY or _DELAYED here, as SetTimePoint()
                     // will correct it at GetRequestable() time. If time only goes forward, it will always be
                     // _READY, so pick that to avoid extra work in SetTimePoint().
-                    Modify<ByTxHash>(it_old, [](Announcement& ann) { ann.SetState(State::CANDIDATE_READY); });
-                } else if (it_old->GetState() == State::REQUESTED) {
+                    Modify(old, State::CANDIDATE_READY);
+                } else if (m_anns[old].GetState() == State::REQUESTED) {
                     // As we're no longer waiting for a response to the previous REQUESTED announcement, convert it
                     // to COMPLETED. This also helps guaranteeing progress.
-                    Modify<ByTxHash>(it_old, [](Announcement& ann) { ann.SetState(State::COMPLETED); });
+                    Modify(old, State::COMPLETED);
                 }
             }
         }
 
-        Modify<ByPeer>(it, [expiry](Announcement& ann) {
-            ann.SetState(State::REQUESTED);
-            ann.m_time = expiry;
-        });
+        Modify(idx, State::REQUESTED, expiry);
     }
 
     void ReceivedResponse(NodeId peer, const uint256& txhash)
     {
-        // We need to search the ByPeer index for both (peer, false, txhash) and (peer, true, txhash).
-        auto it = m_index.get<ByPeer>().find(ByPeerView{peer, false, txhash});
-        if (it == m_index.get<ByPeer>().end()) {
-            it = m_index.get<ByPeer>().find(ByPeerView{peer, true, txhash});
-        }
-        if (it != m_index.get<ByPeer>().end()) MakeCompleted(m_index.project<ByTxHash>(it));
+        const Slot idx = Find(peer, txhash);
+        if (idx != NO_SLOT) MakeCompleted(idx);
+        MaybeCompact();
     }
 
     size_t CountInFlight(NodeId peer) const
@@ -700,7 +844,7 @@ public:
     }
 
     //! Count how many announcements are being tracked in total across all peers and transactions.
-    size_t Size() const { return m_index.size(); }
+    size_t Size() const { return m_anns.size() - m_free_anns.size(); }
 
     uint64_t ComputePriority(const uint256& txhash, NodeId peer, bool preferred) const
     {
@@ -89,9 +89,12 @@
  *
  * Complexity:
  * - Memory usage is proportional to the total number of tracked announcements (Size()) plus the number of
- *   peers with a nonzero number of tracked announcements.
- * - CPU usage is generally logarithmic in the total number of tracked announcements, plus the number of
- *   announcements affected by an operation (amortized O(1) per announcement).
+ *   peers with a nonzero number of tracked announcements. Storage freed by removed announcements is reused, and
+ *   released once it makes up most of the total, so up to 4 times Size() (and at least 1024) announcements'
+ *   worth of memory may be held.
+ * - CPU usage is generally constant, plus linear in the number of announcements for the txhash or peer involved
+ *   and the number of announcements affected by an operation (amortized O(1) per announcement). When the clock
+ *   goes backwards, GetRequestable is linear in the total number of tracked announcements.
  *
  * Context:
  * - In an earlier version of the transaction request logic it was possible for a peer to prevent us from seeing a
@@ -46,6 +46,12 @@ void DirectoryCommit(const fs::path& dirname);
 bool TruncateFile(FILE* file, unsigned int length);
 int RaiseFileDescriptorLimit(int nMinFD);
 void AllocateFileRange(FILE* file, unsigned int offset, unsigned int length);
+/**
+ * Release the disk space of a range of a file without changing its size, so
+ * that the range reads back as zeros. Returns false if the file system or
+ * platform does not support this.
+ */
+bool PunchFileHole(FILE* file, uint64_t offset, uint64_t length);
 
 /**
  * Rename src to dest.
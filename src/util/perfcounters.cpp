@@ -0,0 +1,102 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <util/perfcounters.h>
+
+#include <sync.h>
+#include <util/threadnames.h>
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <map>
+#include <memory>
+
+namespace perf {
+
+std::atomic<bool> g_enabled{false};
+
+void SetEnabled(bool enabled)
+{
+    g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Histogram::Add(std::chrono::nanoseconds duration)
+{
+    ++count;
+    total += duration;
+    max = std::max(max, duration);
+    const uint64_t micros = std::max<int64_t>(duration.count() / 1000, 0);
+    ++buckets[std::min<size_t>(std::bit_width(micros), NUM_BUCKETS - 1)];
+}
+
+namespace {
+
+/**
+ * Histograms of one thread. The mutex is only contended while Snapshot()
+ * reads them.
+ */
+struct ThreadStore {
+    Mutex mutex;
+    const std::string thread_name{util::ThreadGetInternalName()};
+    std::map<std::string, std::map<std::string, Histogram, std::less<>>, std::less<>> timers GUARDED_BY(mutex);
+};
+
+struct Registry {
+    Mutex mutex;
+    //! Stores are kept after their thread exits so its counters are not lost.
+    std::vector<std::shared_ptr<ThreadStore>> stores GUARDED_BY(mutex);
+};
+
+Registry& GetRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+ThreadStore& GetThreadStore()
+{
+    thread_local std::shared_ptr<ThreadStore> t_store{[] {
+        auto store{std::make_shared<ThreadStore>()};
+        Registry& registry{GetRegistry()};
+        LOCK(registry.mutex);
+        registry.stores.push_back(store);
+        return store;
+    }()};
+    return *t_store;
+}
+
+} // namespace
+
+void Record(std::string_view group, std::string_view name, std::chrono::nanoseconds duration)
+{
+    ThreadStore& store{GetThreadStore()};
+    LOCK(store.mutex);
+    auto group_it{store.timers.find(group)};
+    if (group_it == store.timers.end()) group_it = store.timers.emplace(group, std::map<std::string, Histogram, std::less<>>{}).first;
+    auto name_it{group_it->second.find(name)};
+    if (name_it == group_it->second.end()) name_it = group_it->second.emplace(name, Histogram{}).first;
+    name_it->second.Add(duration);
+}
+
+std::vector<ThreadStats> Snapshot(bool reset)
+{
+    std::vector<std::shared_ptr<ThreadStore>> stores{WITH_LOCK(GetRegistry().mutex, return GetRegistry().stores)};
+    std::vector<ThreadStats> result;
+    for (const auto& store : stores) {
+        LOCK(store->mutex);
+        if (store->timers.empty()) continue;
+        ThreadStats& stats{result.emplace_back()};
+        stats.thread_name = store->thread_name;
+        for (const auto& [group, timers] : store->timers) {
+            for (const auto& [name, histogram] : timers) {
+                stats.timers.push_back({group, name, histogram});
+            }
+        }
+        if (reset) store->timers.clear();
+    }
+    return result;
+}
+
+} // namespace perf
@@ -0,0 +1,89 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_UTIL_PERFCOUNTERS_H
+#define BITCOIN_UTIL_PERFCOUNTERS_H
+
+#include <util/time.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * In-process timing of hot code paths, for nodes where external profilers
+ * cannot be used.
+ *
+ * Durations are aggregated into a histogram per (thread, group, name), which
+ * only the recording thread updates. Collection is off by default; while it
+ * is off a ScopedTimer costs one relaxed atomic load.
+ */
+namespace perf {
+
+//! Histogram bucket i counts durations of [2^(i-1), 2^i) microseconds; bucket 0 counts durations below 1us.
+static constexpr size_t NUM_BUCKETS{28};
+
+struct Histogram {
+    uint64_t count{0};
+    std::chrono::nanoseconds total{0};
+    std::chrono::nanoseconds max{0};
+    std::array<uint64_t, NUM_BUCKETS> buckets{};
+
+    void Add(std::chrono::nanoseconds duration);
+};
+
+struct TimerStats {
+    std::string group;
+    std::string name;
+    Histogram histogram;
+};
+
+struct ThreadStats {
+    std::string thread_name;
+    std::vector<TimerStats> timers;
+};
+
+extern std::atomic<bool> g_enabled;
+
+inline bool Enabled() { return g_enabled.load(std::memory_order_relaxed); }
+void SetEnabled(bool enabled);
+
+/** Add a duration to the calling thread's histogram for (group, name). */
+void Record(std::string_view group, std::string_view name, std::chrono::nanoseconds duration);
+
+/** Copy the histograms of all threads that recorded anything, optionally clearing them. */
+std::vector<ThreadStats> Snapshot(bool reset);
+
+/**
+ * Records the lifetime of the scope in the (group, name) histogram. Both
+ * strings must outlive the timer.
+ */
+class ScopedTimer
+{
+    const std::string_view m_group;
+    const std::string_view m_name;
+    const std::optional<SteadyClock::time_point> m_start;
+
+public:
+    ScopedTimer(std::string_view group, std::string_view name)
+        : m_group{group}, m_name{name}, m_start{Enabled() ? std::optional{SteadyClock::now()} : std::nullopt} {}
+
+    ~ScopedTimer()
+    {
+        if (m_start) Record(m_group, m_name, SteadyClock::now() - *m_start);
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+} // namespace perf
+
+#endif // BITCOIN_UTIL_PERFCOUNTERS_H
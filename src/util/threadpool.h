@@ -0,0 +1,166 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_UTIL_THREADPOOL_H
+#define BITCOIN_UTIL_THREADPOOL_H
+
+#include <sync.h>
+#include <tinyformat.h>
+#include <util/check.h>
+#include <util/threadnames.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <future>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Fixed-size pool of worker threads executing submitted tasks in FIFO order.
+ *
+ * Submit() returns a std::future for the task's result; an exception thrown by
+ * a task is stored in that future and rethrown to whoever waits on it.
+ * Stop() (also called on destruction) lets the workers drain the queue before
+ * joining them, so every future handed out is eventually satisfied.
+ *
+ * Tasks must not block waiting on other tasks submitted to the same pool, as
+ * all workers could end up waiting.
+ */
+class ThreadPool
+{
+private:
+    //! Name prefix of the worker threads.
+    const std::string m_name;
+
+    //! Mutex to protect the inner state
+    Mutex m_mutex;
+
+    //! Workers block on this when the queue is empty
+    std::condition_variable m_cv;
+
+    //! Tasks waiting to be picked up by a worker
+    std::deque<std::packaged_task<void()>> m_queue GUARDED_BY(m_mutex);
+
+    //! Set by Stop(); workers exit once the queue is drained
+    bool m_interrupt GUARDED_BY(m_mutex){false};
+
+    std::vector<std::thread> m_workers;
+
+    void WorkerThread() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        while (true) {
+            m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_interrupt || !m_queue.empty(); });
+            if (m_queue.empty()) return;
+            std::packaged_task<void()> task{std::move(m_queue.front())};
+            m_queue.pop_front();
+            {
+                REVERSE_LOCK(lock, m_mutex);
+                task();
+            }
+        }
+    }
+
+public:
+    explicit ThreadPool(std::string name) : m_name{std::move(name)} {}
+
+    // Since this class manages its own resources, which is a set of worker
+    // threads, copy and move operations are not appropriate.
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    ~ThreadPool() { Stop(); }
+
+    /** Spawn num_workers worker threads. Must not be called while the pool is running. */
+    void Start(int num_workers) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        Assume(m_workers.empty());
+        WITH_LOCK(m_mutex, m_interrupt = false);
+        m_workers.reserve(num_workers);
+        for (int n = 0; n < num_workers; ++n) {
+            m_workers.emplace_back([this, n]() {
+                util::ThreadRename(strprintf("%s.%i", m_name, n));
+                WorkerThread();
+            });
+        }
+    }
+
+    /** Run all queued tasks to completion and join the workers. */
+    void Stop() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WITH_LOCK(m_mutex, m_interrupt = true);
+        m_cv.notify_all();
+        for (std::thread& t : m_workers) {
+            t.join();
+        }
+        m_workers.clear();
+    }
+
+    /**
+     * Queue fn for execution on a worker thread.
+     *
+     * Must only be called while the pool is running; tasks submitted to a
+     * pool without workers are never executed.
+     */
+    template <typename F>
+    [[nodiscard]] std::future<std::invoke_result_t<F>> Submit(F&& fn) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        std::packaged_task<std::invoke_result_t<F>()> task{std::forward<F>(fn)};
+        auto future{task.get_future()};
+        WITH_LOCK(m_mutex, m_queue.emplace_back(std::move(task)));
+        m_cv.notify_one();
+        return future;
+    }
+
+    /**
+     * Call fn(i) for every i in [0, count), split into contiguous chunks that
+     * run on the workers and on the calling thread, and wait for all of them.
+     *
+     * The first exception thrown by fn is rethrown after all chunks finished.
+     */
+    template <typename F>
+    void ParallelFor(size_t count, F&& fn) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        const size_t num_chunks{std::min(count, m_workers.size() + 1)};
+        if (num_chunks <= 1) {
+            for (size_t i = 0; i < count; ++i) fn(i);
+            return;
+        }
+        std::vector<std::future<void>> futures;
+        futures.reserve(num_chunks - 1);
+        const auto run_chunk{[&fn, count, num_chunks](size_t chunk) {
+            for (size_t i = chunk * count / num_chunks; i < (chunk + 1) * count / num_chunks; ++i) fn(i);
+        }};
+        for (size_t chunk = 1; chunk < num_chunks; ++chunk) {
+            futures.push_back(Submit([&run_chunk, chunk] { run_chunk(chunk); }));
+        }
+        std::exception_ptr error;
+        try {
+            run_chunk(0);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        for (auto& future : futures) {
+            try {
+                future.get();
+            } catch (...) {
+                if (!error) error = std::current_exception();
+            }
+        }
+        if (error) std::rethrow_exception(error);
+    }
+
+    /** Number of worker threads, not counting a caller joining in through ParallelFor. */
+    size_t WorkerCount() const { return m_workers.size(); }
+};
+
+#endif // BITCOIN_UTIL_THREADPOOL_H
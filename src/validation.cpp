@@ -54,17 +54,20 @@
 #include <util/fs_helpers.h>
 #include <util/hasher.h>
 #include <util/moneystr.h>
+#include <util/perfcounters.h>
 #include <util/rbf.h>
 #include <util/result.h>
 #include <util/signalinterrupt.h>
 #include <util/strencodings.h>
 #include <util/string.h>
+#include <util/threadpool.h>
 #include <util/time.h>
 #include <util/trace.h>
 #include <util/translation.h>
 #include <validationinterface.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <deque>
@@ -86,6 +89,7 @@ using node::BlockManager;
 using node::BlockMap;
 using node::CBlockIndexHeightOnlyComparator;
 using node::CBlockIndexWorkComparator;
+using node::PrunedBlockPos;
 using node::SnapshotMetadata;
 
 /** Size threshold for warning about slow UTXO set flush to disk. */
@@ -658,9 +662,10 @@ private:
         /** Txid. */
         const Txid& m_hash;
         TxValidationState m_state;
-        /** A temporary cache containing serialized transaction data for signature verification.
-         * Reused across PolicyScriptChecks and ConsensusScriptChecks. */
-        PrecomputedTransactionData m_precomputed_txdata;
+        /** A cache containing serialized transaction data for signature verification.
+         * Reused across PolicyScriptChecks and ConsensusScriptChecks, and kept with the
+         * mempool entry so ConnectBlock does not need to compute it again. */
+        std::shared_ptr<PrecomputedTransactionData> m_precomputed_txdata{std::make_shared<PrecomputedTransactionData>()};
     };
 
     // Run the policy checks on a given transaction, excluding any script checks.
@@ -911,13 +916,17 @@ bool MemPoolAccept::PreChecks(ATMPArgs& args, Workspace& ws)
     // Keep track of transactions that spend a coinbase, which we re-scan
     // during reorgs to ensure COINBASE_MATURITY is still met.
     bool fSpendsCoinbase = false;
+    std::vector<CTxOut> spent_outputs;
+    spent_outputs.reserve(tx.vin.size());
     for (const CTxIn &txin : tx.vin) {
         const Coin &coin = m_view.AccessCoin(txin.prevout);
-        if (coin.IsCoinBase()) {
-            fSpendsCoinbase = true;
-            break;
-        }
+        if (coin.IsCoinBase()) fSpendsCoinbase = true;
+        spent_outputs.emplace_back(coin.out);
     }
+    // Hold on to the spent outputs now, so that the entry's memory usage,
+    // which includes them, is known from the start. Hashing the transaction
+    // is left to the script checks, after the cheaper checks have passed.
+    ws.m_precomputed_txdata->m_spent_outputs = std::move(spent_outputs);
 
     // Set entry_sequence to 0 when bypass_limits is used; this allows txs from a block
     // reorg to be marked earlier than any child txs that were already in the mempool.
@@ -925,7 +934,7 @@ bool MemPoolAccept::PreChecks(ATMPArgs& args, Workspace& ws)
     if (!m_subpackage.m_changeset) {
         m_subpackage.m_changeset = m_pool.GetChangeSet();
     }
-    ws.m_tx_handle = m_subpackage.m_changeset->StageAddition(ptx, ws.m_base_fees, nAcceptTime, m_active_chainstate.m_chain.Height(), entry_sequence, fSpendsCoinbase, nSigOpsCost, lock_points.value());
+    ws.m_tx_handle = m_subpackage.m_changeset->StageAddition(ptx, ws.m_base_fees, nAcceptTime, m_active_chainstate.m_chain.Height(), entry_sequence, fSpendsCoinbase, nSigOpsCost, lock_points.value(), ws.m_precomputed_txdata);
 
     // ws.m_modified_fees includes any fee deltas from PrioritiseTransaction
     ws.m_modified_fees = ws.m_tx_handle->GetModifiedFee();
@@ -1253,9 +1262,18 @@ bool MemPoolAccept::PolicyScriptChecks(const ATMPArgs& args, Workspace& ws)
 
     constexpr unsigned int scriptVerifyFlags = STANDARD_SCRIPT_VERIFY_FLAGS;
 
+    // Compute the sighash midstates from the outputs stored by PreChecks.
+    // Moving them out and back in keeps their allocation, and so the memory
+    // usage the entry was created with.
+    PrecomputedTransactionData& txdata{*ws.m_precomputed_txdata};
+    if (!txdata.m_spent_outputs_ready) {
+        std::vector<CTxOut> spent_outputs{std::move(txdata.m_spent_outputs)};
+        txdata.Init(tx, std::move(spent_outputs));
+    }
+
     // Check input scripts and signatures.
     // This is done last to help prevent CPU exhaustion denial-of-service attacks.
-    if (!CheckInputScripts(tx, state, m_view, scriptVerifyFlags, true, false, ws.m_precomputed_txdata, GetValidationCache())) {
+    if (!CheckInputScripts(tx, state, m_view, scriptVerifyFlags, true, false, txdata, GetValidationCache())) {
         // Detect a failure due to a missing witness so that p2p code can handle rejection caching appropriately.
         if (!tx.HasWitness() && SpendsNonAnchorWitnessProg(tx, m_view)) {
             state.Invalid(TxValidationResult::TX_WITNESS_STRIPPED,
@@ -1292,7 +1310,7 @@ bool MemPoolAccept::ConsensusScriptChecks(const ATMPArgs& args, Workspace& ws)
     // transactions into the mempool can be exploited as a DoS attack.
     unsigned int currentBlockScriptVerifyFlags{GetBlockScriptFlags(*m_active_chainstate.m_chain.Tip(), m_active_chainstate.m_chainman)};
     if (!CheckInputsFromMempoolAndCache(tx, state, m_view, m_pool, currentBlockScriptVerifyFlags,
-                                        ws.m_precomputed_txdata, m_active_chainstate.CoinsTip(), GetValidationCache())) {
+                                        *ws.m_precomputed_txdata, m_active_chainstate.CoinsTip(), GetValidationCache())) {
         LogPrintf("BUG! PLEASE REPORT THIS! CheckInputScripts failed against latest-block but not STANDARD flags %s, %s\n", hash.ToString(), state.ToString());
         return Assume(false);
     }
@@ -1861,6 +1879,7 @@ MempoolAcceptResult AcceptToMemoryPool(Chainstate& active_chainstate, const CTra
                                        int64_t accept_time, bool bypass_limits, bool test_accept)
 {
     AssertLockHeld(::cs_main);
+    perf::ScopedTimer timer{"validation", "AcceptToMemoryPool"};
     const CChainParams& chainparams{active_chainstate.m_chainman.GetParams()};
     assert(active_chainstate.GetMempool() != nullptr);
     CTxMemPool& pool{*active_chainstate.GetMempool()};
@@ -2458,6 +2477,7 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
 
     const auto time_1{SteadyClock::now()};
     m_chainman.time_check += time_1 - time_start;
+    if (perf::Enabled()) perf::Record("validation", "ConnectBlock.checks", time_1 - time_start);
     LogDebug(BCLog::BENCH, "    - Sanity checks: %.2fms [%.2fs (%.2fms/blk)]\n",
              Ticks<MillisecondsDouble>(time_1 - time_start),
              Ticks<SecondsDouble>(m_chainman.time_check),
@@ -2560,6 +2580,7 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
 
     const auto time_2{SteadyClock::now()};
     m_chainman.time_forks += time_2 - time_1;
+    if (perf::Enabled()) perf::Record("validation", "ConnectBlock.forks", time_2 - time_1);
     LogDebug(BCLog::BENCH, "    - Fork checks: %.2fms [%.2fs (%.2fms/blk)]\n",
              Ticks<MillisecondsDouble>(time_2 - time_1),
              Ticks<SecondsDouble>(m_chainman.time_forks),
@@ -2582,6 +2603,18 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
 
     std::vector<PrecomputedTransactionData> txsdata(block.vtx.size());
 
+    // Transactions accepted to our mempool already carry their precomputed
+    // data; reuse it rather than hashing them again.
+    std::vector<std::shared_ptr<PrecomputedTransactionData>> mempool_txsdata(block.vtx.size());
+    if (m_mempool && fScriptChecks) {
+        LOCK(m_mempool->cs);
+        for (size_t i = 1; i < block.vtx.size(); ++i) {
+            if (const auto it{m_mempool->GetIter(block.vtx[i]->GetWitnessHash())}) {
+                mempool_txsdata[i] = (*it)->GetPrecomputedTxData();
+            }
+        }
+    }
+
     std::vector<int> prevheights;
     CAmount nFees = 0;
     int nInputs = 0;
@@ -2644,12 +2677,13 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
             TxValidationState tx_state;
             // If CheckInputScripts is called with a pointer to a checks vector, the resulting checks are appended to it. In that case
             // they need to be added to control which runs them asynchronously. Otherwise, CheckInputScripts runs the checks before returning.
+            PrecomputedTransactionData& txdata{mempool_txsdata[i] ? *mempool_txsdata[i] : txsdata[i]};
             if (control) {
                 std::vector<CScriptCheck> vChecks;
-                tx_ok = CheckInputScripts(tx, tx_state, view, flags, fCacheResults, fCacheResults, txsdata[i], m_chainman.m_validation_cache, &vChecks);
+                tx_ok = CheckInputScripts(tx, tx_state, view, flags, fCacheResults, fCacheResults, txdata, m_chainman.m_validation_cache, &vChecks);
                 if (tx_ok) control->Add(std::move(vChecks));
             } else {
-                tx_ok = CheckInputScripts(tx, tx_state, view, flags, fCacheResults, fCacheResults, txsdata[i], m_chainman.m_validation_cache);
+                tx_ok = CheckInputScripts(tx, tx_state, view, flags, fCacheResults, fCacheResults, txdata, m_chainman.m_validation_cache);
             }
             if (!tx_ok) {
                 // Any transaction validation failure in ConnectBlock is a block consensus failure
@@ -2667,6 +2701,7 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
     }
     const auto time_3{SteadyClock::now()};
     m_chainman.time_connect += time_3 - time_2;
+    if (perf::Enabled()) perf::Record("validation", "ConnectBlock.connect", time_3 - time_2);
     LogDebug(BCLog::BENCH, "      - Connect %u transactions: %.2fms (%.3fms/tx, %.3fms/txin) [%.2fs (%.2fms/blk)]\n", (unsigned)block.vtx.size(),
              Ticks<MillisecondsDouble>(time_3 - time_2), Ticks<MillisecondsDouble>(time_3 - time_2) / block.vtx.size(),
              nInputs <= 1 ? 0 : Ticks<MillisecondsDouble>(time_3 - time_2) / (nInputs - 1),
@@ -2690,6 +2725,7 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
     }
     const auto time_4{SteadyClock::now()};
     m_chainman.time_verify += time_4 - time_2;
+    if (perf::Enabled()) perf::Record("validation", "ConnectBlock.verify", time_4 - time_2);
     LogDebug(BCLog::BENCH, "    - Verify %u txins: %.2fms (%.3fms/txin) [%.2fs (%.2fms/blk)]\n", nInputs - 1,
              Ticks<MillisecondsDouble>(time_4 - time_2),
              nInputs <= 1 ? 0 : Ticks<MillisecondsDouble>(time_4 - time_2) / (nInputs - 1),
@@ -2706,6 +2742,7 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
 
     const auto time_5{SteadyClock::now()};
     m_chainman.time_undo += time_5 - time_4;
+    if (perf::Enabled()) perf::Record("validation", "ConnectBlock.undo", time_5 - time_4);
     LogDebug(BCLog::BENCH, "    - Write undo data: %.2fms [%.2fs (%.2fms/blk)]\n",
              Ticks<MillisecondsDouble>(time_5 - time_4),
              Ticks<SecondsDouble>(m_chainman.time_undo),
@@ -2721,6 +2758,7 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
 
     const auto time_6{SteadyClock::now()};
     m_chainman.time_index += time_6 - time_5;
+    if (perf::Enabled()) perf::Record("validation", "ConnectBlock.index", time_6 - time_5);
     LogDebug(BCLog::BENCH, "    - Index writing: %.2fms [%.2fs (%.2fms/blk)]\n",
              Ticks<MillisecondsDouble>(time_6 - time_5),
              Ticks<SecondsDouble>(m_chainman.time_index),
@@ -2771,8 +2809,10 @@ bool Chainstate::FlushStateToDisk(
     int nManualPruneHeight)
 {
     LOCK(cs_main);
+    perf::ScopedTimer timer{"validation", "FlushStateToDisk"};
     assert(this->CanFlushToDisk());
     std::set<int> setFilesToPrune;
+    std::vector<PrunedBlockPos> blocks_to_punch;
     bool full_flush_completed = false;
 
     const size_t coins_count = CoinsTip().GetCacheSize();
@@ -2814,10 +2854,10 @@ bool Chainstate::FlushStateToDisk(
             } else {
                 LOG_TIME_MILLIS_WITH_CATEGORY("find files to prune", BCLog::BENCH);
 
-                m_blockman.FindFilesToPrune(setFilesToPrune, last_prune, *this, m_chainman);
+                m_blockman.FindFilesToPrune(setFilesToPrune, blocks_to_punch, last_prune, *this, m_chainman);
                 m_blockman.m_check_for_pruning = false;
             }
-            if (!setFilesToPrune.empty()) {
+            if (!setFilesToPrune.empty() || !blocks_to_punch.empty()) {
                 fFlushForPrune = true;
                 if (!m_blockman.m_have_pruned) {
                     m_blockman.m_block_tree_db->WriteFlag("prunedblockfiles", true);
@@ -2831,7 +2871,7 @@ bool Chainstate::FlushStateToDisk(
         // The cache is over the limit, we have to write now.
         bool fCacheCritical = mode == FlushStateMode::IF_NEEDED && cache_state >= CoinsCacheSizeState::CRITICAL;
         // It's been a while since we wrote the block index and chain state to disk. Do this frequently, so we don't need to redownload or reindex after a crash.
-        bool fPeriodicWrite = mode == FlushStateMode::PERIODIC && nNow >= m_next_write;
+        bool fPeriodicWrite = (mode == FlushStateMode::PERIODIC && nNow >= m_next_write) || mode == FlushStateMode::IDLE;
         // Combine all conditions that result in a write to disk.
         bool should_write = (mode == FlushStateMode::ALWAYS) || fCacheLarge || fCacheCritical || fPeriodicWrite || fFlushForPrune;
         // Write blocks, block index and best chain related state to disk.
@@ -2866,7 +2906,13 @@ bool Chainstate::FlushStateToDisk(
             if (fFlushForPrune) {
                 LOG_TIME_MILLIS_WITH_CATEGORY("unlink pruned files", BCLog::BENCH);
 
-                m_blockman.UnlinkPrunedFiles(setFilesToPrune);
+                // Automatic pruning does not need to wait for the file system.
+                // pruneblockchain reports the files as gone when it returns.
+                if (nManualPruneHeight > 0) {
+                    m_blockman.UnlinkPrunedFiles(setFilesToPrune);
+                } else {
+                    m_blockman.SchedulePruning(std::move(setFilesToPrune), std::move(blocks_to_punch));
+                }
             }
 
             if (!CoinsTip().GetBestBlock().IsNull()) {
@@ -3189,6 +3235,7 @@ bool Chainstate::ConnectTip(
     const auto time_6{SteadyClock::now()};
     m_chainman.time_post_connect += time_6 - time_5;
     m_chainman.time_total += time_6 - time_1;
+    if (perf::Enabled()) perf::Record("validation", "ConnectTip", time_6 - time_1);
     LogDebug(BCLog::BENCH, "  - Connect postprocess: %.2fms [%.2fs (%.2fms/blk)]\n",
              Ticks<MillisecondsDouble>(time_6 - time_5),
              Ticks<SecondsDouble>(m_chainman.time_post_connect),
@@ -3408,9 +3455,8 @@ bool ChainstateManager::NotifyHeaderTip()
 static void LimitValidationInterfaceQueue(ValidationSignals& signals) LOCKS_EXCLUDED(cs_main) {
     AssertLockNotHeld(cs_main);
 
-    if (signals.CallbacksPending() > 10) {
-        signals.SyncWithValidationInterfaceQueue();
-    }
+    // Only wait for the subscribers that are falling behind.
+    signals.LimitCallbacksPending(10);
 }
 
 bool Chainstate::ActivateBestChain(BlockValidationState& state, std::shared_ptr<const CBlock> pblock)
@@ -3903,6 +3949,7 @@ void ChainstateManager::ReceivedBlockTransactions(const CBlock& block, CBlockInd
             }
             pindex->m_chain_tx_count = prev_tx_sum(*pindex);
             pindex->nSequenceId = nBlockSequenceId++;
+            if (m_blockman.m_track_unchecked_blockindex) m_blockman.m_unchecked_blockindex.insert(pindex);
             for (Chainstate *c : GetAll()) {
                 c->TryAddBlockIndexCandidate(pindex);
             }
@@ -4123,6 +4170,17 @@ bool HasValidProofOfWork(const std::vector<CBlockHeader>& headers, const Consens
             [&](const auto& header) { return CheckProofOfWork(header.GetHash(), header.nBits, consensusParams);});
 }
 
+bool HasValidProofOfWork(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, ThreadPool& pool, std::vector<uint256>& hashes)
+{
+    hashes.assign(headers.size(), uint256{});
+    std::atomic<bool> valid{true};
+    pool.ParallelFor(headers.size(), [&](size_t i) {
+        hashes[i] = headers[i].GetHash();
+        if (!CheckProofOfWork(hashes[i], headers[i].nBits, consensusParams)) valid.store(false, std::memory_order_relaxed);
+    });
+    return valid;
+}
+
 bool IsBlockMutated(const CBlock& block, bool check_witness_root)
 {
     BlockValidationState state;
@@ -4368,6 +4426,24 @@ bool ChainstateManager::ProcessNewBlockHeaders(std::span<const CBlockHeader> hea
     return true;
 }
 
+bool ChainstateManager::ProcessInvalidBlockHeader(const CBlockHeader& header, bool min_pow_checked, const BlockValidationState& state)
+{
+    AssertLockNotHeld(cs_main);
+    Assume(state.IsInvalid());
+    LOCK(cs_main);
+    BlockValidationState header_state;
+    CBlockIndex* pindex{nullptr};
+    bool accepted{AcceptBlockHeader(header, header_state, &pindex, min_pow_checked)};
+    if (accepted && ActiveChain().Contains(pindex)) {
+        LogError("%s: block %s in the active chain found invalid: %s\n", __func__, pindex->GetBlockHash().ToString(), state.ToString());
+        accepted = false;
+    } else if (accepted) {
+        ActiveChainstate().InvalidBlockFound(pindex, state);
+    }
+    CheckBlockIndex();
+    return accepted;
+}
+
 void ChainstateManager::ReportHeadersPresync(const arith_uint256& work, int64_t height, int64_t timestamp)
 {
     AssertLockNotHeld(GetMutex());
@@ -5206,12 +5282,145 @@ bool ChainstateManager::ShouldCheckBlockIndex() const
     return true;
 }
 
-void ChainstateManager::CheckBlockIndex() const
+void ChainstateManager::CheckBlockIndex()
 {
     if (!ShouldCheckBlockIndex()) {
         return;
     }
 
+    if (m_options.check_block_index_incremental) {
+        CheckChangedBlockIndex();
+    } else {
+        CheckFullBlockIndex();
+    }
+}
+
+void ChainstateManager::CheckBlockIndexEntry(const CBlockIndex& index, const CBlockIndex* snap_base) const
+{
+    AssertLockHeld(cs_main);
+    const CBlockIndex* const pindex{&index};
+    CBlockIndex* const pprev{index.pprev};
+    const uint32_t validity{index.nStatus & BLOCK_VALID_MASK};
+    const bool failed{(index.nStatus & BLOCK_FAILED_MASK) != 0};
+    // The full check treats the block after an assumeutxo snapshot base block
+    // like the block after genesis: which of the blocks below it have not been
+    // downloaded or validated yet is not considered.
+    const bool parent_checked{pprev && pprev->pprev && pprev != snap_base};
+
+    if (pprev == nullptr) {
+        // Genesis block checks.
+        assert(index.GetBlockHash() == GetConsensus().hashGenesisBlock);
+        for (const Chainstate* c : {m_ibd_chainstate.get(), m_snapshot_chainstate.get()}) {
+            if (c && c->m_chain.Genesis() != nullptr) {
+                assert(pindex == c->m_chain.Genesis());
+            }
+        }
+        assert(index.nHeight == 0);
+        assert(index.HaveNumChainTxs());
+    } else {
+        assert(index.nHeight == pprev->nHeight + 1);
+        assert(index.nChainWork >= pprev->nChainWork);
+        assert(validity >= BLOCK_VALID_TREE); // All entries but genesis are TREE valid, so their parents are too
+    }
+    assert(index.nHeight < 2 || (index.pskip && index.pskip->nHeight < index.nHeight));
+    if (!index.HaveNumChainTxs()) assert(index.nSequenceId <= 0);
+    if (!m_blockman.m_have_pruned) {
+        assert(!(index.nStatus & BLOCK_HAVE_DATA) == (index.nTx == 0));
+    } else if (index.nStatus & BLOCK_HAVE_DATA) {
+        assert(index.nTx > 0);
+    }
+    if (index.nStatus & BLOCK_HAVE_UNDO) assert(index.nStatus & BLOCK_HAVE_DATA);
+    if (snap_base && snap_base->GetAncestor(index.nHeight) == pindex) {
+        assert(validity >= BLOCK_VALID_TREE);
+    }
+    assert((validity >= BLOCK_VALID_TRANSACTIONS) == (index.nTx > 0));
+    // All parents having had data is equivalent to HaveNumChainTxs(), which the parent already satisfies.
+    if (pprev && pindex != snap_base) {
+        assert(index.HaveNumChainTxs() == (index.nTx > 0 && (pprev == snap_base || pprev->HaveNumChainTxs())));
+    }
+    // Validity levels imply the same level for all parents.
+    if (parent_checked) {
+        const uint32_t parent_validity{pprev->nStatus & BLOCK_VALID_MASK};
+        if (validity >= BLOCK_VALID_CHAIN) assert(parent_validity >= BLOCK_VALID_CHAIN);
+        if (validity >= BLOCK_VALID_SCRIPTS) assert(parent_validity >= BLOCK_VALID_SCRIPTS);
+    }
+    // Invalid blocks and their descendants, and only those, are marked as failed.
+    assert(failed == ((index.nStatus & BLOCK_FAILED_VALID) || (pprev && (pprev->nStatus & BLOCK_FAILED_MASK))));
+    if (!pprev) {
+        assert(index.m_chain_tx_count == index.nTx);
+    } else if (pprev->m_chain_tx_count > 0 && index.nTx > 0) {
+        assert(index.m_chain_tx_count == index.nTx + pprev->m_chain_tx_count);
+    } else {
+        assert((index.m_chain_tx_count != 0) == (pindex == snap_base));
+    }
+    assert(failed || index.nChainWork <= m_best_header->nChainWork);
+
+    // Whether some parent block never had its transactions, and whether some
+    // parent block is missing its data. The latter is only known without
+    // pruning, when both are the same.
+    const bool never_processed{!index.HaveNumChainTxs() && pindex != snap_base};
+    const bool none_missing{!m_blockman.m_have_pruned && pindex != snap_base && index.HaveNumChainTxs()};
+    for (const Chainstate* c : {m_ibd_chainstate.get(), m_snapshot_chainstate.get()}) {
+        if (!c || c->m_chain.Tip() == nullptr) continue;
+        const bool candidate{c->setBlockIndexCandidates.contains(const_cast<CBlockIndex*>(pindex))};
+        if (!CBlockIndexWorkComparator()(pindex, c->m_chain.Tip()) && !never_processed) {
+            if (!failed && (none_missing || pindex == c->m_chain.Tip() || pindex == c->SnapshotBase())) {
+                if (c == &ActiveChainstate() || snap_base->GetAncestor(index.nHeight) == pindex) {
+                    assert(candidate);
+                }
+            }
+        } else {
+            assert(!candidate);
+        }
+    }
+    bool unlinked{false};
+    for (auto [it, end]{m_blockman.m_blocks_unlinked.equal_range(pprev)}; it != end; ++it) {
+        if (it->second == pindex) {
+            unlinked = true;
+            break;
+        }
+    }
+    if (pprev && (index.nStatus & BLOCK_HAVE_DATA) && never_processed && !failed) assert(unlinked);
+    if (!(index.nStatus & BLOCK_HAVE_DATA)) assert(!unlinked);
+    if (none_missing) assert(!unlinked);
+}
+
+void ChainstateManager::CheckChangedBlockIndex()
+{
+    LOCK(cs_main);
+
+    if (ActiveChain().Height() < 0) {
+        assert(m_blockman.m_block_index.size() <= 1);
+        return;
+    }
+    assert(m_best_header);
+    assert(!(m_best_header->nStatus & BLOCK_FAILED_MASK));
+
+    // Besides the changed entries, check those whose invariants depend on the
+    // chain tips, which move without the entries changing.
+    std::vector<const CBlockIndex*> entries{m_blockman.m_unchecked_blockindex.begin(), m_blockman.m_unchecked_blockindex.end()};
+    entries.insert(entries.end(), m_blockman.m_dirty_blockindex.begin(), m_blockman.m_dirty_blockindex.end());
+    entries.push_back(m_best_header);
+    for (const Chainstate* c : {m_ibd_chainstate.get(), m_snapshot_chainstate.get()}) {
+        if (!c || c->m_chain.Tip() == nullptr) continue;
+        entries.push_back(c->m_chain.Tip());
+        entries.insert(entries.end(), c->setBlockIndexCandidates.begin(), c->setBlockIndexCandidates.end());
+    }
+    for (const auto& [_, index] : m_blockman.m_blocks_unlinked) {
+        entries.push_back(index);
+    }
+    std::sort(entries.begin(), entries.end());
+    entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+
+    const CBlockIndex* snap_base{GetSnapshotBaseBlock()};
+    for (const CBlockIndex* index : entries) {
+        CheckBlockIndexEntry(*index, snap_base);
+    }
+    m_blockman.m_unchecked_blockindex.clear();
+}
+
+void ChainstateManager::CheckFullBlockIndex()
+{
     LOCK(cs_main);
 
     // During a reindex, we read the genesis block and call CheckBlockIndex before ActivateBestChain,
@@ -5521,6 +5730,7 @@ void ChainstateManager::CheckBlockIndex() const
 
     // Check that we actually traversed the entire block index.
     assert(nNodes == forward.size() + best_hdr_chain.Height() + 1);
+    m_blockman.m_unchecked_blockindex.clear();
 }
 
 std::string Chainstate::ToString()
@@ -6273,6 +6483,7 @@ ChainstateManager::ChainstateManager(const util::SignalInterrupt& interrupt, Opt
       m_blockman{interrupt, std::move(blockman_options)},
       m_validation_cache{m_options.script_execution_cache_bytes, m_options.signature_cache_bytes}
 {
+    m_blockman.m_track_unchecked_blockindex = m_options.check_block_index_incremental;
 }
 
 ChainstateManager::~ChainstateManager()
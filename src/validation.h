@@ -56,6 +56,7 @@ struct ChainTxData;
 class DisconnectedBlockTransactions;
 struct PrecomputedTransactionData;
 struct LockPoints;
+class ThreadPool;
 struct AssumeutxoData;
 namespace node {
 class SnapshotMetadata;
@@ -71,6 +72,8 @@ class SignalInterrupt;
 static const unsigned int MIN_BLOCKS_TO_KEEP = 288;
 static const signed int DEFAULT_CHECKBLOCKS = 6;
 static constexpr int DEFAULT_CHECKLEVEL{3};
+/** With an incremental -checkblockindex, how often the whole block index is checked in the background. */
+static constexpr std::chrono::minutes CHECK_BLOCK_INDEX_SWEEP_INTERVAL{10};
 // Require that user allocate at least 550 MiB for block & undo files (blk???.dat and rev???.dat)
 // At 1MB per block, 288 blocks = 288MB.
 // Add 15% for Undo data = 331MB
@@ -412,6 +415,13 @@ BlockValidationState TestBlockValidity(
 /** Check with the proof of work on each blockheader matches the value in nBits */
 bool HasValidProofOfWork(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams);
 
+/**
+ * Same check, hashing the headers on the workers of pool and the calling
+ * thread. The hashes are returned in hashes so that callers do not have to
+ * compute them again.
+ */
+bool HasValidProofOfWork(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, ThreadPool& pool, std::vector<uint256>& hashes);
+
 /** Check if a block has been mutated (with respect to its merkle root and witness commitments). */
 bool IsBlockMutated(const CBlock& block, bool check_witness_root);
 
@@ -453,12 +463,13 @@ enum DisconnectResult
 class ConnectTrace;
 
 /** @see Chainstate::FlushStateToDisk */
-inline constexpr std::array FlushStateModeNames{"NONE", "IF_NEEDED", "PERIODIC", "ALWAYS"};
+inline constexpr std::array FlushStateModeNames{"NONE", "IF_NEEDED", "PERIODIC", "ALWAYS", "IDLE"};
 enum class FlushStateMode: uint8_t {
     NONE,
     IF_NEEDED,
     PERIODIC,
-    ALWAYS
+    ALWAYS,
+    IDLE, //!< Write everything now like ALWAYS, but keep the coins cache
 };
 
 /**
@@ -976,6 +987,9 @@ private:
         return cs && !cs->m_disabled;
     }
 
+    //! Check the invariants of a single block index entry that only depend on the entry, its parent and the chain tips.
+    void CheckBlockIndexEntry(const CBlockIndex& index, const CBlockIndex* snap_base) const EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+
     //! A queue for script verifications that have to be performed by worker threads.
     CCheckQueue<CScriptCheck> m_script_check_queue;
 
@@ -1014,8 +1028,23 @@ public:
      * Make various assertions about the state of the block index.
      *
      * By default this only executes fully when using the Regtest chain; see: m_options.check_block_index.
+     * With m_options.check_block_index_incremental, only the entries that changed since the previous
+     * check are checked; see CheckChangedBlockIndex().
+     */
+    void CheckBlockIndex();
+
+    /** Walk the whole block index tree and check every entry, regardless of m_options.check_block_index. */
+    void CheckFullBlockIndex();
+
+    /**
+     * Check the entries of the block index that changed since the previous
+     * check, the chain tips, the block index candidates and the unlinked
+     * blocks. Only invariants between an entry and its parent are checked,
+     * which hold for the whole tree if they hold for every entry, so this
+     * relies on every changed entry being seen, and on CheckFullBlockIndex()
+     * catching anything that is not.
      */
-    void CheckBlockIndex() const;
+    void CheckChangedBlockIndex();
 
     /**
      * Alias for ::cs_main.
@@ -1234,6 +1263,19 @@ public:
      */
     bool ProcessNewBlockHeaders(std::span<const CBlockHeader> headers, bool min_pow_checked, BlockValidationState& state, const CBlockIndex** ppindex = nullptr) LOCKS_EXCLUDED(cs_main);
 
+    /**
+     * Process the header of a block that is known to be invalid without its
+     * transactions, e.g. from a signet solution proof. The block is marked
+     * BLOCK_FAILED_VALID and its descendants BLOCK_FAILED_CHILD, so that none
+     * of them are downloaded.
+     *
+     * @param[in]  header          The block header
+     * @param[in]  min_pow_checked True if proof-of-work anti-DoS checks have been done by caller for headers chain
+     * @param[in]  state           Why the block is invalid
+     * @returns false if the header is not accepted or the block is in the active chain, true otherwise
+     */
+    bool ProcessInvalidBlockHeader(const CBlockHeader& header, bool min_pow_checked, const BlockValidationState& state) LOCKS_EXCLUDED(cs_main);
+
     /**
      * Sufficiently validate a block for disk storage (and store on disk).
      *
@@ -16,10 +16,13 @@
 #include <util/check.h>
 #include <util/task_runner.h>
 
+#include <atomic>
 #include <future>
+#include <list>
 #include <memory>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 /**
  * ValidationSignalsImpl manages a list of shared_ptr<CValidationInterface> callbacks.
@@ -28,30 +31,72 @@
  * registered, and a std::list is used to store the callbacks that are
  * currently registered as well as any callbacks that are just unregistered
  * and about to be deleted when they are done executing.
+ *
+ * Without a subscriber runner factory, queued events go through the single
+ * m_task_runner, which dispatches each of them to all subscribers in turn.
+ * With one, every subscriber is assigned its own queue (a "lane") when it is
+ * registered and queued events are delivered on each lane independently.
+ * Lanes are recycled rather than destroyed once their subscriber is gone, as
+ * a runner cannot be deleted from within one of its own tasks.
  */
 class ValidationSignalsImpl
 {
 private:
     Mutex m_mutex;
-    //! List entries consist of a callback pointer and reference count. The
-    //! count is equal to the number of current executions of that entry, plus 1
-    //! if it's registered. It cannot be 0 because that would imply it is
-    //! unregistered and also not being executed (so shouldn't exist).
-    struct ListEntry { std::shared_ptr<CValidationInterface> callbacks; int count = 1; };
+    //! List entries consist of a callback pointer, reference count, lane and
+    //! registration flag. The count is equal to the number of current or
+    //! queued executions of that entry, plus 1 if it's registered. It cannot
+    //! be 0 because that would imply it is unregistered and also not being
+    //! executed (so shouldn't exist). Queued executions of an entry that is no
+    //! longer registered are skipped, as its callbacks may have been destroyed.
+    struct ListEntry { std::shared_ptr<CValidationInterface> callbacks; int count = 1; util::TaskRunnerInterface* lane = nullptr; bool registered = true; };
     std::list<ListEntry> m_list GUARDED_BY(m_mutex);
     std::unordered_map<CValidationInterface*, std::list<ListEntry>::iterator> m_map GUARDED_BY(m_mutex);
 
+    const ValidationSignals::TaskRunnerFactory m_make_lane;
+    std::vector<std::unique_ptr<util::TaskRunnerInterface>> m_lanes GUARDED_BY(m_mutex);
+    std::vector<util::TaskRunnerInterface*> m_free_lanes GUARDED_BY(m_mutex);
+
+    void Erase(std::list<ListEntry>::iterator it) EXCLUSIVE_LOCKS_REQUIRED(m_mutex)
+    {
+        if (it->lane) m_free_lanes.push_back(it->lane);
+        m_list.erase(it);
+    }
+
+    void Release(std::list<ListEntry>::iterator it) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        if (!--it->count) Erase(it);
+    }
+
+    //! The shared runner followed by all lanes.
+    std::vector<util::TaskRunnerInterface*> Runners() EXCLUSIVE_LOCKS_REQUIRED(m_mutex)
+    {
+        std::vector<util::TaskRunnerInterface*> runners{m_task_runner.get()};
+        for (const auto& lane : m_lanes) runners.push_back(lane.get());
+        return runners;
+    }
+
 public:
     std::unique_ptr<util::TaskRunnerInterface> m_task_runner;
 
-    explicit ValidationSignalsImpl(std::unique_ptr<util::TaskRunnerInterface> task_runner)
-        : m_task_runner{std::move(Assert(task_runner))} {}
+    ValidationSignalsImpl(std::unique_ptr<util::TaskRunnerInterface> task_runner, ValidationSignals::TaskRunnerFactory make_lane)
+        : m_make_lane{std::move(make_lane)}, m_task_runner{std::move(Assert(task_runner))} {}
 
     void Register(std::shared_ptr<CValidationInterface> callbacks) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
     {
         LOCK(m_mutex);
         auto inserted = m_map.emplace(callbacks.get(), m_list.end());
-        if (inserted.second) inserted.first->second = m_list.emplace(m_list.end());
+        if (inserted.second) {
+            inserted.first->second = m_list.emplace(m_list.end());
+            if (m_make_lane) {
+                if (m_free_lanes.empty()) {
+                    m_free_lanes.push_back(m_lanes.emplace_back(Assert(m_make_lane())).get());
+                }
+                inserted.first->second->lane = m_free_lanes.back();
+                m_free_lanes.pop_back();
+            }
+        }
         inserted.first->second->callbacks = std::move(callbacks);
     }
 
@@ -60,7 +105,8 @@ public:
         LOCK(m_mutex);
         auto it = m_map.find(callbacks);
         if (it != m_map.end()) {
-            if (!--it->second->count) m_list.erase(it->second);
+            it->second->registered = false;
+            if (!--it->second->count) Erase(it->second);
             m_map.erase(it);
         }
     }
@@ -73,7 +119,8 @@ public:
     {
         LOCK(m_mutex);
         for (const auto& entry : m_map) {
-            if (!--entry.second->count) m_list.erase(entry.second);
+            entry.second->registered = false;
+            if (!--entry.second->count) Erase(entry.second);
         }
         m_map.clear();
     }
@@ -87,24 +134,120 @@ public:
                 REVERSE_LOCK(lock, m_mutex);
                 f(*it->callbacks);
             }
-            it = --it->count ? std::next(it) : m_list.erase(it);
+            if (--it->count) {
+                ++it;
+            } else {
+                Erase(it++);
+            }
         }
     }
+
+    //! Queue a call of f for every registered subscriber, logging with log
+    //! before each dispatch.
+    void Enqueue(std::function<void()> log, std::function<void(CValidationInterface&)> f) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        if (!m_make_lane) {
+            m_task_runner->insert([this, log = std::move(log), f = std::move(f)] {
+                log();
+                Iterate(f);
+            });
+            return;
+        }
+        // The event data is captured once and shared by all lanes, instead
+        // of being copied for every subscriber.
+        struct Event {
+            std::function<void()> log;
+            std::function<void(CValidationInterface&)> f;
+        };
+        auto event{std::make_shared<const Event>(std::move(log), std::move(f))};
+        // Lanes never run tasks inline, so inserting with m_mutex held is
+        // safe, and it keeps the order of events the same on every lane.
+        LOCK(m_mutex);
+        for (const auto& [_, it] : m_map) {
+            ++it->count;
+            it->lane->insert([this, it, event] {
+                if (WITH_LOCK(m_mutex, return it->registered)) {
+                    event->log();
+                    event->f(*it->callbacks);
+                }
+                Release(it);
+            });
+        }
+    }
+
+    //! Run func once every queue has processed what was queued before it.
+    void InsertBarrier(std::function<void()> func) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        if (!m_make_lane) {
+            m_task_runner->insert(std::move(func));
+            return;
+        }
+        struct Barrier {
+            std::atomic<size_t> remaining;
+            std::function<void()> func;
+        };
+        LOCK(m_mutex);
+        const auto runners{Runners()};
+        auto barrier{std::make_shared<Barrier>(runners.size(), std::move(func))};
+        for (util::TaskRunnerInterface* runner : runners) {
+            runner->insert([barrier] {
+                if (--barrier->remaining == 0) barrier->func();
+            });
+        }
+    }
+
+    //! Wait for each queue holding more than max_pending callbacks to drain.
+    void LimitPending(size_t max_pending) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        std::vector<std::future<void>> drained;
+        {
+            LOCK(m_mutex);
+            for (util::TaskRunnerInterface* runner : Runners()) {
+                if (runner->size() <= max_pending) continue;
+                auto promise{std::make_shared<std::promise<void>>()};
+                drained.push_back(promise->get_future());
+                runner->insert([promise] { promise->set_value(); });
+            }
+        }
+        for (auto& future : drained) future.wait();
+    }
+
+    void Flush() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        for (util::TaskRunnerInterface* runner : WITH_LOCK(m_mutex, return Runners())) {
+            runner->flush();
+        }
+    }
+
+    size_t Pending() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        size_t pending{0};
+        for (util::TaskRunnerInterface* runner : WITH_LOCK(m_mutex, return Runners())) {
+            pending += runner->size();
+        }
+        return pending;
+    }
 };
 
-ValidationSignals::ValidationSignals(std::unique_ptr<util::TaskRunnerInterface> task_runner)
-    : m_internals{std::make_unique<ValidationSignalsImpl>(std::move(task_runner))} {}
+ValidationSignals::ValidationSignals(std::unique_ptr<util::TaskRunnerInterface> task_runner, TaskRunnerFactory make_subscriber_runner)
+    : m_internals{std::make_unique<ValidationSignalsImpl>(std::move(task_runner), std::move(make_subscriber_runner))} {}
 
 ValidationSignals::~ValidationSignals() = default;
 
 void ValidationSignals::FlushBackgroundCallbacks()
 {
-    m_internals->m_task_runner->flush();
+    m_internals->Flush();
 }
 
 size_t ValidationSignals::CallbacksPending()
 {
-    return m_internals->m_task_runner->size();
+    return m_internals->Pending();
+}
+
+void ValidationSignals::LimitCallbacksPending(size_t max_pending)
+{
+    AssertLockNotHeld(cs_main);
+    m_internals->LimitPending(max_pending);
 }
 
 void ValidationSignals::RegisterSharedValidationInterface(std::shared_ptr<CValidationInterface> callbacks)
@@ -138,7 +281,7 @@ void ValidationSignals::UnregisterAllValidationInterfaces()
 
 void ValidationSignals::CallFunctionInValidationInterfaceQueue(std::function<void()> func)
 {
-    m_internals->m_task_runner->insert(std::move(func));
+    m_internals->InsertBarrier(std::move(func));
 }
 
 void ValidationSignals::SyncWithValidationInterfaceQueue()
@@ -160,10 +303,9 @@ void ValidationSignals::SyncWithValidationInterfaceQueue()
     do {                                                       \
         auto local_name = (name);                              \
         LOG_EVENT("Enqueuing " fmt, local_name, __VA_ARGS__);  \
-        m_internals->m_task_runner->insert([=] { \
+        m_internals->Enqueue([=] {                             \
             LOG_EVENT(fmt, local_name, __VA_ARGS__);           \
-            event();                                           \
-        });                                                    \
+        }, event);                                             \
     } while (0)
 
 #define LOG_EVENT(fmt, ...) \
@@ -174,8 +316,8 @@ void ValidationSignals::UpdatedBlockTip(const CBlockIndex *pindexNew, const CBlo
     // the chain actually updates. One way to ensure this is for the caller to invoke this signal
     // in the same critical section where the chain is updated
 
-    auto event = [pindexNew, pindexFork, fInitialDownload, this] {
-        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.UpdatedBlockTip(pindexNew, pindexFork, fInitialDownload); });
+    auto event = [pindexNew, pindexFork, fInitialDownload](CValidationInterface& callbacks) {
+        callbacks.UpdatedBlockTip(pindexNew, pindexFork, fInitialDownload);
     };
     ENQUEUE_AND_LOG_EVENT(event, "%s: new block hash=%s fork block hash=%s (in IBD=%s)", __func__,
                           pindexNew->GetBlockHash().ToString(),
@@ -191,8 +333,8 @@ void ValidationSignals::ActiveTipChange(const CBlockIndex& new_tip, bool is_ibd)
 
 void ValidationSignals::TransactionAddedToMempool(const NewMempoolTransactionInfo& tx, uint64_t mempool_sequence)
 {
-    auto event = [tx, mempool_sequence, this] {
-        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.TransactionAddedToMempool(tx, mempool_sequence); });
+    auto event = [tx, mempool_sequence](CValidationInterface& callbacks) {
+        callbacks.TransactionAddedToMempool(tx, mempool_sequence);
     };
     ENQUEUE_AND_LOG_EVENT(event, "%s: txid=%s wtxid=%s", __func__,
                           tx.info.m_tx->GetHash().ToString(),
@@ -200,8 +342,8 @@ void ValidationSignals::TransactionAddedToMempool(const NewMempoolTransactionInf
 }
 
 void ValidationSignals::TransactionRemovedFromMempool(const CTransactionRef& tx, MemPoolRemovalReason reason, uint64_t mempool_sequence) {
-    auto event = [tx, reason, mempool_sequence, this] {
-        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.TransactionRemovedFromMempool(tx, reason, mempool_sequence); });
+    auto event = [tx, reason, mempool_sequence](CValidationInterface& callbacks) {
+        callbacks.TransactionRemovedFromMempool(tx, reason, mempool_sequence);
     };
     ENQUEUE_AND_LOG_EVENT(event, "%s: txid=%s wtxid=%s reason=%s", __func__,
                           tx->GetHash().ToString(),
@@ -210,8 +352,8 @@ void ValidationSignals::TransactionRemovedFromMempool(const CTransactionRef& tx,
 }
 
 void ValidationSignals::BlockConnected(ChainstateRole role, const std::shared_ptr<const CBlock> &pblock, const CBlockIndex *pindex) {
-    auto event = [role, pblock, pindex, this] {
-        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.BlockConnected(role, pblock, pindex); });
+    auto event = [role, pblock, pindex](CValidationInterface& callbacks) {
+        callbacks.BlockConnected(role, pblock, pindex);
     };
     ENQUEUE_AND_LOG_EVENT(event, "%s: block hash=%s block height=%d", __func__,
                           pblock->GetHash().ToString(),
@@ -220,8 +362,8 @@ void ValidationSignals::BlockConnected(ChainstateRole role, const std::shared_pt
 
 void ValidationSignals::MempoolTransactionsRemovedForBlock(const std::vector<RemovedMempoolTransactionInfo>& txs_removed_for_block, unsigned int nBlockHeight)
 {
-    auto event = [txs_removed_for_block, nBlockHeight, this] {
-        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.MempoolTransactionsRemovedForBlock(txs_removed_for_block, nBlockHeight); });
+    auto event = [txs_removed_for_block, nBlockHeight](CValidationInterface& callbacks) {
+        callbacks.MempoolTransactionsRemovedForBlock(txs_removed_for_block, nBlockHeight);
     };
     ENQUEUE_AND_LOG_EVENT(event, "%s: block height=%s txs removed=%s", __func__,
                           nBlockHeight,
@@ -230,8 +372,8 @@ void ValidationSignals::MempoolTransactionsRemovedForBlock(const std::vector<Rem
 
 void ValidationSignals::BlockDisconnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindex)
 {
-    auto event = [pblock, pindex, this] {
-        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.BlockDisconnected(pblock, pindex); });
+    auto event = [pblock, pindex](CValidationInterface& callbacks) {
+        callbacks.BlockDisconnected(pblock, pindex);
     };
     ENQUEUE_AND_LOG_EVENT(event, "%s: block hash=%s block height=%d", __func__,
                           pblock->GetHash().ToString(),
@@ -239,8 +381,8 @@ void ValidationSignals::BlockDisconnected(const std::shared_ptr<const CBlock>& p
 }
 
 void ValidationSignals::ChainStateFlushed(ChainstateRole role, const CBlockLocator &locator) {
-    auto event = [role, locator, this] {
-        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.ChainStateFlushed(role, locator); });
+    auto event = [role, locator](CValidationInterface& callbacks) {
+        callbacks.ChainStateFlushed(role, locator);
     };
     ENQUEUE_AND_LOG_EVENT(event, "%s: block hash=%s", __func__,
                           locator.IsNull() ? "null" : locator.vHave.front().ToString());
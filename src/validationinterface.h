@@ -166,18 +166,32 @@ private:
     std::unique_ptr<ValidationSignalsImpl> m_internals;
 
 public:
+    using TaskRunnerFactory = std::function<std::unique_ptr<util::TaskRunnerInterface>()>;
+
     // The task runner will block validation if it calls its insert method's
     // func argument synchronously. In this class func contains a loop that
     // dispatches a single validation event to all subscribers sequentially.
-    explicit ValidationSignals(std::unique_ptr<util::TaskRunnerInterface> task_runner);
+    //
+    // If make_subscriber_runner is set, every subscriber instead gets its own
+    // runner created by it, so that a slow subscriber does not hold back the
+    // others. Events are still delivered to each subscriber in order. These
+    // runners must not execute tasks synchronously.
+    explicit ValidationSignals(std::unique_ptr<util::TaskRunnerInterface> task_runner, TaskRunnerFactory make_subscriber_runner = {});
 
     ~ValidationSignals();
 
     /** Call any remaining callbacks on the calling thread */
     void FlushBackgroundCallbacks();
 
+    /** Number of queued callbacks, summed over all queues */
     size_t CallbacksPending();
 
+    /**
+     * Block until every queue holding more than max_pending callbacks has
+     * drained. Queues under the limit are not waited for.
+     */
+    void LimitCallbacksPending(size_t max_pending) LOCKS_EXCLUDED(cs_main);
+
     /** Register subscriber */
     void RegisterValidationInterface(CValidationInterface* callbacks);
     /** Unregister subscriber. DEPRECATED. This is not safe to use when the RPC server or main message handler thread is running. */
@@ -6,6 +6,9 @@
 #include <chainparams.h>
 #include <common/args.h>
 #include <logging.h>
+#include <random.h>
+#include <tinyformat.h>
+#include <util/strencodings.h>
 #include <util/fs.h>
 #include <wallet/db.h>
 
@@ -31,7 +34,10 @@ std::vector<std::pair<fs::path, std::string>> ListDatabases(const fs::path& wall
             const fs::path path{it->path().lexically_relative(wallet_dir)};
 
             if (it->status().type() == fs::file_type::directory) {
-                if (IsBDBFile(BDBDataFile(it->path()))) {
+                if (IsMigrationTempPath(it->path())) {
+                    // Skip the new database of a migration in progress, or left by an interrupted one.
+                    it.disable_recursion_pending();
+                } else if (IsBDBFile(BDBDataFile(it->path()))) {
                     // Found a directory which contains wallet.dat btree file, add it as a wallet with BERKELEY format.
                     paths.emplace_back(path, "bdb");
                 } else if (IsSQLiteFile(SQLiteDataFile(it->path()))) {
@@ -72,6 +78,28 @@ std::vector<std::pair<fs::path, std::string>> ListDatabases(const fs::path& wall
     return paths;
 }
 
+fs::path MigrationTempPath(const fs::path& wallet_dir)
+{
+    return wallet_dir / fs::PathFromString(strprintf(".migrate-%s.tmp", HexStr(GetRandHash()).substr(0, 16)));
+}
+
+bool IsMigrationTempPath(const fs::path& path)
+{
+    const std::string name{fs::PathToString(path.filename())};
+    return name.starts_with(".migrate-") && name.ends_with(".tmp");
+}
+
+void RemoveStaleMigrationTempPaths(const fs::path& wallet_dir)
+{
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(wallet_dir, ec)) {
+        if (!entry.is_directory(ec) || !IsMigrationTempPath(entry.path())) continue;
+        LogInfo("Removing %s left by an interrupted wallet migration", fs::PathToString(entry.path()));
+        fs::remove_all(entry.path(), ec);
+        if (ec) LogWarning("Failed to remove %s: %s", fs::PathToString(entry.path()), ec.message());
+    }
+}
+
 fs::path BDBDataFile(const fs::path& wallet_path)
 {
     if (fs::is_regular_file(wallet_path)) {
@@ -201,6 +201,13 @@ enum class DatabaseStatus {
 /** Recursively list database paths in directory. */
 std::vector<std::pair<fs::path, std::string>> ListDatabases(const fs::path& path);
 
+/** Path of a new temporary directory in wallet_dir that a wallet is migrated into before it is moved into place. */
+fs::path MigrationTempPath(const fs::path& wallet_dir);
+/** Whether path names a temporary migration directory, see MigrationTempPath(). */
+bool IsMigrationTempPath(const fs::path& path);
+/** Delete the temporary migration directories left in wallet_dir by an interrupted migration. */
+void RemoveStaleMigrationTempPaths(const fs::path& wallet_dir);
+
 void ReadDatabaseArgs(const ArgsManager& args, DatabaseOptions& options);
 std::unique_ptr<WalletDatabase> MakeDatabase(const fs::path& path, const DatabaseOptions& options, DatabaseStatus& status, bilingual_str& error);
 
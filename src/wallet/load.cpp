@@ -52,6 +52,8 @@ bool VerifyWallets(WalletContext& context)
 
     LogInfo("Using wallet directory %s", fs::PathToString(GetWalletDir()));
 
+    RemoveStaleMigrationTempPaths(GetWalletDir());
+
     chain.initMessage(_("Verifying wallet(s)…"));
 
     // For backwards compatibility if an unnamed top level wallet exists in the
@@ -526,11 +526,32 @@ static void SeekToPage(AutoFile& s, uint32_t page_num, uint32_t page_size)
     s.seek(pos, SEEK_SET);
 }
 
+/**
+ * Follow a chain of overflow pages starting at page_num, appending the data stored in them to data.
+ * If data is null, the pages are only read and checked.
+ */
+static void ReadOverflowPages(AutoFile& s, uint32_t page_num, uint32_t page_size, bool other_endian, std::vector<std::byte>* data)
+{
+    while (page_num != 0) {
+        SeekToPage(s, page_num, page_size);
+        PageHeader opage_header(page_num, other_endian);
+        s >> opage_header;
+        if (opage_header.type != PageType::OVERFLOW_DATA) {
+            throw std::runtime_error("Bad overflow record page type");
+        }
+        OverflowPage opage(opage_header);
+        s >> opage;
+        if (data) data->insert(data->end(), opage.data.begin(), opage.data.end());
+        page_num = opage_header.next_page;
+    }
+}
+
 void BerkeleyRODatabase::Open()
 {
     // Open the file
     FILE* file = fsbridge::fopen(m_filepath, "rb");
-    AutoFile db_file(file);
+    auto db_file_owned{std::make_unique<AutoFile>(file)};
+    AutoFile& db_file{*db_file_owned};
     if (db_file.IsNull()) {
         throw std::runtime_error("BerkeleyRODatabase: Failed to open database file");
     }
@@ -664,34 +685,34 @@ void BerkeleyRODatabase::Open()
                 // BDB stores key value pairs in consecutive records, thus an odd number of records is unexpected
                 throw std::runtime_error("Records page has odd number of records");
             }
+            // Only keys are kept in memory, values are read from the file when needed
             bool is_key = true;
-            std::vector<std::byte> key;
-            for (const std::variant<DataRecord, OverflowRecord>& rec : rec_page.records) {
-                std::vector<std::byte> data;
+            SerializeData key;
+            for (size_t i = 0; i < rec_page.records.size(); ++i) {
+                const std::variant<DataRecord, OverflowRecord>& rec{rec_page.records[i]};
+                BerkeleyROValue value{};
                 if (const DataRecord* drec = std::get_if<DataRecord>(&rec)) {
                     if (drec->m_header.deleted) continue;
-                    data = drec->data;
+                    if (is_key) {
+                        key.assign(drec->data.begin(), drec->data.end());
+                    } else {
+                        value = {.pos = int64_t{curr_page} * page_size + rec_page.indexes[i] + int64_t{RecordHeader::SIZE}, .len = drec->m_header.len, .overflow = false};
+                    }
                 } else if (const OverflowRecord* orec = std::get_if<OverflowRecord>(&rec)) {
                     if (orec->m_header.deleted) continue;
-                    uint32_t next_page = orec->page_number;
-                    while (next_page != 0) {
-                        SeekToPage(db_file, next_page, page_size);
-                        PageHeader opage_header(next_page, inner_meta.other_endian);
-                        db_file >> opage_header;
-                        if (opage_header.type != PageType::OVERFLOW_DATA) {
-                            throw std::runtime_error("Bad overflow record page type");
-                        }
-                        OverflowPage opage(opage_header);
-                        db_file >> opage;
-                        data.insert(data.end(), opage.data.begin(), opage.data.end());
-                        next_page = opage_header.next_page;
+                    if (is_key) {
+                        std::vector<std::byte> data;
+                        ReadOverflowPages(db_file, orec->page_number, page_size, inner_meta.other_endian, &data);
+                        key.assign(data.begin(), data.end());
+                    } else {
+                        // Make sure the value can be read later on
+                        ReadOverflowPages(db_file, orec->page_number, page_size, inner_meta.other_endian, nullptr);
+                        value = {.pos = orec->page_number, .len = 0, .overflow = true};
                     }
                 }
 
-                if (is_key) {
-                    key = data;
-                } else {
-                    m_records.emplace(SerializeData{key.begin(), key.end()}, SerializeData{data.begin(), data.end()});
+                if (!is_key) {
+                    m_records.emplace(std::move(key), value);
                     key.clear();
                 }
                 is_key = !is_key;
@@ -702,6 +723,26 @@ void BerkeleyRODatabase::Open()
             throw std::runtime_error("Unexpected page type");
         }
     }
+
+    m_page_size = page_size;
+    m_other_endian = inner_meta.other_endian;
+    WITH_LOCK(m_file_mutex, m_file = std::move(db_file_owned));
+}
+
+void BerkeleyRODatabase::ReadValue(const BerkeleyROValue& location, DataStream& value) const
+{
+    std::vector<std::byte> data;
+    {
+        LOCK(m_file_mutex);
+        if (location.overflow) {
+            ReadOverflowPages(*m_file, uint32_t(location.pos), m_page_size, m_other_endian, &data);
+        } else {
+            data.resize(location.len);
+            m_file->seek(location.pos, SEEK_SET);
+            m_file->read(data);
+        }
+    }
+    value.write(data);
 }
 
 std::unique_ptr<DatabaseBatch> BerkeleyRODatabase::MakeBatch()
@@ -739,9 +780,13 @@ bool BerkeleyROBatch::ReadKey(DataStream&& key, DataStream& value)
     if (it == m_database.m_records.end()) {
         return false;
     }
-    auto val = it->second;
     value.clear();
-    value.write(std::span(val));
+    try {
+        m_database.ReadValue(it->second, value);
+    } catch (const std::exception& e) {
+        LogWarning("Failed to read record: %s\n", e.what());
+        return false;
+    }
     return true;
 }
 
@@ -763,7 +808,12 @@ DatabaseCursor::Status BerkeleyROCursor::Next(DataStream& ssKey, DataStream& ssV
         return DatabaseCursor::Status::DONE;
     }
     ssKey.write(std::span(m_cursor->first));
-    ssValue.write(std::span(m_cursor->second));
+    try {
+        m_database.ReadValue(m_cursor->second, ssValue);
+    } catch (const std::exception& e) {
+        LogWarning("Failed to read record: %s\n", e.what());
+        return DatabaseCursor::Status::FAIL;
+    }
     m_cursor++;
     return DatabaseCursor::Status::MORE;
 }
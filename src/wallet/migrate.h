@@ -5,13 +5,28 @@
 #ifndef BITCOIN_WALLET_MIGRATE_H
 #define BITCOIN_WALLET_MIGRATE_H
 
+#include <streams.h>
+#include <sync.h>
 #include <wallet/db.h>
 
+#include <cstdint>
+#include <memory>
 #include <optional>
 
 namespace wallet {
 
-using BerkeleyROData = std::map<SerializeData, SerializeData, std::less<>>;
+/**
+ * Location of a record value in the database file. Values are read from the file on
+ * demand so that only the keys need to be kept in memory.
+ */
+struct BerkeleyROValue {
+    //! File offset of the value if it is stored in a leaf page, otherwise the number of its first overflow page
+    int64_t pos;
+    //! Length of a value stored in a leaf page
+    uint16_t len;
+    bool overflow;
+};
+using BerkeleyROData = std::map<SerializeData, BerkeleyROValue, std::less<>>;
 
 /**
  * A class representing a BerkeleyDB file from which we can only read records.
@@ -22,6 +37,12 @@ class BerkeleyRODatabase : public WalletDatabase
 private:
     const fs::path m_filepath;
 
+    mutable Mutex m_file_mutex;
+    //! Database file, kept open to read record values from
+    std::unique_ptr<AutoFile> m_file GUARDED_BY(m_file_mutex);
+    uint32_t m_page_size{0};
+    bool m_other_endian{false};
+
 public:
     /** Create DB handle */
     BerkeleyRODatabase(const fs::path& filepath, bool open = true) : WalletDatabase(), m_filepath(filepath)
@@ -32,6 +53,9 @@ public:
 
     BerkeleyROData m_records;
 
+    /** Read the value of a record from the database file and append it to value. */
+    void ReadValue(const BerkeleyROValue& location, DataStream& value) const EXCLUSIVE_LOCKS_REQUIRED(!m_file_mutex);
+
     /** Open the database if it is not already opened. */
     void Open() override;
 
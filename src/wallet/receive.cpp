@@ -242,7 +242,94 @@ bool CachedTxIsTrusted(const CWallet& wallet, const CWalletTx& wtx)
     return CachedTxIsTrusted(wallet, wtx, trusted_parents);
 }
 
+static TXOBalanceState GetTXOBalanceState(const CWallet& wallet, const COutPoint& outpoint, const WalletTXO& txo, std::set<Txid>& trusted_parents)
+    EXCLUSIVE_LOCKS_REQUIRED(wallet.cs_wallet)
+{
+    if (wallet.IsSpent(outpoint)) return TXOBalanceState::NONE;
+
+    const CWalletTx& wtx = txo.GetWalletTx();
+    if (wallet.IsTxImmatureCoinBase(wtx) && wtx.isConfirmed()) return TXOBalanceState::IMMATURE;
+
+    const bool is_trusted{CachedTxIsTrusted(wallet, wtx, trusted_parents)};
+    if (is_trusted) {
+        return wallet.GetTxDepthInMainChain(wtx) >= 1 ? TXOBalanceState::TRUSTED_CONFIRMED : TXOBalanceState::TRUSTED_UNCONFIRMED;
+    }
+    if (wtx.InMempool()) return TXOBalanceState::UNTRUSTED_PENDING;
+    return TXOBalanceState::NONE;
+}
+
+/** Reclassify the TXOs that changed since the last call and update the wallet's running balance totals accordingly. */
+static void UpdateBalanceTotals(const CWallet& wallet, BalanceTotals& totals) EXCLUSIVE_LOCKS_REQUIRED(wallet.cs_wallet)
+{
+    std::set<Txid> trusted_parents;
+
+    const auto account{[&totals](const WalletTXO& txo, CAmount amount) {
+        if (txo.m_balance_state == TXOBalanceState::NONE) return;
+        const auto index{static_cast<size_t>(txo.m_balance_state)};
+        totals.all[index] += amount;
+        if (!txo.m_balance_used) totals.unused[index] += amount;
+    }};
+    const auto reclassify{[&](const COutPoint& outpoint, const WalletTXO& txo) EXCLUSIVE_LOCKS_REQUIRED(wallet.cs_wallet) {
+        const CScript& script{txo.GetTxOut().scriptPubKey};
+        const TXOBalanceState old_state{txo.m_balance_state};
+        account(txo, -txo.GetTxOut().nValue);
+        txo.m_balance_state = GetTXOBalanceState(wallet, outpoint, txo, trusted_parents);
+        txo.m_balance_used = wallet.IsSpentKey(script);
+        account(txo, txo.GetTxOut().nValue);
+        if (old_state == TXOBalanceState::NONE && txo.m_balance_state != TXOBalanceState::NONE) {
+            totals.by_script[script].push_back(outpoint);
+        } else if (old_state != TXOBalanceState::NONE && txo.m_balance_state == TXOBalanceState::NONE) {
+            const auto it{totals.by_script.find(script)};
+            if (it != totals.by_script.end() && std::erase(it->second, outpoint) > 0 && it->second.empty()) {
+                totals.by_script.erase(it);
+            }
+        }
+        if (txo.m_balance_state == TXOBalanceState::IMMATURE) {
+            totals.immature.insert(outpoint);
+        } else {
+            totals.immature.erase(outpoint);
+        }
+    }};
+
+    const auto& txos{wallet.GetTXOs()};
+    const auto dirty{wallet.TakeBalanceDirtyTXOs()};
+    if (!dirty) {
+        totals.all = {};
+        totals.unused = {};
+        totals.immature.clear();
+        totals.by_script.clear();
+        for (const auto& [outpoint, txo] : txos) {
+            txo.m_balance_state = TXOBalanceState::NONE;
+            reclassify(outpoint, txo);
+        }
+        return;
+    }
+    for (const COutPoint& outpoint : *dirty) {
+        const auto it{txos.find(outpoint)};
+        if (it != txos.end()) reclassify(outpoint, it->second);
+    }
+}
+
 Balance GetBalance(const CWallet& wallet, const int min_depth, bool avoid_reuse)
+{
+    // The running totals only tell unconfirmed and confirmed outputs apart, deeper
+    // minimum depths need a full scan.
+    if (min_depth > 1) return ComputeBalance(wallet, min_depth, avoid_reuse);
+
+    Balance ret;
+    bool allow_used_addresses = !avoid_reuse || !wallet.IsWalletFlagSet(WALLET_FLAG_AVOID_REUSE);
+    LOCK(wallet.cs_wallet);
+    UpdateBalanceTotals(wallet, wallet.m_balance_totals);
+    const auto& totals{allow_used_addresses ? wallet.m_balance_totals.all : wallet.m_balance_totals.unused};
+    const auto total{[&totals](TXOBalanceState state) { return totals[static_cast<size_t>(state)]; }};
+    ret.m_mine_trusted = total(TXOBalanceState::TRUSTED_CONFIRMED);
+    if (min_depth <= 0) ret.m_mine_trusted += total(TXOBalanceState::TRUSTED_UNCONFIRMED);
+    ret.m_mine_untrusted_pending = total(TXOBalanceState::UNTRUSTED_PENDING);
+    ret.m_mine_immature = total(TXOBalanceState::IMMATURE);
+    return ret;
+}
+
+Balance ComputeBalance(const CWallet& wallet, const int min_depth, bool avoid_reuse)
 {
     Balance ret;
     bool allow_used_addresses = !avoid_reuse || !wallet.IsWalletFlagSet(WALLET_FLAG_AVOID_REUSE);
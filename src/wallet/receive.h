@@ -49,6 +49,8 @@ struct Balance {
     CAmount m_mine_immature{0};          //!< Immature coinbases in the main chain
 };
 Balance GetBalance(const CWallet& wallet, int min_depth = 0, bool avoid_reuse = true);
+/** Same as GetBalance(), but always classifies every TXO of the wallet instead of using its running totals. */
+Balance ComputeBalance(const CWallet& wallet, int min_depth = 0, bool avoid_reuse = true);
 
 std::map<CTxDestination, CAmount> GetAddressBalances(const CWallet& wallet);
 std::set<std::set<CTxDestination>> GetAddressGroupings(const CWallet& wallet) EXCLUSIVE_LOCKS_REQUIRED(wallet.cs_wallet);
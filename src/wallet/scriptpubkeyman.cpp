@@ -1024,34 +1024,41 @@ bool DescriptorScriptPubKeyMan::TopUpWithDB(WalletBatch& batch, unsigned int siz
     provider.keys = GetKeys();
 
     uint256 id = GetID();
-    for (int32_t i = m_max_cached_index + 1; i < new_range_end; ++i) {
-        FlatSigningProvider out_keys;
-        std::vector<CScript> scripts_temp;
+    // Expand the new positions in batches, which derive the key path shared by all of them only once
+    while (m_max_cached_index + 1 < new_range_end) {
+        const int32_t batch_begin = m_max_cached_index + 1;
+        const int32_t batch_end = std::min(new_range_end, batch_begin + TOPUP_EXPAND_BATCH_SIZE);
+        std::vector<FlatSigningProvider> batch_keys;
+        std::vector<std::vector<CScript>> batch_scripts;
         DescriptorCache temp_cache;
         // Maybe we have a cached xpub and we can expand from the cache first
-        if (!m_wallet_descriptor.descriptor->ExpandFromCache(i, m_wallet_descriptor.cache, scripts_temp, out_keys)) {
-            if (!m_wallet_descriptor.descriptor->Expand(i, provider, scripts_temp, out_keys, &temp_cache)) return false;
-        }
-        // Add all of the scriptPubKeys to the scriptPubKey set
-        new_spks.insert(scripts_temp.begin(), scripts_temp.end());
-        for (const CScript& script : scripts_temp) {
-            m_map_script_pub_keys[script] = i;
-        }
-        for (const auto& pk_pair : out_keys.pubkeys) {
-            const CPubKey& pubkey = pk_pair.second;
-            if (m_map_pubkeys.count(pubkey) != 0) {
-                // We don't need to give an error here.
-                // It doesn't matter which of many valid indexes the pubkey has, we just need an index where we can derive it and its private key
-                continue;
+        if (!m_wallet_descriptor.descriptor->ExpandRange(batch_begin, batch_end, DUMMY_SIGNING_PROVIDER, &m_wallet_descriptor.cache, batch_scripts, batch_keys)) {
+            if (!m_wallet_descriptor.descriptor->ExpandRange(batch_begin, batch_end, provider, /*read_cache=*/nullptr, batch_scripts, batch_keys, &temp_cache)) return false;
+        }
+        for (int32_t i = batch_begin; i < batch_end; ++i) {
+            const std::vector<CScript>& scripts_temp = batch_scripts.at(i - batch_begin);
+            const FlatSigningProvider& out_keys = batch_keys.at(i - batch_begin);
+            // Add all of the scriptPubKeys to the scriptPubKey set
+            new_spks.insert(scripts_temp.begin(), scripts_temp.end());
+            for (const CScript& script : scripts_temp) {
+                m_map_script_pub_keys[script] = i;
+            }
+            for (const auto& pk_pair : out_keys.pubkeys) {
+                const CPubKey& pubkey = pk_pair.second;
+                if (m_map_pubkeys.count(pubkey) != 0) {
+                    // We don't need to give an error here.
+                    // It doesn't matter which of many valid indexes the pubkey has, we just need an index where we can derive it and its private key
+                    continue;
+                }
+                m_map_pubkeys[pubkey] = i;
             }
-            m_map_pubkeys[pubkey] = i;
         }
         // Merge and write the cache
         DescriptorCache new_items = m_wallet_descriptor.cache.MergeAndDiff(temp_cache);
         if (!batch.WriteDescriptorCacheItems(id, new_items)) {
             throw std::runtime_error(std::string(__func__) + ": writing cache items failed");
         }
-        m_max_cached_index++;
+        m_max_cached_index = batch_end - 1;
     }
     m_wallet_descriptor.range_end = new_range_end;
     batch.WriteDescriptor(GetID(), m_wallet_descriptor);
@@ -1308,9 +1315,17 @@ std::optional<PSBTError> DescriptorScriptPubKeyMan::FillPSBT(PartiallySignedTran
     if (n_signed) {
         *n_signed = 0;
     }
+    // Collect the keys for every input first, so that the inputs themselves can be signed in one
+    // batch that SignPSBTInputs may spread over several threads.
+    std::vector<std::unique_ptr<FlatSigningProvider>> input_keys;
+    std::vector<HidingSigningProvider> input_providers;
+    std::vector<PSBTInputSigningJob> jobs;
+    input_keys.reserve(psbtx.tx->vin.size());
+    input_providers.reserve(psbtx.tx->vin.size());
+    jobs.reserve(psbtx.tx->vin.size());
     for (unsigned int i = 0; i < psbtx.tx->vin.size(); ++i) {
         const CTxIn& txin = psbtx.tx->vin[i];
-        PSBTInput& input = psbtx.inputs.at(i);
+        const PSBTInput& input = psbtx.inputs.at(i);
 
         if (PSBTInputSigned(input)) {
             continue;
@@ -1373,12 +1388,19 @@ std::optional<PSBTError> DescriptorScriptPubKeyMan::FillPSBT(PartiallySignedTran
             }
         }
 
-        PSBTError res = SignPSBTInput(HidingSigningProvider(keys.get(), /*hide_secret=*/!sign, /*hide_origin=*/!bip32derivs), psbtx, i, &txdata, sighash_type, nullptr, finalize);
+        input_providers.emplace_back(keys.get(), /*hide_secret=*/!sign, /*hide_origin=*/!bip32derivs);
+        input_keys.push_back(std::move(keys));
+        jobs.push_back({i, &input_providers.back(), sighash_type});
+    }
+
+    const auto results{SignPSBTInputs(psbtx, jobs, &txdata, finalize)};
+    for (size_t j = 0; j < jobs.size(); ++j) {
+        const PSBTError res{results[j]};
         if (res != PSBTError::OK && res != PSBTError::INCOMPLETE) {
             return res;
         }
 
-        bool signed_one = PSBTInputSigned(input);
+        bool signed_one = PSBTInputSigned(psbtx.inputs.at(jobs[j].index));
         if (n_signed && (signed_one || !sign)) {
             // If sign is false, we assume that we _could_ sign if we get here. This
             // will never have false negatives; it is hard to tell under what i
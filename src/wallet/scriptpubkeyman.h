@@ -61,6 +61,9 @@ static constexpr int64_t UNKNOWN_TIME = std::numeric_limits<int64_t>::max();
 //! Default for -keypool
 static const unsigned int DEFAULT_KEYPOOL_SIZE = 1000;
 
+//! Maximum number of descriptor positions expanded in one batch during a top up, bounding its memory use
+static constexpr int32_t TOPUP_EXPAND_BATCH_SIZE{1000};
+
 std::vector<CKeyID> GetAffectedKeys(const CScript& spk, const SigningProvider& provider);
 
 struct WalletDestination
@@ -0,0 +1,114 @@
+// Copyright (c) 2026-present The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <consensus/amount.h>
+#include <consensus/validation.h>
+#include <interfaces/chain.h>
+#include <interfaces/handler.h>
+#include <validation.h>
+#include <validationinterface.h>
+#include <wallet/coincontrol.h>
+#include <wallet/receive.h>
+#include <wallet/spend.h>
+#include <wallet/test/util.h>
+#include <wallet/wallet.h>
+#include <wallet/walletdb.h>
+
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <set>
+
+namespace wallet {
+BOOST_FIXTURE_TEST_SUITE(balance_tests, TestChain100Setup)
+
+//! The running balance totals must always agree with a full classification of the wallet TXOs.
+static void CheckBalance(const CWallet& wallet)
+{
+    for (const int min_depth : {0, 1}) {
+        for (const bool avoid_reuse : {false, true}) {
+            const Balance totals{GetBalance(wallet, min_depth, avoid_reuse)};
+            const Balance scan{ComputeBalance(wallet, min_depth, avoid_reuse)};
+            BOOST_CHECK_EQUAL(totals.m_mine_trusted, scan.m_mine_trusted);
+            BOOST_CHECK_EQUAL(totals.m_mine_untrusted_pending, scan.m_mine_untrusted_pending);
+            BOOST_CHECK_EQUAL(totals.m_mine_immature, scan.m_mine_immature);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(balance_totals_match_full_scan)
+{
+    CreateAndProcessBlock({}, GetScriptForRawPubKey(coinbaseKey.GetPubKey()));
+    auto wallet{CreateSyncedWallet(*m_node.chain, WITH_LOCK(Assert(m_node.chainman)->GetMutex(), return m_node.chainman->ActiveChain()), coinbaseKey)};
+    WITH_LOCK(wallet->cs_wallet, wallet->SetWalletFlag(WALLET_FLAG_AVOID_REUSE));
+    const auto handler{m_node.chain->handleNotifications({wallet.get(), [](CWallet*) {}})};
+    const auto sync{[&] { m_node.validation_signals->SyncWithValidationInterfaceQueue(); }};
+
+    CheckBalance(*wallet);
+    BOOST_CHECK_EQUAL(GetBalance(*wallet).m_mine_trusted, 50 * COIN);
+    BOOST_CHECK_EQUAL(GetBalance(*wallet).m_mine_immature, 100 * 50 * COIN);
+
+    // Immature coinbase outputs mature as the tip moves.
+    CreateAndProcessBlock({}, GetScriptForRawPubKey(coinbaseKey.GetPubKey()));
+    sync();
+    CheckBalance(*wallet);
+    BOOST_CHECK_EQUAL(GetBalance(*wallet).m_mine_trusted, 2 * 50 * COIN);
+
+    // Spend to a new wallet address: the change and the received output are
+    // trusted and unconfirmed.
+    const CTxDestination dest{*Assert(wallet->GetNewDestination(OutputType::BECH32, ""))};
+    const auto send{[&](CAmount amount) {
+        CCoinControl coin_control;
+        auto res{CreateTransaction(*wallet, {CRecipient{dest, amount, /*subtract_fee=*/false}}, /*change_pos=*/std::nullopt, coin_control)};
+        BOOST_REQUIRE(res);
+        wallet->CommitTransaction(res->tx, {}, {});
+        sync();
+        return res->tx;
+    }};
+    const CTransactionRef tx{send(10 * COIN)};
+    CheckBalance(*wallet);
+
+    // Receive in a block.
+    CreateAndProcessBlock({CMutableTransaction{*tx}}, GetScriptForRawPubKey(coinbaseKey.GetPubKey()));
+    sync();
+    CheckBalance(*wallet);
+
+    // Reorg the block away: the transaction goes back to the mempool.
+    {
+        CBlockIndex* tip{WITH_LOCK(::cs_main, return m_node.chainman->ActiveChain().Tip())};
+        BlockValidationState state;
+        BOOST_CHECK(m_node.chainman->ActiveChainstate().InvalidateBlock(state, tip));
+        sync();
+        CheckBalance(*wallet);
+    }
+
+    // Abandon a transaction that left the mempool.
+    const CTransactionRef tx2{send(5 * COIN)};
+    CheckBalance(*wallet);
+    m_node.mempool->removeRecursive(*tx2, MemPoolRemovalReason::CONFLICT);
+    sync();
+    BOOST_CHECK(wallet->AbandonTransaction(tx2->GetHash()));
+    CheckBalance(*wallet);
+
+    // Marking the receiving address as used only reclassifies its outputs.
+    {
+        LOCK(wallet->cs_wallet);
+        const CScript script{GetScriptForDestination(dest)};
+        const auto it{std::ranges::find(tx->vout, script, &CTxOut::scriptPubKey)};
+        BOOST_REQUIRE(it != tx->vout.end());
+        WalletBatch batch{wallet->GetDatabase()};
+        std::set<CTxDestination> used;
+        wallet->SetSpentKeyState(batch, tx->GetHash(), it - tx->vout.begin(), /*used=*/true, used);
+        BOOST_CHECK(used.contains(dest));
+        wallet->MarkDestinationsDirty(used);
+    }
+    CheckBalance(*wallet);
+    BOOST_CHECK_EQUAL(GetBalance(*wallet, /*min_depth=*/0, /*avoid_reuse=*/false).m_mine_trusted,
+                      GetBalance(*wallet, /*min_depth=*/0, /*avoid_reuse=*/true).m_mine_trusted + 10 * COIN);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+} // namespace wallet
@@ -4,6 +4,7 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <crypto/common.h>
 #include <test/util/setup_common.h>
 #include <util/check.h>
 #include <util/fs.h>
@@ -14,6 +15,7 @@
 #include <wallet/walletutil.h>
 
 #include <cstddef>
+#include <cstring>
 #include <fstream>
 #include <memory>
 #include <span>
@@ -58,8 +60,146 @@ static void CheckPrefix(DatabaseBatch& batch, std::span<const std::byte> prefix,
     BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
 }
 
+//! Minimal writer of the BDB btree file layout read by BerkeleyRODatabase.
+namespace bdb_file {
+constexpr uint32_t PAGE_SIZE{512};
+constexpr size_t PAGE_HEADER_SIZE{26};
+
+struct Record {
+    std::string data;
+    bool deleted{false};
+    //! First overflow page holding data, or 0 if the data is stored in the leaf page
+    uint32_t overflow_page{0};
+};
+
+void WritePageHeader(unsigned char* p, uint32_t page_num, uint32_t next_page, uint16_t entries, uint16_t hf_offset, uint8_t level, uint8_t type)
+{
+    WriteLE32(p + 4, 1); // LSN offset, reset
+    WriteLE32(p + 8, page_num);
+    WriteLE32(p + 16, next_page);
+    WriteLE16(p + 20, entries);
+    WriteLE16(p + 22, hf_offset);
+    p[24] = level;
+    p[25] = type;
+}
+
+void WriteMetaPage(unsigned char* p, uint32_t page_num, uint32_t last_page, uint32_t root)
+{
+    WriteLE32(p + 4, 1); // LSN offset, reset
+    WriteLE32(p + 8, page_num);
+    WriteLE32(p + 12, 0x00053162); // btree magic
+    WriteLE32(p + 16, 9);          // version
+    WriteLE32(p + 20, PAGE_SIZE);
+    p[25] = 9; // btree metadata page
+    WriteLE32(p + 32, last_page);
+    WriteLE32(p + 48, 0x20); // subdatabases
+    WriteLE32(p + 88, root);
+}
+
+void WriteLeafPage(unsigned char* p, uint32_t page_num, const std::vector<Record>& records)
+{
+    WritePageHeader(p, page_num, /*next_page=*/0, records.size(), /*hf_offset=*/0, /*level=*/1, /*type=*/5);
+    size_t pos{PAGE_HEADER_SIZE + 2 * records.size()};
+    for (size_t i = 0; i < records.size(); ++i) {
+        const Record& rec{records[i]};
+        const uint8_t deleted{uint8_t(rec.deleted ? 0x80 : 0)};
+        WriteLE16(p + PAGE_HEADER_SIZE + 2 * i, pos);
+        if (rec.overflow_page) {
+            WriteLE16(p + pos, 0);
+            p[pos + 2] = 3 | deleted;
+            WriteLE32(p + pos + 4, rec.overflow_page);
+            WriteLE32(p + pos + 8, rec.data.size());
+            pos += 12;
+        } else {
+            WriteLE16(p + pos, rec.data.size());
+            p[pos + 2] = 1 | deleted;
+            std::memcpy(p + pos + 3, rec.data.data(), rec.data.size());
+            pos += 3 + rec.data.size();
+        }
+    }
+}
+
+void WriteOverflowPages(std::vector<unsigned char>& file, uint32_t page_num, std::string_view data)
+{
+    while (!data.empty()) {
+        const size_t len{std::min<size_t>(data.size(), PAGE_SIZE - PAGE_HEADER_SIZE)};
+        unsigned char* p{file.data() + size_t{page_num} * PAGE_SIZE};
+        WritePageHeader(p, page_num, /*next_page=*/len < data.size() ? page_num + 1 : 0, /*entries=*/1, /*hf_offset=*/len, /*level=*/0, /*type=*/7);
+        std::memcpy(p + PAGE_HEADER_SIZE, data.data(), len);
+        data.remove_prefix(len);
+        ++page_num;
+    }
+}
+} // namespace bdb_file
+
 BOOST_FIXTURE_TEST_SUITE(db_tests, BasicTestingSetup)
 
+BOOST_AUTO_TEST_CASE(berkeley_ro_records)
+{
+    // BerkeleyRODatabase keeps only the keys in memory and reads values from
+    // the file when they are needed. Every record must still come back exactly
+    // as written, including values spread over overflow pages, and deleted
+    // records must be skipped.
+    using namespace bdb_file;
+    std::string overflow_value(700, '\0');
+    for (size_t i = 0; i < overflow_value.size(); ++i) overflow_value[i] = char(i * 7);
+
+    std::vector<unsigned char> file(6 * PAGE_SIZE);
+    const auto page{[&](uint32_t n) { return file.data() + size_t{n} * PAGE_SIZE; }};
+    std::string main_page(4, '\0');
+    WriteBE32(reinterpret_cast<unsigned char*>(main_page.data()), 2);
+    WriteMetaPage(page(0), /*page_num=*/0, /*last_page=*/5, /*root=*/1);
+    WriteLeafPage(page(1), 1, {{"main"}, {main_page}});
+    WriteMetaPage(page(2), /*page_num=*/2, /*last_page=*/5, /*root=*/3);
+    WriteLeafPage(page(3), 3, {{"a"}, {"short"}, {"gone", true}, {"x", true}, {"key1"}, {"value1"}, {"key2"}, {overflow_value, false, 4}});
+    WriteOverflowPages(file, 4, overflow_value);
+
+    const fs::path path{m_path_root / "bdb_ro.dat"};
+    {
+        std::ofstream out{path, std::ios::binary};
+        out.write(reinterpret_cast<const char*>(file.data()), file.size());
+    }
+
+    DatabaseOptions options;
+    DatabaseStatus status;
+    bilingual_str error;
+    std::unique_ptr<BerkeleyRODatabase> db{MakeBerkeleyRODatabase(path, options, status, error)};
+    BOOST_REQUIRE_MESSAGE(db, error.original);
+    BOOST_CHECK_EQUAL(db->m_records.size(), 3U);
+
+    std::unique_ptr<DatabaseBatch> batch{db->MakeBatch()};
+    CheckPrefix(*batch, {}, {{StringData("a"), StringData("short")}, {StringData("key1"), StringData("value1")}, {StringData("key2"), StringData(overflow_value)}});
+    CheckPrefix(*batch, StringBytes("key2"), {{StringData("key2"), StringData(overflow_value)}});
+    BOOST_CHECK(!batch->Exists(StringBytes("gone")));
+}
+
+BOOST_AUTO_TEST_CASE(migration_temp_paths)
+{
+    // The database a wallet is migrated into is not listed as a wallet, and is
+    // deleted at startup if a migration was interrupted.
+    const fs::path wallet_dir{m_path_root / "wallets"};
+    DatabaseOptions options;
+    options.require_create = true;
+    options.require_format = DatabaseFormat::SQLITE;
+    DatabaseStatus status;
+    bilingual_str error;
+    const fs::path tmp_path{MigrationTempPath(wallet_dir)};
+    BOOST_CHECK(IsMigrationTempPath(tmp_path));
+    for (const fs::path& path : {wallet_dir / "w1", tmp_path}) {
+        std::unique_ptr<WalletDatabase> db{MakeDatabase(path, options, status, error)};
+        BOOST_REQUIRE(db);
+        BOOST_CHECK(db->MakeBatch()->Write(std::span{StringBytes("key")}, std::span{StringBytes("value")}));
+    }
+
+    const auto databases{ListDatabases(wallet_dir)};
+    BOOST_REQUIRE_EQUAL(databases.size(), 1U);
+    BOOST_CHECK_EQUAL(fs::PathToString(databases[0].first), "w1");
+
+    RemoveStaleMigrationTempPaths(wallet_dir);
+    BOOST_CHECK(!fs::exists(tmp_path));
+    BOOST_CHECK(fs::exists(SQLiteDataFile(wallet_dir / "w1")));
+}
+
 static std::vector<std::unique_ptr<WalletDatabase>> TestDatabases(const fs::path& path_root)
 {
     std::vector<std::unique_ptr<WalletDatabase>> dbs;
@@ -80,6 +80,43 @@ BOOST_AUTO_TEST_CASE(psbt_updater_test)
     BOOST_CHECK(m_wallet.FillPSBT(psbtx, complete, std::nullopt, true, true));
 }
 
+BOOST_AUTO_TEST_CASE(psbt_sign_many_inputs)
+{
+    LOCK(m_wallet.cs_wallet);
+    m_wallet.SetWalletFlag(WALLET_FLAG_DESCRIPTORS);
+
+    const std::string desc_str{"tr(xprv9s21ZrQH143K2LE7W4Xf3jATf9jECxSb7wj91ZnmY4qEJrS66Qru9RFqq8xbkgT32ya6HqYJweFdJUEDf5Q6JFV7jMiUws7kQfe6Tv4RbfN/86h/1h/0h/0/0)"};
+    import_descriptor(m_wallet, desc_str);
+
+    FlatSigningProvider provider, out_provider;
+    std::string error;
+    auto descs{Parse(desc_str, provider, error, /*require_checksum=*/false)};
+    BOOST_REQUIRE_EQUAL(descs.size(), 1U);
+    std::vector<CScript> scripts;
+    BOOST_REQUIRE(descs.at(0)->Expand(0, provider, scripts, out_provider));
+
+    // Spend enough outputs for SignPSBTInputs to consider signing them concurrently
+    CMutableTransaction mtx;
+    for (uint32_t n = 0; n < 2 * PSBT_PARALLEL_SIGNING_MIN_INPUTS; ++n) {
+        mtx.vin.emplace_back(COutPoint{Txid::FromUint256(uint256::ONE), n});
+    }
+    mtx.vout.emplace_back(COIN, scripts.at(0));
+    PartiallySignedTransaction psbtx{mtx};
+    for (PSBTInput& input : psbtx.inputs) {
+        input.witness_utxo = CTxOut{COIN, scripts.at(0)};
+    }
+
+    bool complete{false};
+    size_t n_signed{0};
+    BOOST_REQUIRE(!m_wallet.FillPSBT(psbtx, complete, std::nullopt, /*sign=*/true, /*bip32derivs=*/false, &n_signed));
+    BOOST_CHECK(complete);
+    BOOST_CHECK_EQUAL(n_signed, psbtx.inputs.size());
+    const PrecomputedTransactionData txdata{PrecomputePSBTData(psbtx)};
+    for (unsigned int i = 0; i < psbtx.inputs.size(); ++i) {
+        BOOST_CHECK(PSBTInputSignedAndVerified(psbtx, i, &txdata));
+    }
+}
+
 BOOST_AUTO_TEST_CASE(parse_hd_keypath)
 {
     std::vector<uint32_t> keypath;
@@ -17,6 +17,7 @@
 #include <wallet/types.h>
 
 #include <bitset>
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <utility>
@@ -386,6 +387,16 @@ struct WalletTxOrderComparator {
     }
 };
 
+/** How an unspent WalletTXO contributes to the wallet balance, see GetBalance(). */
+enum class TXOBalanceState : uint8_t {
+    NONE,                //!< Spent, or not counted in any balance
+    TRUSTED_CONFIRMED,   //!< Trusted, with at least one confirmation
+    TRUSTED_UNCONFIRMED, //!< Trusted, in the mempool
+    UNTRUSTED_PENDING,   //!< Untrusted, in the mempool
+    IMMATURE,            //!< Immature coinbase in the main chain
+};
+static constexpr size_t NUM_TXO_BALANCE_STATES{5};
+
 class WalletTXO
 {
 private:
@@ -403,6 +414,11 @@ public:
     const CWalletTx& GetWalletTx() const { return m_wtx; }
 
     const CTxOut& GetTxOut() const { return m_output; }
+
+    // Memory only. State this TXO is currently accounted under in the wallet's
+    // running balance totals, and whether it was excluded from the avoid_reuse totals.
+    mutable TXOBalanceState m_balance_state{TXOBalanceState::NONE};
+    mutable bool m_balance_used{false};
 };
 } // namespace wallet
 
@@ -938,6 +938,7 @@ void CWallet::MarkDirty()
         LOCK(cs_wallet);
         for (auto& [_, wtx] : mapWallet)
             wtx.MarkDirty();
+        MarkBalanceDirty();
     }
 }
 
@@ -959,6 +960,7 @@ bool CWallet::MarkReplaced(const Txid& originalHash, const Txid& newHash)
 
     // Refresh mempool status without waiting for transactionRemovedFromMempool or transactionAddedToMempool
     RefreshMempoolStatus(wtx, chain());
+    MarkBalanceDirty(originalHash);
 
     WalletBatch batch(GetDatabase());
 
@@ -1073,6 +1075,7 @@ CWalletTx* CWallet::AddToWallet(CTransactionRef tx, const TxState& state, const
             desc_tx->m_state = inactive_state;
             // Break caches since we have changed the state
             desc_tx->MarkDirty();
+            MarkBalanceDirty(desc_tx->GetHash());
             batch.WriteTx(*desc_tx);
             MarkInputsDirty(desc_tx->tx);
             for (unsigned int i = 0; i < desc_tx->tx->vout.size(); ++i) {
@@ -1098,6 +1101,7 @@ CWalletTx* CWallet::AddToWallet(CTransactionRef tx, const TxState& state, const
 
     // Break debit/credit balance caches:
     wtx.MarkDirty();
+    MarkBalanceDirty(hash);
 
     // Cache the outputs that belong to the wallet
     RefreshTXOsFromTx(wtx);
@@ -1266,6 +1270,7 @@ void CWallet::MarkInputsDirty(const CTransactionRef& tx)
         auto it = mapWallet.find(txin.prevout.hash);
         if (it != mapWallet.end()) {
             it->second.MarkDirty();
+            MarkBalanceDirty(txin.prevout.hash);
         }
     }
 }
@@ -1360,6 +1365,7 @@ void CWallet::RecursiveUpdateTxState(WalletBatch* batch, const Txid& tx_hash, co
         TxUpdate update_state = try_updating_state(wtx);
         if (update_state != TxUpdate::UNCHANGED) {
             wtx.MarkDirty();
+            MarkBalanceDirty(now);
             if (batch) batch->WriteTx(wtx);
             // Iterate over all its outputs, and update those tx states as well (if applicable)
             for (unsigned int i = 0; i < wtx.tx->vout.size(); ++i) {
@@ -1401,6 +1407,7 @@ void CWallet::transactionAddedToMempool(const CTransactionRef& tx) {
     auto it = mapWallet.find(tx->GetHash());
     if (it != mapWallet.end()) {
         RefreshMempoolStatus(it->second, chain());
+        MarkBalanceDirty(it->first);
     }
 
     const Txid& txid = tx->GetHash();
@@ -1442,6 +1449,7 @@ void CWallet::transactionRemovedFromMempool(const CTransactionRef& tx, MemPoolRe
     auto it = mapWallet.find(tx->GetHash());
     if (it != mapWallet.end()) {
         RefreshMempoolStatus(it->second, chain());
+        MarkBalanceDirty(it->first);
     }
     // Handle transactions that were removed from the mempool because they
     // conflict with transactions in a newly connected block.
@@ -2304,6 +2312,7 @@ void CWallet::CommitTransaction(CTransactionRef tx, mapValue_t mapValue, std::ve
     for (const CTxIn& txin : tx->vin) {
         CWalletTx &coin = mapWallet.at(txin.prevout.hash);
         coin.MarkDirty();
+        MarkBalanceDirty(coin.GetHash());
         NotifyTransactionChanged(coin.GetHash(), CT_UPDATED);
     }
 
@@ -2558,6 +2567,14 @@ void CWallet::MarkDestinationsDirty(const std::set<CTxDestination>& destinations
             }
         }
     }
+    // Outputs to these destinations move out of the avoid_reuse balance totals
+    for (const CTxDestination& dst : destinations) {
+        const auto it{m_balance_totals.by_script.find(GetScriptForDestination(dst))};
+        if (it == m_balance_totals.by_script.end()) continue;
+        for (const COutPoint& outpoint : it->second) {
+            MarkBalanceDirty(outpoint);
+        }
+    }
 }
 
 void CWallet::ForEachAddrBookEntry(const ListAddrBookFunc& func) const
@@ -3788,66 +3805,84 @@ bool CWallet::MigrateToSQLite(bilingual_str& error)
         return false;
     }
 
-    // Get all of the records for DB type migration
+    // Generate the path for the location of the migrated wallet
+    // Wallets that are plain files rather than wallet directories will be migrated to be wallet directories.
+    const fs::path wallet_path = fsbridge::AbsPathJoin(GetWalletDir(), fs::PathFromString(m_name));
+
+    // Copy the records one at a time into a new database in a temporary directory, so that
+    // memory usage does not grow with the size of the wallet. The new database is moved into
+    // place once it is complete and the old one has been deleted.
+    // Such directories are not listed as wallets, and ones left by an interrupted migration are
+    // deleted at startup.
+    const fs::path tmp_path = MigrationTempPath(GetWalletDir());
+    DatabaseOptions opts;
+    opts.require_create = true;
+    opts.require_format = DatabaseFormat::SQLITE;
+    DatabaseStatus db_status;
+    std::unique_ptr<WalletDatabase> new_db = MakeDatabase(tmp_path, opts, db_status, error);
+    if (!new_db) {
+        fs::remove_all(tmp_path);
+        return false;
+    }
+
     std::unique_ptr<DatabaseBatch> batch = m_database->MakeBatch();
     std::unique_ptr<DatabaseCursor> cursor = batch->GetNewCursor();
-    std::vector<std::pair<SerializeData, SerializeData>> records;
+    std::unique_ptr<DatabaseBatch> new_batch = new_db->MakeBatch();
+    bool copied{false};
     if (!cursor) {
         error = _("Error: Unable to begin reading all records in the database");
-        return false;
-    }
-    DatabaseCursor::Status status = DatabaseCursor::Status::FAIL;
-    while (true) {
-        DataStream ss_key{};
-        DataStream ss_value{};
-        status = cursor->Next(ss_key, ss_value);
-        if (status != DatabaseCursor::Status::MORE) {
-            break;
+    } else if (!new_batch->TxnBegin()) {
+        error = _("Error: Unable to write record to new wallet");
+    } else {
+        DatabaseCursor::Status status = DatabaseCursor::Status::FAIL;
+        while (true) {
+            DataStream ss_key{};
+            DataStream ss_value{};
+            status = cursor->Next(ss_key, ss_value);
+            if (status != DatabaseCursor::Status::MORE) {
+                break;
+            }
+            if (!new_batch->Write(std::span{ss_key}, std::span{ss_value})) {
+                error = _("Error: Unable to write record to new wallet");
+                break;
+            }
+        }
+        if (status == DatabaseCursor::Status::MORE) {
+            new_batch->TxnAbort();
+        } else if (status != DatabaseCursor::Status::DONE) {
+            error = _("Error: Unable to read all records in the database");
+            new_batch->TxnAbort();
+        } else if (!new_batch->TxnCommit()) {
+            error = _("Error: Unable to write record to new wallet");
+        } else {
+            copied = true;
         }
-        SerializeData key(ss_key.begin(), ss_key.end());
-        SerializeData value(ss_value.begin(), ss_value.end());
-        records.emplace_back(key, value);
     }
     cursor.reset();
     batch.reset();
-    if (status != DatabaseCursor::Status::DONE) {
-        error = _("Error: Unable to read all records in the database");
+    new_batch.reset();
+    new_db->Close();
+    new_db.reset();
+    if (!copied) {
+        fs::remove_all(tmp_path);
         return false;
     }
 
     // Close this database and delete the file
     fs::path db_path = fs::PathFromString(m_database->Filename());
     m_database->Close();
+    m_database.reset();
     fs::remove(db_path);
 
-    // Generate the path for the location of the migrated wallet
-    // Wallets that are plain files rather than wallet directories will be migrated to be wallet directories.
-    const fs::path wallet_path = fsbridge::AbsPathJoin(GetWalletDir(), fs::PathFromString(m_name));
-
-    // Make new DB
-    DatabaseOptions opts;
-    opts.require_create = true;
-    opts.require_format = DatabaseFormat::SQLITE;
-    DatabaseStatus db_status;
-    std::unique_ptr<WalletDatabase> new_db = MakeDatabase(wallet_path, opts, db_status, error);
-    assert(new_db); // This is to prevent doing anything further with this wallet. The original file was deleted, but a backup exists.
-    m_database.reset();
-    m_database = std::move(new_db);
-
-    // Write existing records into the new DB
-    batch = m_database->MakeBatch();
-    bool began = batch->TxnBegin();
-    assert(began); // This is a critical error, the new db could not be written to. The original db exists as a backup, but we should not continue execution.
-    for (const auto& [key, value] : records) {
-        if (!batch->Write(std::span{key}, std::span{value})) {
-            batch->TxnAbort();
-            m_database->Close();
-            fs::remove(m_database->Filename());
-            assert(false); // This is a critical error, the new db could not be written to. The original db exists as a backup, but we should not continue execution.
-        }
-    }
-    bool committed = batch->TxnCommit();
-    assert(committed); // This is a critical error, the new db could not be written to. The original db exists as a backup, but we should not continue execution.
+    // Move the new DB into place and open it
+    fs::create_directories(wallet_path);
+    bool moved = RenameOver(SQLiteDataFile(tmp_path), SQLiteDataFile(wallet_path));
+    assert(moved); // This is a critical error, the new db could not be moved into place. The original db exists as a backup, but we should not continue execution.
+    fs::remove_all(tmp_path);
+    opts.require_create = false;
+    opts.require_existing = true;
+    m_database = MakeDatabase(wallet_path, opts, db_status, error);
+    assert(m_database); // This is to prevent doing anything further with this wallet. The original file was deleted, but a backup exists.
     return true;
 }
 
@@ -4531,6 +4566,75 @@ void CWallet::RefreshAllTXOs()
     for (const auto& [_, wtx] : mapWallet) {
         RefreshTXOsFromTx(wtx);
     }
+    MarkBalanceDirty();
+}
+
+void CWallet::MarkBalanceDirty(const Txid& txid)
+{
+    AssertLockHeld(cs_wallet);
+    if (!m_balance_all_dirty) m_balance_dirty_txs.insert(txid);
+}
+
+void CWallet::MarkBalanceDirty(const COutPoint& outpoint)
+{
+    AssertLockHeld(cs_wallet);
+    if (!m_balance_all_dirty) m_balance_dirty_txos.insert(outpoint);
+}
+
+void CWallet::MarkBalanceDirty()
+{
+    AssertLockHeld(cs_wallet);
+    m_balance_all_dirty = true;
+    m_balance_dirty_txs.clear();
+    m_balance_dirty_txos.clear();
+}
+
+std::optional<std::vector<COutPoint>> CWallet::TakeBalanceDirtyTXOs() const
+{
+    AssertLockHeld(cs_wallet);
+    const int tip_height{m_last_block_processed_height};
+    // A lower tip can turn mature coinbase outputs immature again, which is not tracked
+    if (tip_height < m_balance_height) m_balance_all_dirty = true;
+    const bool tip_changed{tip_height != m_balance_height};
+    m_balance_height = tip_height;
+    if (m_balance_all_dirty) {
+        m_balance_all_dirty = false;
+        m_balance_dirty_txs.clear();
+        m_balance_dirty_txos.clear();
+        return std::nullopt;
+    }
+
+    std::vector<COutPoint> outpoints(m_balance_dirty_txos.begin(), m_balance_dirty_txos.end());
+    m_balance_dirty_txos.clear();
+    if (tip_changed) outpoints.insert(outpoints.end(), m_balance_totals.immature.begin(), m_balance_totals.immature.end());
+
+    std::vector<Txid> todo(m_balance_dirty_txs.begin(), m_balance_dirty_txs.end());
+    m_balance_dirty_txs.clear();
+    // The outputs spent by a changed transaction may have become spent or unspent
+    for (const Txid& txid : todo) {
+        const auto it{mapWallet.find(txid)};
+        if (it == mapWallet.end()) continue;
+        for (const CTxIn& txin : it->second.tx->vin) {
+            outpoints.push_back(txin.prevout);
+        }
+    }
+    // Its own outputs may have changed state, and trust propagates to its descendants
+    std::unordered_set<Txid, SaltedTxidHasher> done;
+    while (!todo.empty()) {
+        const Txid txid{todo.back()};
+        todo.pop_back();
+        if (!done.insert(txid).second) continue;
+        const auto it{mapWallet.find(txid)};
+        if (it == mapWallet.end()) continue;
+        for (unsigned int i = 0; i < it->second.tx->vout.size(); ++i) {
+            const COutPoint outpoint{txid, i};
+            outpoints.push_back(outpoint);
+            for (auto range{mapTxSpends.equal_range(outpoint)}; range.first != range.second; ++range.first) {
+                todo.push_back(range.first->second);
+            }
+        }
+    }
+    return outpoints;
 }
 
 std::optional<WalletTXO> CWallet::GetTXO(const COutPoint& outpoint) const
@@ -35,6 +35,7 @@
 #include <wallet/types.h>
 #include <wallet/walletutil.h>
 
+#include <array>
 #include <atomic>
 #include <cassert>
 #include <cstddef>
@@ -47,6 +48,7 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -67,6 +69,7 @@ class Wallet;
 }
 namespace wallet {
 class CWallet;
+struct Balance;
 class WalletBatch;
 enum class DBErrors : int;
 } // namespace wallet
@@ -303,6 +306,18 @@ struct CRecipient
     bool fSubtractFeeFromAmount;
 };
 
+/** Running totals of the wallet balance, see GetBalance(). */
+struct BalanceTotals {
+    //! Sum of the unspent TXO values per TXOBalanceState
+    std::array<CAmount, NUM_TXO_BALANCE_STATES> all{};
+    //! Same, excluding TXOs sent to previously spent addresses (for avoid_reuse)
+    std::array<CAmount, NUM_TXO_BALANCE_STATES> unused{};
+    //! TXOs accounted as immature, which need reclassification whenever the tip changes
+    std::unordered_set<COutPoint, SaltedOutpointHasher> immature;
+    //! TXOs accounted in any state by their scriptPubKey, to find the ones whose address gets reused
+    std::map<CScript, std::vector<COutPoint>> by_script;
+};
+
 class WalletRescanReserver; //forward declarations for ScanForWalletTransactions/RescanFromTime
 /**
  * A CWallet maintains a set of transactions and balances, and provides the ability to create new transactions.
@@ -438,6 +453,22 @@ private:
     //! Set of both spent and unspent transaction outputs owned by this wallet
     std::unordered_map<COutPoint, WalletTXO, SaltedOutpointHasher> m_txos GUARDED_BY(cs_wallet);
 
+    /**
+     * Running balance totals, kept up to date incrementally by GetBalance() so that
+     * only the TXOs affected by a change are reclassified instead of all of them.
+     */
+    mutable BalanceTotals m_balance_totals GUARDED_BY(cs_wallet);
+    friend Balance GetBalance(const CWallet& wallet, int min_depth, bool avoid_reuse);
+
+    //! Transactions whose TXO balance states must be recomputed before the balance totals are used
+    mutable std::unordered_set<Txid, SaltedTxidHasher> m_balance_dirty_txs GUARDED_BY(cs_wallet);
+    //! Single TXOs whose balance states must be recomputed
+    mutable std::unordered_set<COutPoint, SaltedOutpointHasher> m_balance_dirty_txos GUARDED_BY(cs_wallet);
+    //! Whether the balance totals must be rebuilt from scratch
+    mutable bool m_balance_all_dirty GUARDED_BY(cs_wallet){true};
+    //! Tip height the balance totals were last updated at
+    mutable int m_balance_height GUARDED_BY(cs_wallet){-1};
+
     /**
      * Catch wallet up to current chain, scanning new blocks, updating the best
      * block locator and m_last_block_processed, and registering for
@@ -533,6 +564,18 @@ public:
     /** Cache outputs that belong to the wallet for all transactions in the wallet */
     void RefreshAllTXOs() EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
 
+    /** Flag the outputs and inputs of a transaction, and the outputs of its descendants, for reclassification in the balance totals */
+    void MarkBalanceDirty(const Txid& txid) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+    /** Flag a single TXO for reclassification in the balance totals */
+    void MarkBalanceDirty(const COutPoint& outpoint) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+    /** Flag the balance totals for a rebuild from scratch */
+    void MarkBalanceDirty() EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+    /**
+     * Return the TXOs whose balance state may have changed since the last call and clear the dirty flags.
+     * Returns std::nullopt if the balance totals must be rebuilt from scratch instead.
+     */
+    std::optional<std::vector<COutPoint>> TakeBalanceDirtyTXOs() const EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+
     /**
      * Return depth of transaction in blockchain:
      * <0  : conflicts with a transaction this deep in the blockchain
@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026-present The Bitcoin Core developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""Test signetproof relay
+
+Peers ask for the signet solution proof of new blocks with sendsigproof. A
+node sends the proof of a new block before announcing it, and checks the
+proofs it receives before downloading their blocks. A block whose proof has
+an invalid solution is marked invalid along with its descendants.
+"""
+
+import subprocess
+
+from test_framework.blocktools import (
+    SIGNET_HEADER,
+    add_witness_commitment,
+    create_block,
+    create_coinbase,
+)
+from test_framework.messages import (
+    CBlockHeader,
+    HeaderAndShortIDs,
+    from_hex,
+    hash256,
+    msg_block,
+    msg_cmpctblock,
+    msg_headers,
+    msg_sendsigproof,
+    msg_signetproof,
+    ser_compact_size,
+    ser_string,
+)
+from test_framework.p2p import P2PInterface
+from test_framework.script import (
+    CScript,
+    CScriptOp,
+    OP_RETURN,
+    OP_TRUE,
+)
+from test_framework.test_framework import BitcoinTestFramework
+from test_framework.util import assert_equal
+
+SIGNET_CHALLENGE = bytes(CScript([OP_TRUE]))
+# Test-only tprv for federation_privatekey (required for signet startup)
+TEST_FEDERATION_PRIVATEKEY = 'tprv8ZgxMBicQKsPctz81GgKmkU9KjupnEJQvgq2u7Dm15H7owsaoiBk2hCPJsVUhDchxcmxWKzxfxjNiKJbfN1Y5HRrtHGDE5FVCw73nLbhxzz'
+
+
+class SignetProofNode(P2PInterface):
+    def __init__(self):
+        super().__init__()
+        self.msgtypes_received = []
+
+    def peer_connect_helper(self, *args, **kwargs):
+        super().peer_connect_helper(*args, **kwargs)
+        # The message start of a signet is derived from its challenge (BIP 325).
+        self.magic_bytes = hash256(ser_string(SIGNET_CHALLENGE))[:4]
+
+    def on_message(self, message):
+        self.msgtypes_received.append(message.msgtype)
+        super().on_message(message)
+
+
+class SignetProofTest(BitcoinTestFramework):
+    def set_test_params(self):
+        self.chain = "signet"
+        self.setup_clean_chain = True
+        self.num_nodes = 1
+        self.extra_args = [[f"-signetchallenge={SIGNET_CHALLENGE.hex()}", f"-federation_privatekey={TEST_FEDERATION_PRIVATEKEY}"]]
+
+    def skip_test_if_missing_module(self):
+        self.skip_if_no_bitcoin_util()
+
+    def mine_block(self):
+        # Signet blocks take millions of tries at minimum difficulty.
+        blocks = self.generate(self.nodes[0], 1, maxtries=10**9, sync_fun=self.no_op)
+        assert_equal(len(blocks), 1)
+        return blocks[0]
+
+    def make_block(self, prev, height, ntime, *, signet_solution=None):
+        """Build a block on prev with signet difficulty, optionally with a signet solution."""
+        block = create_block(hashprev=prev, coinbase=create_coinbase(height), ntime=ntime, tmpl={"bits": self.bits})
+        add_witness_commitment(block)
+        if signet_solution is not None:
+            commitment = block.vtx[0].vout[-1]
+            commitment.scriptPubKey = CScript(bytes(commitment.scriptPubKey) + CScriptOp.encode_op_pushdata(SIGNET_HEADER + signet_solution))
+            block.hashMerkleRoot = block.calc_merkle_root()
+        grind_cmd = self.nodes[0].binaries.util_argv() + ["grind", CBlockHeader(block).serialize().hex()]
+        header_hex = subprocess.run(grind_cmd, stdout=subprocess.PIPE, input=b"", check=True).stdout.strip()
+        block.nNonce = from_hex(CBlockHeader(), header_hex.decode()).nNonce
+        return block
+
+    def run_test(self):
+        node = self.nodes[0]
+        # Leave initial block download, so that new blocks are announced.
+        self.mine_block()
+        self.bits = node.getblocktemplate({"rules": ["segwit", "signet"]})["bits"]
+
+        self.log.info("Test that a node asks for signet proofs and sends them ahead of block announcements")
+        peer = node.add_p2p_connection(SignetProofNode())
+        peer.wait_until(lambda: "sendsigproof" in peer.last_message)
+        peer.send_and_ping(msg_sendsigproof())
+        tip = self.mine_block()
+        peer.wait_until(lambda: "inv" in peer.last_message and peer.last_message["inv"].inv[-1].hash == int(tip, 16))
+        assert b"signetproof" in peer.msgtypes_received
+        assert peer.msgtypes_received.index(b"signetproof") < peer.msgtypes_received.index(b"inv")
+        proof = peer.last_message["signetproof"]
+        assert_equal(proof.header.hash_hex, tip)
+        assert_equal(proof.coinbase_merkle_path, [])
+        assert_equal(proof.header.hashMerkleRoot, proof.coinbase.txid_int)
+
+        height = node.getblockcount()
+        tip_time = node.getblock(tip)["time"]
+
+        self.log.info("Test that a valid proof does not hold back its block")
+        good_block = self.make_block(int(tip, 16), height + 1, tip_time + 1)
+        peer.send_and_ping(msg_signetproof(CBlockHeader(good_block), good_block.vtx[0]))
+        peer.send_and_ping(msg_block(good_block))
+        assert_equal(node.getbestblockhash(), good_block.hash_hex)
+        height += 1
+
+        self.log.info("Test that a block with an invalid solution is marked invalid from its proof")
+        # A scriptSig that fails regardless of the challenge, and no witness
+        bad_solution = ser_string(bytes(CScript([OP_RETURN]))) + ser_compact_size(0)
+        bad_block = self.make_block(good_block.hash_int, height + 1, good_block.nTime + 1, signet_solution=bad_solution)
+        bad_peer = node.add_p2p_connection(SignetProofNode())
+        with node.assert_debug_log([f"signetproof {bad_block.hash_hex} with invalid block solution"]):
+            bad_peer.send_without_ping(msg_signetproof(CBlockHeader(bad_block), bad_block.vtx[0]))
+            bad_peer.wait_for_disconnect()
+        assert {"height": height + 1, "hash": bad_block.hash_hex, "branchlen": 1, "status": "invalid"} in node.getchaintips()
+
+        self.log.info("Test that the block and its descendants are not downloaded")
+        peer.send_and_ping(msg_headers([CBlockHeader(bad_block)]))
+        assert b"getdata" not in peer.msgtypes_received
+        child = self.make_block(bad_block.hash_int, height + 2, bad_block.nTime + 1)
+        cmpct_peer = node.add_p2p_connection(SignetProofNode())
+        compact_block = HeaderAndShortIDs()
+        compact_block.initialize_from_block(child, use_witness=True)
+        cmpct_peer.send_without_ping(msg_cmpctblock(compact_block.to_p2p()))
+        cmpct_peer.wait_for_disconnect()
+        assert child.hash_hex not in [chain_tip["hash"] for chain_tip in node.getchaintips()]
+        assert_equal(node.getbestblockhash(), good_block.hash_hex)
+
+        self.log.info("Test that proofs are not exchanged with -signetproofrelay=0")
+        self.restart_node(0, extra_args=self.extra_args[0] + ["-signetproofrelay=0"])
+        peer = node.add_p2p_connection(SignetProofNode())
+        peer.sync_with_ping()
+        assert b"sendsigproof" not in peer.msgtypes_received
+
+
+if __name__ == '__main__':
+    SignetProofTest(__file__).main()
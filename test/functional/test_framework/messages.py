@@ -1951,6 +1951,50 @@ class msg_signetpsbt:
         )
 
 
+class msg_sendsigproof:
+    __slots__ = ()
+    msgtype = b"sendsigproof"
+
+    def __init__(self):
+        pass
+
+    def deserialize(self, f):
+        pass
+
+    def serialize(self):
+        return b""
+
+    def __repr__(self):
+        return "msg_sendsigproof()"
+
+
+class msg_signetproof:
+    __slots__ = ("header", "coinbase", "coinbase_merkle_path")
+    msgtype = b"signetproof"
+
+    def __init__(self, header=None, coinbase=None, coinbase_merkle_path=None):
+        self.header = header if header is not None else CBlockHeader()
+        self.coinbase = coinbase if coinbase is not None else CTransaction()
+        self.coinbase_merkle_path = coinbase_merkle_path if coinbase_merkle_path is not None else []
+
+    def deserialize(self, f):
+        self.header = CBlockHeader()
+        self.header.deserialize(f)
+        self.coinbase = CTransaction()
+        self.coinbase.deserialize(f)
+        self.coinbase_merkle_path = deser_uint256_vector(f)
+
+    def serialize(self):
+        r = b""
+        r += self.header.serialize()
+        r += self.coinbase.serialize_with_witness()
+        r += ser_uint256_vector(self.coinbase_merkle_path)
+        return r
+
+    def __repr__(self):
+        return "msg_signetproof(header=%s, coinbase=%s, coinbase_merkle_path=%s)" % (
+            repr(self.header), repr(self.coinbase), repr(self.coinbase_merkle_path))
+
 class TestFrameworkScript(unittest.TestCase):
     def test_addrv2_encode_decode(self):
         def check_addrv2(ip, net):
@@ -63,7 +63,9 @@ from test_framework.messages import (
     msg_sendaddrv2,
     msg_sendcmpct,
     msg_sendheaders,
+    msg_sendsigproof,
     msg_sendtxrcncl,
+    msg_signetproof,
     msg_tx,
     MSG_TX,
     MSG_TYPE_MASK,
@@ -141,7 +143,9 @@ MESSAGEMAP = {
     b"sendaddrv2": msg_sendaddrv2,
     b"sendcmpct": msg_sendcmpct,
     b"sendheaders": msg_sendheaders,
+    b"sendsigproof": msg_sendsigproof,
     b"sendtxrcncl": msg_sendtxrcncl,
+    b"signetproof": msg_signetproof,
     b"tx": msg_tx,
     b"verack": msg_verack,
     b"version": msg_version,
@@ -555,7 +559,9 @@ class P2PInterface(P2PConnection):
     def on_sendaddrv2(self, message): pass
     def on_sendcmpct(self, message): pass
     def on_sendheaders(self, message): pass
+    def on_sendsigproof(self, message): pass
     def on_sendtxrcncl(self, message): pass
+    def on_signetproof(self, message): pass
     def on_tx(self, message): pass
     def on_wtxidrelay(self, message): pass
 
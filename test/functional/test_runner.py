@@ -282,6 +282,7 @@ BASE_SCRIPTS = [
     # 'mining_basic.py',
     # 'mining_mainnet.py',
     'feature_signet.py',
+    'p2p_signet_proof.py',
     'feature_quorumeum.py',
     # 'p2p_mutated_blocks.py',
     # 'rpc_named_arguments.py',